@@ -59,5 +59,6 @@ YM      M9  MM    MM MM       MM    MM   d'  `MM.    MM            MM   d'  `MM.
 #include "headers/XLSheet.hpp"
 #include "headers/XLWorkbook.hpp"
 #include "headers/XLZipArchive.hpp"
+#include "headers/XLZipStreamWriter.hpp"
 
 #endif    // OPENXLSX_OPENXLSX_HPP
@@ -15,18 +15,39 @@
 #endif // _MSC_VER
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdio>
+#include <cstring>
 #include <fstream>
+#include <exception>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #ifdef _WIN32
 #    include <direct.h>
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    include <windows.h>
+#    define ZIPPY_HAS_MMAP
+#elif defined(__unix__) || defined(__APPLE__)
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#    define ZIPPY_HAS_MMAP
 #endif
 
 #ifdef ENABLE_NOWIDE // DONE: test this on windows
@@ -208,7 +229,7 @@ namespace ns_miniz
      *     true    if file exists
      *     false    if it does not
      */
-    bool fileExists( const char *fileName )
+    inline bool fileExists( const char *fileName )
     {
         FILE *f = FILESYSTEM_NAMESPACE::fopen(fileName, "rb");
         if (f != nullptr) {
@@ -228,7 +249,7 @@ namespace ns_miniz
      * Returns: N/A
      * Throws:: std::filesystem::filesystem_error upon failure - sourceFile will remain in that case
      */
-    void moveFile(const char *sourceFile, const char *destinationFile)
+    inline void moveFile(const char *sourceFile, const char *destinationFile)
     {
         bool success = false;
         if (0 == FILESYSTEM_NAMESPACE::rename(sourceFile, destinationFile)) { // initially: try move
@@ -9838,6 +9859,104 @@ namespace Zippy::Impl
         return result + ".tmp";
     }
 
+    /**
+     * @brief Read-only memory mapping of a whole file.
+     * @details Used by ZipArchive to let miniz parse the central directory and inflate entries straight from the
+     * mapped pages, so only the parts of the archive that are actually read are paged in. On platforms without
+     * mmap support, Map() always fails and the caller falls back to regular file reading.
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        MappedFile(const MappedFile& other)            = delete;
+        MappedFile& operator=(const MappedFile& other) = delete;
+        MappedFile(MappedFile&& other) noexcept { Swap(other); }
+        MappedFile& operator=(MappedFile&& other) noexcept
+        {
+            if (this != &other) {
+                Unmap();
+                Swap(other);
+            }
+            return *this;
+        }
+        ~MappedFile() { Unmap(); }
+
+        /**
+         * @brief Map the given file into memory.
+         * @param fileName The file to map.
+         * @return true if the file was mapped; false if mapping is unsupported or failed (e.g. an empty file).
+         */
+        bool Map(const std::string& fileName)
+        {
+            Unmap();
+#if defined(_WIN32) && defined(ZIPPY_HAS_MMAP)
+            HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE) return false;
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+                CloseHandle(file);
+                return false;
+            }
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            CloseHandle(file);
+            if (!mapping) return false;
+            void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);    // the view keeps the mapping alive
+            if (!view) return false;
+            m_Data = static_cast<const unsigned char*>(view);
+            m_Size = static_cast<size_t>(fileSize.QuadPart);
+            return true;
+#elif defined(ZIPPY_HAS_MMAP)
+            int fd = ::open(fileName.c_str(), O_RDONLY);
+            if (fd < 0) return false;
+            struct stat st;
+            if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+                ::close(fd);
+                return false;
+            }
+            void* view = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd);    // the mapping stays valid after the descriptor is closed
+            if (view == MAP_FAILED) return false;
+            m_Data = static_cast<const unsigned char*>(view);
+            m_Size = static_cast<size_t>(st.st_size);
+            return true;
+#else
+            (void)fileName;
+            return false;
+#endif
+        }
+
+        /**
+         * @brief Release the mapping, if any.
+         */
+        void Unmap()
+        {
+            if (!m_Data) return;
+#if defined(_WIN32) && defined(ZIPPY_HAS_MMAP)
+            UnmapViewOfFile(m_Data);
+#elif defined(ZIPPY_HAS_MMAP)
+            ::munmap(const_cast<unsigned char*>(m_Data), m_Size);
+#endif
+            m_Data = nullptr;
+            m_Size = 0;
+        }
+
+        bool                 IsMapped() const { return m_Data != nullptr; }
+        const unsigned char* Data() const { return m_Data; }
+        size_t               Size() const { return m_Size; }
+
+    private:
+        void Swap(MappedFile& other) noexcept
+        {
+            std::swap(m_Data, other.m_Data);
+            std::swap(m_Size, other.m_Size);
+        }
+
+        const unsigned char* m_Data = nullptr; /**< Start of the mapped view. */
+        size_t               m_Size = 0;       /**< Size of the mapped view in bytes. */
+    };
+
 }    // namespace Zippy::Impl
 
 namespace Zippy
@@ -10014,12 +10133,7 @@ namespace Zippy
              */
             std::string GetDataAsString() const
             {
-                std::string result;
-                for (const auto& ch : m_EntryData) {
-                    result += static_cast<char>(ch);
-                }    // TODO: Should this use reinterpret_cast instead?
-
-                return result;
+                return std::string(m_EntryData.begin(), m_EntryData.end());
             }
 
             /**
@@ -10222,6 +10336,94 @@ namespace Zippy
                 return info;
             }
         };
+
+        /**
+         * @brief Size of the independently deflated blocks that large entries are split into when saving.
+         */
+        constexpr size_t DeflateBlockSize = 1024 * 1024;
+
+        /**
+         * @brief Modified entries smaller than this (in total) are compressed on the calling thread only.
+         */
+        constexpr size_t ParallelDeflateThreshold = 256 * 1024;
+
+        /**
+         * @brief The raw deflate stream and CRC-32 of an entry that has been compressed ahead of writing.
+         */
+        struct PrecompressedEntry
+        {
+            std::vector<ZipEntryData> blocks;      /**< The compressed blocks, to be written back to back. */
+            mz_uint32                 crc   = 0;   /**< CRC-32 of the uncompressed data. */
+            int                       level = MZ_DEFAULT_LEVEL;    /**< The compression level chosen for the entry. */
+            bool                      ready = false;
+            bool                      recompress = false;    /**< An unmodified entry that is rewritten at a new level. */
+            ZipEntryData              data;    /**< The extracted data of a recompressed entry. */
+        };
+
+        /**
+         * @brief Deflate one block of an entry into a raw deflate stream.
+         * @details All blocks but the last end with a full flush, so they are byte aligned, do not set the final-block bit and
+         * do not refer back into the previous block. Concatenating the blocks in order therefore yields one valid deflate
+         * stream, in the same way pigz builds its output.
+         * @param data Pointer to the block data.
+         * @param size The block size.
+         * @param last true for the last block of the entry.
+         * @param level The compression level (1 - 10).
+         * @return The compressed block.
+         */
+        inline ZipEntryData DeflateBlock(const unsigned char* data, size_t size, bool last, int level)
+        {
+            ZipEntryData out;
+            out.reserve(size / 4 + 64);
+            auto compressor = std::make_unique<tdefl_compressor>();
+            auto flags      = tdefl_create_comp_flags_from_zip_params(level, -MZ_DEFAULT_WINDOW_BITS, MZ_DEFAULT_STRATEGY);
+            auto output     = [](const void* buf, int len, void* user) -> mz_bool {
+                auto* target = static_cast<ZipEntryData*>(user);
+                target->insert(target->end(), static_cast<const unsigned char*>(buf), static_cast<const unsigned char*>(buf) + len);
+                return MZ_TRUE;
+            };
+            if (tdefl_init(compressor.get(), output, &out, static_cast<int>(flags)) != TDEFL_STATUS_OKAY)
+                throw ZipRuntimeError("Failed to initialise deflate");
+
+            tdefl_status status = tdefl_compress_buffer(compressor.get(), data, size, last ? TDEFL_FINISH : TDEFL_FULL_FLUSH);
+            if (status != (last ? TDEFL_STATUS_DONE : TDEFL_STATUS_OKAY)) throw ZipRuntimeError("Failed to deflate entry data");
+            return out;
+        }
+
+        /**
+         * @brief Run a number of independent tasks on a pool of worker threads.
+         * @details Tasks are handed out through an atomic counter. The first exception thrown by a task is rethrown on the
+         * calling thread once all workers have finished.
+         * @param taskCount The number of tasks.
+         * @param threadCount The maximum number of threads to use, including the calling thread.
+         * @param task The task function, called with the task index.
+         */
+        inline void RunParallel(size_t taskCount, size_t threadCount, const std::function<void(size_t)>& task)
+        {
+            std::atomic<size_t> next { 0 };
+            std::exception_ptr  error;
+            std::mutex          errorMutex;
+            auto                worker = [&]() {
+                for (size_t i = next++; i < taskCount; i = next++) {
+                    try {
+                        task(i);
+                    }
+                    catch (...) {
+                        std::lock_guard<std::mutex> lock(errorMutex);
+                        if (!error) error = std::current_exception();
+                    }
+                }
+            };
+
+            threadCount = std::max<size_t>(1, std::min(threadCount, taskCount));
+            std::vector<std::thread> threads;
+            threads.reserve(threadCount - 1);
+            for (size_t i = 1; i < threadCount; ++i) threads.emplace_back(worker);
+            worker();
+            for (auto& thread : threads) thread.join();
+            if (error) std::rethrow_exception(error);
+        }
+
     }    // namespace Impl
 
     /**
@@ -10413,6 +10615,98 @@ namespace Zippy
 
 namespace Zippy
 {
+    /**
+     * @brief The ZipEntryStream class reads the uncompressed bytes of a single entry in chunks.
+     * @details Entries that have not been loaded into memory are inflated incrementally from the archive, so reading
+     * a large entry only needs a fixed amount of memory. Entries that are already loaded (or have been modified) are
+     * read from their in-memory data. A stream is obtained from ZipArchive::OpenEntryStream() and refers to the
+     * archive, which must stay open (and must not be saved) while the stream is in use.
+     */
+    class ZipEntryStream
+    {
+        friend class ZipArchive;
+
+    public:
+        /**
+         * @brief Constructor. Constructs a closed stream.
+         */
+        ZipEntryStream() = default;
+
+        /**
+         * @brief Destructor. Releases the inflate state, if any.
+         */
+        ~ZipEntryStream() { Close(); }
+
+        ZipEntryStream(const ZipEntryStream&)            = delete;
+        ZipEntryStream& operator=(const ZipEntryStream&) = delete;
+
+        /**
+         * @brief Move constructor.
+         */
+        ZipEntryStream(ZipEntryStream&& other) noexcept { *this = std::move(other); }
+
+        /**
+         * @brief Move assignment operator.
+         */
+        ZipEntryStream& operator=(ZipEntryStream&& other) noexcept
+        {
+            if (this != &other) {
+                Close();
+                m_State    = std::exchange(other.m_State, nullptr);
+                m_Data     = std::exchange(other.m_Data, nullptr);
+                m_DataSize = std::exchange(other.m_DataSize, 0);
+                m_Position = std::exchange(other.m_Position, 0);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Is the stream open?
+         * @return true if bytes can be read from the stream; otherwise false.
+         */
+        bool IsOpen() const { return m_State != nullptr || m_Data != nullptr; }
+
+        /**
+         * @brief Read the next bytes of the entry.
+         * @param buffer The destination buffer.
+         * @param size The capacity of the destination buffer.
+         * @return The number of bytes read. 0 indicates the end of the entry.
+         * @throws ZipRuntimeError if the entry data is corrupt.
+         */
+        size_t Read(void* buffer, size_t size)
+        {
+            if (m_Data) {
+                size_t count = std::min(size, m_DataSize - m_Position);
+                std::memcpy(buffer, m_Data + m_Position, count);
+                m_Position += count;
+                return count;
+            }
+            if (!m_State || size == 0) return 0;
+
+            size_t count = mz_zip_reader_extract_iter_read(m_State, buffer, size);
+            if (count == 0 && m_State->status < 0) throw ZipRuntimeError("Failed to inflate zip entry");
+            return count;
+        }
+
+        /**
+         * @brief Close the stream and release the inflate state.
+         */
+        void Close()
+        {
+            if (m_State) mz_zip_reader_extract_iter_free(m_State);
+            m_State    = nullptr;
+            m_Data     = nullptr;
+            m_DataSize = 0;
+            m_Position = 0;
+        }
+
+    private:
+        mz_zip_reader_extract_iter_state* m_State    = nullptr; /**< The miniz inflate state, for entries read from the archive. */
+        const unsigned char*              m_Data     = nullptr; /**< The entry bytes, for entries held in memory. */
+        size_t                            m_DataSize = 0;       /**< The size of m_Data. */
+        size_t                            m_Position = 0;       /**< The read position in m_Data. */
+    };
+
     /**
      * @brief The ZipArchive class represents the zip archive file as a whole. It consists of the individual zip entries, which
      * can be both files and folders. It is the main access point into a .zip archive on disk and can be
@@ -10580,13 +10874,59 @@ namespace Zippy
             if (m_IsOpen) {
                 mz_zip_reader_end(&m_Archive);
             }
+            m_Buffer.clear();
+            m_Mapping.Unmap();
             m_ArchivePath = fileName;
-            if (!mz_zip_reader_init_file(&m_Archive, m_ArchivePath.c_str(), 0)) {
+
+            // ===== Prefer reading straight from a memory mapping of the file; fall back to regular file reading.
+            bool mapped = m_Mapping.Map(m_ArchivePath) && mz_zip_reader_init_mem(&m_Archive, m_Mapping.Data(), m_Mapping.Size(), 0);
+            if (!mapped) {
+                m_Mapping.Unmap();
+                m_Archive = mz_zip_archive();
+            }
+            if (!mapped && !mz_zip_reader_init_file(&m_Archive, m_ArchivePath.c_str(), 0)) {
                 // throw ZipRuntimeError(mz_zip_get_error_string(m_Archive.m_last_error));
                 throw ZipRuntimeError(std::string(mz_zip_get_error_string(m_Archive.m_last_error)) + " (m_ArchivePath: " + m_ArchivePath + ")");
             }
             m_IsOpen = true;
 
+            LoadEntries();
+        }
+
+        /**
+         * @brief Open an archive held in memory.
+         * @details
+         * ##### Implementation details
+         * The buffer is copied into the archive object, so the caller's memory does not have to outlive it. Entry data is
+         * read straight from the copy and no file system access takes place. The archive has no path until it is saved
+         * to a file with Save(filename).
+         * @param data Pointer to the first byte of the archive.
+         * @param size The size of the archive in bytes.
+         */
+        void Open(const void* data, size_t size)
+        {
+            // ===== Open the in-memory archive for reading.
+            if (m_IsOpen) {
+                mz_zip_reader_end(&m_Archive);
+            }
+            m_ArchivePath = "";
+            m_Mapping.Unmap();
+            m_Buffer.assign(static_cast<const unsigned char*>(data), static_cast<const unsigned char*>(data) + size);
+            if (!mz_zip_reader_init_mem(&m_Archive, m_Buffer.data(), m_Buffer.size(), 0)) {
+                m_Buffer.clear();
+                throw ZipRuntimeError(std::string(mz_zip_get_error_string(m_Archive.m_last_error)) + " (in-memory archive)");
+            }
+            m_IsOpen = true;
+
+            LoadEntries();
+        }
+
+    private:
+        /**
+         * @brief Load the meta data for all entries of the archive opened in m_Archive.
+         */
+        void LoadEntries()
+        {
             // ===== Iterate through the archive and add the entries to the internal data structure
             for (unsigned int i = 0; i < mz_zip_reader_get_num_files(&m_Archive); i++) {
                 ZipEntryInfo info;
@@ -10612,6 +10952,8 @@ namespace Zippy
             }
         }
 
+    public:
+
         /**
          * @brief Close the archive for reading and writing.
          * @note If the archive has been modified but not saved, all changes will be discarded.
@@ -10624,6 +10966,8 @@ namespace Zippy
             m_ArchivePath = "";
             m_IsOpen = false;       // 2024-12-18: minor bugfix, m_IsOpen was not set to false
             m_ZipEntries.clear();
+            m_Buffer.clear();
+            m_Mapping.Unmap();    // must happen before the file is deleted or replaced in Save()
         }
 
         /**
@@ -10811,8 +11155,10 @@ namespace Zippy
         {
             if (!IsOpen()) throw ZipLogicError("Cannot call HasEntry on empty ZipArchive object!");
 
-            auto result = GetEntryNames(true, true);
-            return std::find(result.begin(), result.end(), entryName) != result.end();
+            // ===== Search the entry index directly, without building a list of names first.
+            return std::any_of(m_ZipEntries.begin(), m_ZipEntries.end(), [&](const Impl::ZipEntry& entry) {
+                return entry.GetName() == entryName;
+            });
         }
 
         /**
@@ -10828,6 +11174,7 @@ namespace Zippy
             if (filename.empty()) {
                 filename = m_ArchivePath;
             }
+            if (filename.empty()) throw ZipLogicError("Cannot save an in-memory ZipArchive without a filename!");
 #           ifdef _WIN32
                std::replace( filename.begin(), filename.end(), '\\', '/' ); // pull request #210, alternate fix: fopen etc work fine with forward slashes
 #           endif
@@ -10854,25 +11201,8 @@ namespace Zippy
             if (!mz_zip_writer_init_file(&tempArchive, tempPath.c_str(), 0))              // pull request #210
                 throw ZipRuntimeError(mz_zip_get_error_string(tempArchive.m_last_error)); //  "
 
-            // ===== Iterate through the ZipEntries and add entries to the temporary file
-            for (auto& file : m_ZipEntries) {
-                if (file.IsDirectory()) continue;    // TODO: Ensure this is the right thing to do (Excel issue)
-                if (!file.IsModified()) {
-                    if (!mz_zip_writer_add_from_zip_reader(&tempArchive, &m_Archive, file.Index())) {
-                        throw ZipRuntimeError(mz_zip_get_error_string(m_Archive.m_last_error));
-                    }
-                }
-
-                else {
-                    if (!mz_zip_writer_add_mem(&tempArchive,
-                                               file.GetName().c_str(),
-                                               file.m_EntryData.data(),
-                                               file.m_EntryData.size(),
-                                               MZ_DEFAULT_COMPRESSION)) {
-                        throw ZipRuntimeError(mz_zip_get_error_string(m_Archive.m_last_error));
-                    }
-                }
-            }
+            // ===== Add all entries to the temporary file
+            WriteEntries(tempArchive);
 
             // ===== Finalize and close the temporary archive
             mz_zip_writer_finalize_archive(&tempArchive);
@@ -10898,8 +11228,58 @@ namespace Zippy
         void Save(std::ostream& stream)
         {
             if (!IsOpen()) throw ZipLogicError("Cannot call ZipArchive::Save(std::ostream&) on empty ZipArchive object!");
-            throw ZipLogicError("ZipArchive::Save(std::ostream&) is not yet implemented!"); // TODO: To be implemented
-            (void) stream; // 2024-08-18: suppress -Wunused-parameter
+            Save([&stream](const char* data, size_t size) {
+                stream.write(data, static_cast<std::streamsize>(size));
+                if (!stream) throw ZipRuntimeError("Failed to write archive to stream");
+            });
+        }
+
+        /**
+         * @brief Save the archive by passing its bytes, in order, to a callback.
+         * @details The archive is written front to back without seeking, so the callback may forward the bytes to a socket
+         * or any other sequential sink. The archive stays open on its current source, with modified entries kept in memory.
+         * @param write The callback receiving the bytes. It may throw to abort the save; the exception is rethrown.
+         * @throws ZipException A ZipException object is thrown if calls to miniz function fails.
+         */
+        void Save(const std::function<void(const char*, size_t)>& write)
+        {
+            if (!IsOpen()) throw ZipLogicError("Cannot call Save on empty ZipArchive object!");
+
+            // ===== miniz addresses writes by offset; accept only the next offset, so the output is strictly sequential.
+            struct Sink
+            {
+                const std::function<void(const char*, size_t)>* write;
+                mz_uint64                                        offset = 0;
+                std::exception_ptr                               error;
+            } sink { &write };
+
+            mz_zip_archive target = mz_zip_archive();
+            target.m_pIO_opaque   = &sink;
+            target.m_pWrite       = [](void* opaque, mz_uint64 offset, const void* buffer, size_t size) -> size_t {
+                auto* out = static_cast<Sink*>(opaque);
+                if (out->error || offset != out->offset) return 0;
+                try {
+                    (*out->write)(static_cast<const char*>(buffer), size);
+                }
+                catch (...) {
+                    out->error = std::current_exception();
+                    return 0;
+                }
+                out->offset += size;
+                return size;
+            };
+            if (!mz_zip_writer_init_v2(&target, 0, 0)) throw ZipRuntimeError(mz_zip_get_error_string(target.m_last_error));
+
+            try {
+                WriteEntries(target);
+                if (!mz_zip_writer_finalize_archive(&target)) throw ZipRuntimeError(mz_zip_get_error_string(target.m_last_error));
+            }
+            catch (...) {
+                mz_zip_writer_end(&target);
+                if (sink.error) std::rethrow_exception(sink.error);
+                throw;
+            }
+            mz_zip_writer_end(&target);
         }
 
         /**
@@ -10949,6 +11329,74 @@ namespace Zippy
             return ZipEntry(&*result);
         }
 
+        /**
+         * @brief Get the raw bytes of an entry without copying or caching them.
+         * @details This is possible when the archive is read from memory (a mapped file or a buffer) and the entry is
+         * stored uncompressed, unencrypted and unmodified, which is typically the case for media files. The returned
+         * pointer refers directly to the archive bytes and remains valid until the archive is closed or saved.
+         * @param name The name of the entry in the archive.
+         * @return A pair of pointer and size. The pointer is nullptr if no zero-copy view is available.
+         */
+        std::pair<const unsigned char*, size_t> GetEntryView(const std::string& name) const
+        {
+            if (!IsOpen()) throw ZipLogicError("Cannot call GetEntryView on empty ZipArchive object!");
+
+            const unsigned char* base = m_Mapping.IsMapped() ? m_Mapping.Data() : (m_Buffer.empty() ? nullptr : m_Buffer.data());
+            size_t               size = m_Mapping.IsMapped() ? m_Mapping.Size() : m_Buffer.size();
+            if (!base) return { nullptr, 0 };
+
+            auto result = std::find_if(m_ZipEntries.begin(), m_ZipEntries.end(), [&](const Impl::ZipEntry& entry) {
+                return name == entry.GetName();
+            });
+            if (result == m_ZipEntries.end() || result->IsDirectory() || result->IsModified()) return { nullptr, 0 };
+
+            const ZipEntryInfo& info = result->m_EntryInfo;
+            if (info.m_method != 0 || info.m_is_encrypted || info.m_comp_size != info.m_uncomp_size) return { nullptr, 0 };
+
+            // ===== Skip the local file header (30 bytes + file name + extra field) to reach the entry data.
+            constexpr size_t localHeaderSize = 30;
+            size_t           headerOfs       = static_cast<size_t>(info.m_local_header_ofs);
+            if (headerOfs + localHeaderSize > size) return { nullptr, 0 };
+            const unsigned char* header = base + headerOfs;
+            if (header[0] != 0x50 || header[1] != 0x4b || header[2] != 0x03 || header[3] != 0x04) return { nullptr, 0 };
+            size_t nameLen  = static_cast<size_t>(header[26]) | (static_cast<size_t>(header[27]) << 8);
+            size_t extraLen = static_cast<size_t>(header[28]) | (static_cast<size_t>(header[29]) << 8);
+            size_t dataOfs  = headerOfs + localHeaderSize + nameLen + extraLen;
+            if (dataOfs + static_cast<size_t>(info.m_comp_size) > size) return { nullptr, 0 };
+
+            return { base + dataOfs, static_cast<size_t>(info.m_comp_size) };
+        }
+
+        /**
+         * @brief Open a stream that reads the uncompressed bytes of an entry in chunks.
+         * @details Unlike GetEntry(), the entry data is neither fully extracted nor cached; it is inflated as it is read.
+         * @param name The name of the entry in the archive.
+         * @return A ZipEntryStream object. The stream is closed (IsOpen() returns false) if the entry does not exist.
+         * @throws ZipRuntimeError if the entry cannot be opened for reading.
+         */
+        ZipEntryStream OpenEntryStream(const std::string& name)
+        {
+            if (!IsOpen()) throw ZipLogicError("Cannot call OpenEntryStream on empty ZipArchive object!");
+
+            ZipEntryStream stream;
+            auto result = std::find_if(m_ZipEntries.begin(), m_ZipEntries.end(), [&](const Impl::ZipEntry& entry) {
+                return name == entry.GetName();
+            });
+            if (result == m_ZipEntries.end() || result->IsDirectory()) return stream;
+
+            // ===== Entries that are already in memory are read from there, others are inflated from the archive.
+            if (!result->m_EntryData.empty()) {
+                stream.m_Data     = result->m_EntryData.data();
+                stream.m_DataSize = result->IsModified() ? result->m_EntryData.size()
+                                                         : std::min(result->m_EntryData.size(), static_cast<size_t>(result->UncompressedSize()));
+                return stream;
+            }
+
+            stream.m_State = mz_zip_reader_extract_iter_new(&m_Archive, static_cast<mz_uint>(result->Index()), 0);
+            if (!stream.m_State) throw ZipRuntimeError(std::string(mz_zip_get_error_string(m_Archive.m_last_error)) + " (entry: " + name + ")");
+            return stream;
+        }
+
         /**
          * @brief Extract the entry with the provided name to the destination path.
          * @param name The name of the entry to extract.
@@ -11025,12 +11473,7 @@ namespace Zippy
          */
         ZipEntry AddEntry(const std::string& name, const std::string& data)
         {
-            ZipEntryData stringData;
-            stringData.reserve(data.size());
-            for (const auto& ch : data) {
-                stringData.emplace_back(ch);
-            }
-
+            ZipEntryData stringData(data.begin(), data.end());
             return AddEntryImpl(name, stringData);
         }
 
@@ -11047,7 +11490,146 @@ namespace Zippy
             return AddEntryImpl(name, entry.GetData());
         }
 
+        /**
+         * @brief Set the number of threads used to compress entries when saving.
+         * @param count The number of threads. 0 (the default) uses std::thread::hardware_concurrency().
+         */
+        void SetThreadCount(size_t count) { m_ThreadCount = count; }
+
+        /**
+         * @brief Set the compression level used for the entries written by the next calls to Save.
+         * @param levelFor A function returning the level (0 - 10) for an entry name. 0 stores the entry uncompressed. A
+         * negative level means that no rule applies to the entry. An empty function (the default) returns -1 for all entries.
+         * @note Modified entries without a rule use MZ_DEFAULT_LEVEL. Unmodified entries without a rule are copied from the
+         * source archive as they are; unmodified entries with a rule are recompressed at that level, unless they are already
+         * stored and the level is 0.
+         */
+        void SetCompressionLevel(std::function<int(const std::string&)> levelFor) { m_CompressionLevel = std::move(levelFor); }
+
     private:
+        /**
+         * @brief Write all entries to an archive that is being written.
+         * @details Unmodified entries without a compression rule are copied from the source archive with their compressed
+         * data; the other entries are compressed first, in parallel (see Precompress()).
+         * @param target The miniz archive, initialised for writing.
+         * @throws ZipException A ZipException object is thrown if calls to miniz function fails.
+         */
+        void WriteEntries(mz_zip_archive& target)
+        {
+            // ===== Compress the modified entries up front, in parallel
+            auto precompressed = Precompress();
+
+            // ===== Iterate through the ZipEntries and add them to the target
+            for (size_t index = 0; index < m_ZipEntries.size(); ++index) {
+                auto& file = m_ZipEntries[index];
+                if (file.IsDirectory()) continue;    // TODO: Ensure this is the right thing to do (Excel issue)
+                if (!file.IsModified() && !precompressed[index].recompress) {
+                    if (!mz_zip_writer_add_from_zip_reader(&target, &m_Archive, file.Index())) {
+                        throw ZipRuntimeError(mz_zip_get_error_string(m_Archive.m_last_error));
+                    }
+                }
+
+                else if (precompressed[index].ready) {
+                    // ===== Compressed ahead of time; join the blocks and write them as deflated data.
+                    const auto& entry = precompressed[index];
+                    ZipEntryData joined;
+                    if (entry.blocks.size() == 1) joined = std::move(precompressed[index].blocks.front());
+                    else
+                        for (const auto& block : entry.blocks) joined.insert(joined.end(), block.begin(), block.end());
+                    if (!mz_zip_writer_add_mem_ex(&target,
+                                                  file.GetName().c_str(),
+                                                  joined.data(),
+                                                  joined.size(),
+                                                  nullptr,
+                                                  0,
+                                                  entry.level | MZ_ZIP_FLAG_COMPRESSED_DATA,
+                                                  entry.recompress ? entry.data.size() : file.m_EntryData.size(),
+                                                  entry.crc)) {
+                        throw ZipRuntimeError(mz_zip_get_error_string(target.m_last_error));
+                    }
+                }
+
+                else {
+                    const auto& data = precompressed[index].recompress ? precompressed[index].data : file.m_EntryData;
+                    if (!mz_zip_writer_add_mem(&target, file.GetName().c_str(), data.data(), data.size(), precompressed[index].level)) {
+                        throw ZipRuntimeError(mz_zip_get_error_string(target.m_last_error));
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Deflate all modified entries on a pool of threads.
+         * @details Each entry is split into blocks of Impl::DeflateBlockSize bytes that are compressed independently, so a
+         * single huge entry (typically a worksheet) is spread over all threads as well. The CRC-32 of each entry is
+         * computed as a separate task. If the modified data is small in total, everything runs on the calling thread.
+         * Unmodified entries that have a compression rule are extracted and compressed like modified ones. Entries with
+         * compression level 0 are left to Save, which stores them.
+         * @return One Impl::PrecompressedEntry per entry in m_ZipEntries; only rewritten, non-empty, deflated files are ready.
+         */
+        std::vector<Impl::PrecompressedEntry> Precompress()
+        {
+            std::vector<Impl::PrecompressedEntry> result(m_ZipEntries.size());
+
+            // ===== Build the task list: one task per block, plus one CRC task per entry.
+            struct Task
+            {
+                size_t entry;
+                size_t block;    // SIZE_MAX for the CRC task
+            };
+            std::vector<Task> tasks;
+            size_t            totalSize = 0;
+            for (size_t i = 0; i < m_ZipEntries.size(); ++i) {
+                const auto& file = m_ZipEntries[i];
+                if (file.IsDirectory()) continue;
+                const int rule = m_CompressionLevel ? m_CompressionLevel(file.GetName()) : -1;
+                if (!file.IsModified()) {
+                    // ===== Without a rule the compressed data is copied; a stored entry that should stay stored is too.
+                    if (rule < 0) continue;
+                    mz_zip_archive_file_stat stat;
+                    if (!mz_zip_reader_file_stat(&m_Archive, file.Index(), &stat))
+                        throw ZipRuntimeError(mz_zip_get_error_string(m_Archive.m_last_error));
+                    if (rule == 0 && stat.m_method == 0) continue;
+                    result[i].recompress = true;
+                    result[i].data.resize(static_cast<size_t>(stat.m_uncomp_size));
+                    if (!result[i].data.empty() &&
+                        !mz_zip_reader_extract_to_mem(&m_Archive,
+                                                      file.Index(),
+                                                      result[i].data.data(),
+                                                      result[i].data.size(),
+                                                      0))
+                        throw ZipRuntimeError(mz_zip_get_error_string(m_Archive.m_last_error));
+                }
+                if (rule >= 0) result[i].level = std::min(rule, static_cast<int>(MZ_UBER_COMPRESSION));
+                const auto& data = result[i].recompress ? result[i].data : file.m_EntryData;
+                if (data.empty() || result[i].level == 0) continue;
+                size_t blockCount = (data.size() + Impl::DeflateBlockSize - 1) / Impl::DeflateBlockSize;
+                result[i].blocks.resize(blockCount);
+                result[i].ready = true;
+                for (size_t b = 0; b < blockCount; ++b) tasks.push_back({ i, b });
+                tasks.push_back({ i, SIZE_MAX });
+                totalSize += data.size();
+            }
+
+            size_t threads = m_ThreadCount ? m_ThreadCount : std::max(1u, std::thread::hardware_concurrency());
+            if (totalSize < Impl::ParallelDeflateThreshold) threads = 1;
+
+            Impl::RunParallel(tasks.size(), threads, [&](size_t t) {
+                const auto&  task = tasks[t];
+                auto&        out  = result[task.entry];
+                const auto&  data = out.recompress ? out.data : m_ZipEntries[task.entry].m_EntryData;
+                if (task.block == SIZE_MAX) {
+                    out.crc = static_cast<mz_uint32>(mz_crc32(MZ_CRC32_INIT, data.data(), data.size()));
+                    return;
+                }
+                size_t offset = task.block * Impl::DeflateBlockSize;
+                size_t size   = std::min(Impl::DeflateBlockSize, data.size() - offset);
+                out.blocks[task.block] = Impl::DeflateBlock(data.data() + offset, size, task.block + 1 == out.blocks.size(), out.level);
+            });
+
+            return result;
+        }
+
         /**
          * @brief Add a new entry to the archive.
          * @param name The name of the entry to add.
@@ -11079,7 +11661,12 @@ namespace Zippy
             });
 
             // ===== If the entry exists, replace the existing data with the new data, and return the ZipEntry object.
+            // ===== An unmodified entry that is written back with identical data stays unmodified, so Save() can still
+            // ===== copy its compressed bytes and CRC from the source archive instead of recompressing it.
             if (result != m_ZipEntries.end()) {
+                if (!result->IsModified() && !result->m_EntryData.empty() && result->UncompressedSize() == data.size() &&
+                    std::equal(data.begin(), data.end(), result->m_EntryData.begin()))
+                    return ZipEntry(&*result);
                 result->SetData(data);
                 return ZipEntry(&*result);
             }
@@ -11092,6 +11679,10 @@ namespace Zippy
         mz_zip_archive m_Archive     = mz_zip_archive(); /**< The struct used by miniz, to handle archive files. */
         std::string    m_ArchivePath = "";               /**< The path of the archive file. */
         bool           m_IsOpen      = false;            /**< A flag indicating if the file is currently open for reading and writing. */
+        ZipEntryData   m_Buffer      = ZipEntryData();   /**< The archive bytes, when the archive was opened from memory. */
+        Impl::MappedFile m_Mapping   = Impl::MappedFile(); /**< The mapped archive file, when mapping succeeded. */
+        size_t           m_ThreadCount = 0;                /**< The number of compression threads, 0 for automatic. */
+        std::function<int(const std::string&)> m_CompressionLevel; /**< The compression level per entry name, empty for the default. */
 
         std::vector<Impl::ZipEntry> m_ZipEntries = std::vector<Impl::ZipEntry>(); /**< Data structure for all entries in the archive. */
     };
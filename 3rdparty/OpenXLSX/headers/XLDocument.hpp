@@ -229,6 +229,13 @@ namespace OpenXLSX
          */
         [[deprecated]] void saveAs(const std::string& fileName);
 
+        /**
+         * @brief Write all loaded XML parts back into the archive, without saving the archive.
+         * @details This is the first half of saveAs(); use it before writing the archive to a target other than a file.
+         * @throw XLException (OpenXLSX failed checks)
+         */
+        void commit();
+
         /**
          * @brief Get the filename of the current document, e.g. "spreadsheet.xlsx".
          * @return A std::string with the filename.
@@ -438,8 +445,9 @@ namespace OpenXLSX
 
         XLXmlSavingDeclaration m_xmlSavingDeclaration;  /**< The xml saving declaration that will be passed to pugixml before generating the XML output data*/
 
-        mutable std::list<XLXmlData>    m_data {};              /**<  */
+        mutable XLXmlDataRegistry       m_data {};              /**< the XML parts of the document, indexed by path */
         mutable std::deque<std::string> m_sharedStringCache {}; /**<  */
+        mutable XLSharedStringIndex     m_sharedStringIndex {}; /**< hash index into m_sharedStringCache */
         mutable XLSharedStrings         m_sharedStrings {};     /**<  */
 
         XLRelationships m_docRelationships {}; /**< A pointer to the document relationships object*/
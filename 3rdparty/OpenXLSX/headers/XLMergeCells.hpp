@@ -54,6 +54,7 @@ YM      M9  MM    MM MM       MM    MM   d'  `MM.    MM            MM   d'  `MM.
 
 #include <deque>
 #include <limits>     // std::numeric_limits
+#include <map>        // std::map
 #include <memory>     // std::unique_ptr
 #include <ostream>    // std::basic_ostream
 #include <string>
@@ -73,6 +74,25 @@ namespace OpenXLSX
     // pull request #261: wrapped max in parentheses to prevent expansion of windows.h "max" macro
     constexpr size_t XLMaxMergeCells = (std::numeric_limits< XLMergeIndex >::max)();
 
+    /**
+     * @brief The parsed rectangle of a merge range, as kept in the spatial index of XLMergeCells
+     */
+    struct XLMergeRect
+    {
+        uint32_t     topRow;
+        uint16_t     firstCol;
+        uint32_t     bottomRow;
+        uint16_t     lastCol;
+        XLMergeIndex index; /**< position of the merge in the reference cache */
+    };
+
+    /**
+     * @brief The spatial index of XLMergeCells: an implicit interval tree over the rows [1;MAX_ROWS]. Each merge is stored at
+     *  the topmost node whose center row it spans, keyed by that center row. All merges of a node contain its center row, so
+     *  (as merges do not overlap) they do not overlap in columns either, and are kept sorted by firstCol.
+     */
+    using XLMergeRowIndex = std::map<uint32_t, std::vector<XLMergeRect>>;
+
     /**
      * @brief This class encapsulate the Excel concept of <mergeCells>. Each worksheet that has merged cells has a list of
      * (empty) <mergeCell> elements within that array, with a sole attribute ref="..." with ... being a range reference, e.g. A1:B5
@@ -153,6 +173,7 @@ namespace OpenXLSX
          * @brief get the index of a <mergeCell> entry of which cellReference is a part
          * @param cellRef the cell reference (string or XLCellReference) to search for in the merged ranges
          * @return XLMergeNotFound (-1) if no such reference exists, 0-based index otherwise
+         * @note uses the sorted merge index: cost is O(h log n), where h is the row span of the tallest merge
          */
         XLMergeIndex findMergeByCell(const std::string& cellRef) const;
         XLMergeIndex findMergeByCell(XLCellReference cellRef) const;
@@ -206,6 +227,7 @@ namespace OpenXLSX
         std::vector< std::string_view > m_nodeOrder; /**< worksheet XML root node required child sequence as passed into constructor */
         std::unique_ptr<XMLNode> m_mergeCellsNode; /**< An XMLNode object with the mergeCells item */
         std::deque<std::string> m_referenceCache;
+        XLMergeRowIndex m_mergeIndex;                /**< the merge rectangles, for point & overlap lookups in O(log n) */
     };
 }    // namespace OpenXLSX
 
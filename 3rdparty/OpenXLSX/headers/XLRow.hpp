@@ -60,6 +60,7 @@ YM      M9  MM    MM MM       MM    MM   d'  `MM.    MM            MM   d'  `MM.
 namespace OpenXLSX
 {
     class XLRowRange;
+    class XLSheetNodeIndex;
 
     /**
      * @brief The XLRow class represent a row in an Excel spreadsheet. Using XLRow objects, various row formatting
@@ -87,8 +88,9 @@ namespace OpenXLSX
          * @brief
          * @param rowNode
          * @param sharedStrings
+         * @param nodeIndex the node index of the worksheet, to be notified when cell nodes are removed from the row - may be nullptr
          */
-        XLRow(const XMLNode& rowNode, const XLSharedStrings& sharedStrings);
+        XLRow(const XMLNode& rowNode, const XLSharedStrings& sharedStrings, XLSheetNodeIndex* nodeIndex = nullptr);
 
         /**
          * @brief Copy Constructor
@@ -267,6 +269,7 @@ namespace OpenXLSX
         //---------- PRIVATE MEMBER VARIABLES ----------//
         std::unique_ptr<XMLNode> m_rowNode;       /**< The XMLNode object for the row. */
         XLSharedStringsRef       m_sharedStrings; /**< */
+        XLSheetNodeIndex*        m_nodeIndex {};  /**< The node index of the worksheet, if any */
         XLRowDataProxy           m_rowDataProxy;  /**< */
     };
 
@@ -399,6 +402,7 @@ namespace OpenXLSX
         uint32_t                 m_lastRow { 1 };  /**< The cell reference of the last cell in the range */
         XLRow                    m_currentRow;     /**< */
         XLSharedStringsRef       m_sharedStrings;  /**< */
+        XLSheetNodeIndex*        m_nodeIndex {};   /**< The node index of the worksheet, if any */
 
         // helper variables for non-creating iterator functionality
         bool                     m_endReached;           /**< */
@@ -429,8 +433,13 @@ namespace OpenXLSX
          * @param first
          * @param last
          * @param sharedStrings
+         * @param nodeIndex the node index of the worksheet, passed on to the rows - may be nullptr
          */
-        explicit XLRowRange(const XMLNode& dataNode, uint32_t first, uint32_t last, const XLSharedStrings& sharedStrings);
+        explicit XLRowRange(const XMLNode&          dataNode,
+                            uint32_t                first,
+                            uint32_t                last,
+                            const XLSharedStrings&  sharedStrings,
+                            XLSheetNodeIndex*       nodeIndex = nullptr);
 
         /**
          * @brief
@@ -490,6 +499,7 @@ namespace OpenXLSX
         uint32_t                 m_firstRow;      /**< The cell reference of the first cell in the range */
         uint32_t                 m_lastRow;       /**< The cell reference of the last cell in the range */
         XLSharedStringsRef       m_sharedStrings; /**< */
+        XLSheetNodeIndex*        m_nodeIndex {};  /**< The node index of the worksheet, if any */
     };
 
 }    // namespace OpenXLSX
@@ -57,6 +57,8 @@ YM      M9  MM    MM MM       MM    MM   d'  `MM.    MM            MM   d'  `MM.
 #include <limits>     // std::numeric_limits
 #include <ostream>    // std::basic_ostream
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 // ===== OpenXLSX Includes ===== //
 #include "OpenXLSX-Exports.hpp"
@@ -69,6 +71,12 @@ namespace OpenXLSX
     class XLSharedStrings; // forward declaration
     typedef std::reference_wrapper< const XLSharedStrings > XLSharedStringsRef;
 
+    /**
+     * @brief Hash index from shared string content to the index of its first occurrence in the string cache.
+     * @note The keys point into the strings held by the cache, so they remain valid as long as those strings are not modified.
+     */
+    typedef std::unordered_map< std::string_view, int32_t > XLSharedStringIndex;
+
     extern const XLSharedStrings XLSharedStringsDefaulted; // to be used for default initialization of all references of type XLSharedStrings
 
     /**
@@ -95,8 +103,10 @@ namespace OpenXLSX
          * @brief
          * @param xmlData
          * @param stringCache
+         * @param stringIndex Hash index kept in sync with stringCache, rebuilt on construction. If nullptr, lookups
+         *                    fall back to a linear search of stringCache.
          */
-        explicit XLSharedStrings(XLXmlData* xmlData, std::deque<std::string>* stringCache);
+        explicit XLSharedStrings(XLXmlData* xmlData, std::deque<std::string>* stringCache, XLSharedStringIndex* stringIndex = nullptr);
 
         /**
          * @brief Destructor
@@ -192,8 +202,14 @@ namespace OpenXLSX
          */
         int32_t rewriteXmlFromCache();
 
+        /**
+         * @brief rebuild the hash index from the shared strings cache, e.g. after the cache was re-ordered
+         */
+        void rebuildIndex();
+
     private:
         std::deque<std::string>* m_stringCache {}; /** < Each string must have an unchanging memory address; hence the use of std::deque */
+        XLSharedStringIndex*     m_stringIndex {}; /** < string content -> index of first occurrence, keys point into m_stringCache */
     };
 }    // namespace OpenXLSX
 
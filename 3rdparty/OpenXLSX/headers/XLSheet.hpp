@@ -54,6 +54,8 @@ YM      M9  MM    MM MM       MM    MM   d'  `MM.    MM            MM   d'  `MM.
 
 // ===== External Includes ===== //
 #include <cstdint>      // uint8_t, uint16_t, uint32_t
+#include <functional>   // std::function
+#include <memory>       // std::shared_ptr
 #include <ostream>      // std::basic_ostream
 #include <string_view>  // std::string_view
 #include <type_traits>
@@ -73,6 +75,7 @@ YM      M9  MM    MM MM       MM    MM   d'  `MM.    MM            MM   d'  `MM.
 #include "XLException.hpp"
 #include "XLMergeCells.hpp"
 #include "XLRow.hpp"
+#include "XLSheetNodeIndex.hpp"
 #include "XLStyles.hpp"   // XLStyleIndex
 #include "XLTables.hpp"   // XLTables
 #include "XLXmlFile.hpp"
@@ -986,6 +989,37 @@ namespace OpenXLSX
          */
         XLCellRange range(std::string const& rangeReference) const;
 
+        /**
+         * @brief Get the sheetData node of the worksheet.
+         * @return The sheetData node, whose element children are the row nodes in ascending row order.
+         * @note Intended for forward scans that keep their own position (hint) node, so that each step only visits
+         *       the next sibling instead of searching from the start of the sheet.
+         */
+        XMLNode sheetData() const;
+
+        /**
+         * @brief Visit the existing cell nodes inside a rectangular range in a single pass over sheetData.
+         * @param topLeft The top left cell of the range.
+         * @param bottomRight The bottom right cell of the range.
+         * @param visitor Called with (row, column, cell node) for every existing cell in the range, in row-major order.
+         * @note Unlike iterating an XLCellRange, missing rows and cells are skipped and never created.
+         */
+        void visitRange(const XLCellReference& topLeft,
+                        const XLCellReference& bottomRight,
+                        const std::function<void(uint32_t, uint16_t, const XMLNode&)>& visitor) const;
+
+        /**
+         * @brief Write a rectangular range in a single ordered pass over sheetData.
+         * @param topLeft The top left cell of the range.
+         * @param bottomRight The bottom right cell of the range.
+         * @param writer Called with (row, column, cell node) for every cell in the range, in row-major order. Missing
+         *               rows and cells are created (with the default row / column style) before the call.
+         * @note The worksheet dimension is extended to cover the range.
+         */
+        void writeRange(const XLCellReference& topLeft,
+                        const XLCellReference& bottomRight,
+                        const std::function<void(uint32_t, uint16_t, XMLNode&)>& writer);
+
         /**
          * @brief
          * @return
@@ -1315,6 +1349,7 @@ namespace OpenXLSX
         XLVmlDrawing    m_vmlDrawing{};       /**< class handling the worksheet VML drawing object */
         XLComments      m_comments{};         /**< class handling the worksheet comments */
         XLTables        m_tables{};           /**< class handling the worksheet table settings */
+        std::shared_ptr<XLSheetNodeIndex> m_nodeIndex{ std::make_shared<XLSheetNodeIndex>() }; /**< row & cell node index, shared by all objects of this sheet */
         const std::vector< std::string_view >& m_nodeOrder = XLWorksheetNodeOrder;  // worksheet XML root node required child sequence
     };
 
@@ -0,0 +1,167 @@
+/*
+
+   ____                               ____      ___ ____       ____  ____      ___
+  6MMMMb                              `MM(      )M' `MM'      6MMMMb\`MM(      )M'
+ 8P    Y8                              `MM.     d'   MM      6M'    ` `MM.     d'
+6M      Mb __ ____     ____  ___  __    `MM.   d'    MM      MM        `MM.   d'
+MM      MM `M6MMMMb   6MMMMb `MM 6MMb    `MM. d'     MM      YM.        `MM. d'
+MM      MM  MM'  `Mb 6M'  `Mb MMM9 `Mb    `MMd       MM       YMMMMb     `MMd
+MM      MM  MM    MM MM    MM MM'   MM     dMM.      MM           `Mb     dMM.
+MM      MM  MM    MM MMMMMMMM MM    MM    d'`MM.     MM            MM    d'`MM.
+YM      M9  MM    MM MM       MM    MM   d'  `MM.    MM            MM   d'  `MM.
+ 8b    d8   MM.  ,M9 YM    d9 MM    MM  d'    `MM.   MM    / L    ,M9  d'    `MM.
+  YMMMM9    MMYMMM9   YMMMM9 _MM_  _MM_M(_    _)MM_ _MMMMMMM MYMMMM9 _M(_    _)MM_
+            MM
+            MM
+           _MM_
+
+  Copyright (c) 2018, Kenneth Troldal Balslev
+
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+  - Neither the name of the author nor the
+    names of any contributors may be used to endorse or promote products
+    derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#ifndef OPENXLSX_XLSHEETNODEINDEX_HPP
+#define OPENXLSX_XLSHEETNODEINDEX_HPP
+
+#ifdef _MSC_VER    // conditionally enable MSVC specific pragmas to avoid other compilers warning about unknown pragmas
+#   pragma warning(push)
+#   pragma warning(disable : 4251)
+#   pragma warning(disable : 4275)
+#endif // _MSC_VER
+
+// ===== External Includes ===== //
+#include <cstdint>          // uint16_t, uint32_t
+#include <unordered_map>    // std::unordered_map
+#include <vector>           // std::vector
+
+// ===== OpenXLSX Includes ===== //
+#include "OpenXLSX-Exports.hpp"
+#include "XLXmlParser.hpp"
+
+namespace OpenXLSX
+{
+    /**
+     * @brief An entry of XLSheetNodeIndex: a row number or column number and the XML node it refers to
+     */
+    struct XLNodeIndexEntry
+    {
+        uint32_t key;     /**< row number for row entries, column number for cell entries */
+        XMLNode  node;
+    };
+
+    /**
+     * @brief The XLSheetNodeIndex class provides O(log n) random access to the row and cell nodes of a worksheet.
+     * @details The row index is a sorted vector of row number -> row node, built on first access. For each row that is
+     *  accessed, a sorted vector of column number -> cell node is built on first access to that row. Nodes created through
+     *  the index are added to it. Nodes inserted by other means (e.g. iterators) are found by walking the siblings after
+     *  the closest indexed predecessor and added on the fly; if such a walk becomes long, the index is rebuilt.
+     * @note Indexed nodes must not be removed from sheetData behind the index's back: code that deletes row or cell
+     *  nodes (XLWorksheet::deleteRow, XLRowDataProxy) calls invalidate or invalidateRow. The index of a worksheet is owned
+     *  by its XLXmlData, so that all XLWorksheet objects of the same sheet see these invalidations.
+     */
+    class OPENXLSX_EXPORT XLSheetNodeIndex
+    {
+    public:
+        /**
+         * @brief Find the row node with the given row number
+         * @param sheetData the sheetData node of the worksheet
+         * @param rowNumber the row number, in the range [1;MAX_ROWS]
+         * @return the row node, or an empty node if the row does not exist
+         * @throws XLCellAddressError if rowNumber is out of range
+         */
+        XMLNode findRow(const XMLNode& sheetData, uint32_t rowNumber);
+
+        /**
+         * @brief Get the row node with the given row number, inserting it in order if it does not exist
+         * @param sheetData the sheetData node of the worksheet
+         * @param rowNumber the row number, in the range [1;MAX_ROWS]
+         * @return the row node
+         * @throws XLCellAddressError if rowNumber is out of range
+         */
+        XMLNode getRow(const XMLNode& sheetData, uint32_t rowNumber);
+
+        /**
+         * @brief Get the first row node with a row number >= rowNumber
+         * @param sheetData the sheetData node of the worksheet
+         * @param rowNumber the row number to start from
+         * @return the row node, or an empty node if all rows are before rowNumber
+         */
+        XMLNode lowerBoundRow(const XMLNode& sheetData, uint32_t rowNumber);
+
+        /**
+         * @brief Find the cell node in the given column of a row
+         * @param rowNode the row node, as returned by findRow or getRow - may be empty
+         * @param rowNumber the row number of rowNode
+         * @param columnNumber the column number, in the range [1;MAX_COLS]
+         * @return the cell node, or an empty node if rowNode is empty or the cell does not exist
+         * @throws XLException if columnNumber is out of range
+         */
+        XMLNode findCell(const XMLNode& rowNode, uint32_t rowNumber, uint16_t columnNumber);
+
+        /**
+         * @brief Get the cell node in the given column of a row, inserting it in order with default attributes if it does not exist
+         * @param rowNode the row node, as returned by getRow - may be empty
+         * @param rowNumber the row number of rowNode
+         * @param columnNumber the column number, in the range [1;MAX_COLS]
+         * @return the cell node, or an empty node if rowNode is empty
+         * @throws XLException if columnNumber is out of range
+         */
+        XMLNode getCell(const XMLNode& rowNode, uint32_t rowNumber, uint16_t columnNumber);
+
+        /**
+         * @brief Discard the index, e.g. after many rows were inserted by other means. It will be rebuilt on next access.
+         */
+        void invalidate();
+
+        /**
+         * @brief Discard the cell index of one row, e.g. after cell nodes were removed from it. The row node itself stays indexed.
+         * @param rowNumber the row number
+         */
+        void invalidateRow(uint32_t rowNumber);
+
+    private:
+        /**
+         * @brief (Re-)build the row index if it is not built yet or if sheetData changed
+         */
+        void indexRows(const XMLNode& sheetData);
+
+        /**
+         * @brief Get the cell index of a row, building it if needed
+         */
+        std::vector<XLNodeIndexEntry>& indexCells(const XMLNode& rowNode, uint32_t rowNumber);
+
+        XMLNode                       m_sheetData {};       /**< the sheetData node the index was built for */
+        bool                          m_rowsIndexed {false}; /**< false if m_rows needs to be rebuilt */
+        std::vector<XLNodeIndexEntry> m_rows {};            /**< row number -> row node, sorted by row number */
+        std::unordered_map<uint32_t, std::vector<XLNodeIndexEntry>> m_cells {}; /**< row number -> sorted column number -> cell node */
+    };
+}    // namespace OpenXLSX
+
+#ifdef _MSC_VER    // conditionally enable MSVC specific pragmas to avoid other compilers warning about unknown pragmas
+#   pragma warning(pop)
+#endif // _MSC_VER
+
+#endif    // OPENXLSX_XLSHEETNODEINDEX_HPP
@@ -2368,6 +2368,14 @@ namespace OpenXLSX
          */
         XLDiffCellFormats& diffCellFormats() const;
 
+        /**
+         * @brief Get the root (styleSheet) node of the styles part.
+         * @return The styleSheet node.
+         * @note Intended for read-only scans of existing entries. Unlike the getters of XLFill, XLBorder and XLLine, which
+         *       add missing nodes and attributes when they are read, walking the nodes leaves the styles part unmodified.
+         */
+        XMLNode rootNode() const;
+
         // ---------- Protected Member Functions ---------- //
     private:
         bool                                m_suppressWarnings; // if true, will suppress output of warnings where supported
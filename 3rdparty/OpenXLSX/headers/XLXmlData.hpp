@@ -53,8 +53,11 @@ YM      M9  MM    MM MM       MM    MM   d'  `MM.    MM            MM   d'  `MM.
 #endif // _MSC_VER
 
 // ===== External Includes ===== //
+#include <cstdint>
+#include <list>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 // ===== OpenXLSX Includes ===== //
 #include "OpenXLSX-Exports.hpp"
@@ -63,10 +66,21 @@ YM      M9  MM    MM MM       MM    MM   d'  `MM.    MM            MM   d'  `MM.
 
 namespace OpenXLSX
 {
+    class XLSheetNodeIndex;
+
     constexpr const char * XLXmlDefaultVersion = "1.0";
     constexpr const char * XLXmlDefaultEncoding = "UTF-8";
     constexpr const bool   XLXmlStandalone = true;
     constexpr const bool   XLXmlNotStandalone = false;
+
+    /**
+     * @brief The lifecycle state of an XML part managed by XLDocument
+     */
+    enum class XLXmlDataState : uint8_t {
+        Unparsed, /**< the part only exists in the archive and has never been accessed */
+        Parsed,   /**< the part has been parsed, and its content is unchanged since then (or since the last commit) */
+        Dirty     /**< the part has been modified, or replaced through setRawData */
+    };
     /**
      * @brief The XLXmlSavingDeclaration class encapsulates the properties of an XML saving declaration,
      * that can be used in calls to XLXmlData::getRawData to enforce specific settings
@@ -139,6 +153,34 @@ namespace OpenXLSX
          */
         bool valid() const { return m_xmlDoc != nullptr; }
 
+        /**
+         * @brief check whether the XML document has been parsed from the archive (or created in memory)
+         * @return true if the document is loaded; false if it has never been accessed and still only exists in the archive
+         * @note An XML file that was never loaded cannot have been modified, so it does not need to be written back on save.
+         */
+        bool isLoaded() const { return m_xmlDoc != nullptr && m_xmlDoc->document_element(); }
+
+        /**
+         * @brief get the lifecycle state of the XML part
+         * @return Unparsed if the part was never loaded, Dirty if it was modified, Parsed otherwise
+         * @note OpenXLSX modifies parts through pugixml node handles, which can be obtained through const access as well.
+         *  Unless the part was flagged by markDirty, a modification is therefore detected by comparing a fingerprint of
+         *  the document with a baseline: the one taken by markClean, or, for a part that was never written, the one of
+         *  its source in the archive, taken on the first call. This walks all nodes of the part, but only when saving.
+         */
+        XLXmlDataState state() const;
+
+        /**
+         * @brief flag the XML part as modified
+         * @note setRawData does this implicitly
+         */
+        void markDirty() { m_dirty = true; }
+
+        /**
+         * @brief flag the current content of the XML part as written to the archive, so that it is Parsed until modified again
+         */
+        void markClean();
+
         /**
          * @brief Copy constructor. The m_xmlDoc data member is a XMLDocument object, which is non-copyable. Hence,
          * the XLXmlData objects have a explicitly deleted copy constructor.
@@ -215,7 +257,7 @@ namespace OpenXLSX
         XLContentType getXmlType() const;
 
         /**
-         * @brief Access the underlying XMLDocument object.
+         * @brief Access the underlying XMLDocument object for modification.
          * @return A pointer to the XMLDocument object.
          */
         XMLDocument* getXmlDocument();
@@ -232,7 +274,23 @@ namespace OpenXLSX
          */
         bool empty() const;
 
+        /**
+         * @brief Get the row/cell node index of a worksheet part, shared by all XLWorksheet objects of that part
+         * @return the node index, created on first call
+         */
+        std::shared_ptr<XLSheetNodeIndex> nodeIndex();
+
     private:
+        /**
+         * @brief parse the XML data from the archive if this was not done yet
+         */
+        void load() const;
+
+        /**
+         * @brief compute a hash over the types, names, values and attributes of all nodes of a document, in document order
+         */
+        static uint64_t fingerprint(const XMLDocument& doc);
+
         // ===== PRIVATE MEMBER VARIABLES ===== //
 
         XLDocument*                          m_parentDoc {}; /**< A pointer to the parent XLDocument object. >*/
@@ -240,6 +298,71 @@ namespace OpenXLSX
         std::string                          m_xmlID {};     /**< The relationship ID of the XML data. >*/
         XLContentType                        m_xmlType {};   /**< The type represented by the XML data. >*/
         mutable std::unique_ptr<XMLDocument> m_xmlDoc;       /**< The underlying XMLDocument object. >*/
+        bool                                 m_dirty {};     /**< true if the XML data was replaced or flagged as modified >*/
+        mutable uint64_t                     m_fingerprint {}; /**< The fingerprint of the source in the archive, or of the content when last committed >*/
+        mutable bool                         m_hasFingerprint {}; /**< false until m_fingerprint was taken >*/
+        std::shared_ptr<XLSheetNodeIndex>    m_nodeIndex {}; /**< The node index of a worksheet part, see nodeIndex() >*/
+    };
+
+    /**
+     * @brief The XLXmlDataRegistry class holds the XLXmlData objects of an XLDocument. Parts are stored in a std::list,
+     * so that pointers handed out to XLXmlFile objects remain stable, and are indexed by their path in the zip archive
+     * for constant time lookup.
+     * @note Only the first part registered for a given path is found by path, in line with the former linear search.
+     */
+    class OPENXLSX_EXPORT XLXmlDataRegistry
+    {
+    public:
+        using iterator       = std::list<XLXmlData>::iterator;
+        using const_iterator = std::list<XLXmlData>::const_iterator;
+
+        /**
+         * @brief Construct a new XLXmlData in place and register it under its path
+         * @param args the XLXmlData constructor arguments
+         * @return a reference to the registered part, which remains valid until it is erased
+         */
+        template<class... Args>
+        XLXmlData& emplace(Args&&... args)
+        {
+            XLXmlData& part = m_parts.emplace_back(std::forward<Args>(args)...);
+            m_index.try_emplace(part.getXmlPath(), std::prev(m_parts.end()));
+            return part;
+        }
+
+        /**
+         * @brief Look up a part by its path in the zip archive
+         * @param path the path of the part, without leading slash
+         * @return a pointer to the part, or nullptr if no part is registered under path
+         */
+        XLXmlData* find(const std::string& path);
+        const XLXmlData* find(const std::string& path) const;
+
+        /**
+         * @brief test whether a part is registered under path
+         */
+        bool contains(const std::string& path) const { return m_index.find(path) != m_index.end(); }
+
+        /**
+         * @brief Remove the part registered under path
+         * @return true if a part was removed, false if path was not registered
+         */
+        bool erase(const std::string& path);
+
+        /**
+         * @brief Remove all parts
+         */
+        void clear();
+
+        size_t size() const { return m_parts.size(); }
+
+        iterator       begin() { return m_parts.begin(); }
+        iterator       end() { return m_parts.end(); }
+        const_iterator begin() const { return m_parts.begin(); }
+        const_iterator end() const { return m_parts.end(); }
+
+    private:
+        std::list<XLXmlData>                          m_parts {}; /**< the parts in registration order, with stable addresses >*/
+        std::unordered_map<std::string, iterator>     m_index {}; /**< path -> part >*/
     };
 }    // namespace OpenXLSX
 
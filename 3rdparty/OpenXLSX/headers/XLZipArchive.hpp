@@ -52,6 +52,14 @@ YM      M9  MM    MM MM       MM    MM   d'  `MM.    MM            MM   d'  `MM.
 #   pragma warning(disable : 4275)
 #endif // _MSC_VER
 
+// ===== External Includes ===== //
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
 // ===== OpenXLSX Includes ===== //
 #include "OpenXLSX-Exports.hpp"
 
@@ -124,6 +132,14 @@ namespace OpenXLSX
          */
         void open(const std::string& fileName);
 
+        /**
+         * @brief Open an archive held in memory, without any file system access.
+         * @param data Pointer to the first byte of the archive. The bytes are copied, so the buffer may be released afterwards.
+         * @param size The size of the archive in bytes.
+         * @note The archive has no file name; save() must be given a path.
+         */
+        void open(const void* data, size_t size);
+
         /**
          * @brief
          */
@@ -135,6 +151,12 @@ namespace OpenXLSX
          */
         void save(const std::string& path = "");
 
+        /**
+         * @brief Save the archive by passing its bytes, in order, to a callback, without any file system access.
+         * @param write The callback receiving the bytes. It may throw to abort the save.
+         */
+        void save(const std::function<void(const char*, size_t)>& write);
+
         /**
          * @brief
          * @param name
@@ -162,6 +184,40 @@ namespace OpenXLSX
          */
         bool hasEntry(const std::string& entryName) const;
 
+        /**
+         * @brief Get a zero-copy view of an entry's bytes.
+         * @details Available for entries that are stored uncompressed and unmodified in an archive read from a memory
+         * mapping or an in-memory buffer (typically media files). The view points into the archive and stays valid
+         * until the archive is closed or saved. Nothing is cached, so repeated calls do not grow memory usage.
+         * @param name The name of the entry.
+         * @return The entry bytes, or an empty view with a nullptr data() if no zero-copy view is available.
+         */
+        std::string_view getEntryView(const std::string& name) const;
+
+        /**
+         * @brief Open a reader that inflates an entry incrementally, without extracting or caching the whole entry.
+         * @param name The name of the entry.
+         * @return A callable that fills the given buffer with the next bytes of the entry and returns the number of bytes
+         * written (0 at the end of the entry), or an empty std::function if the entry does not exist.
+         * @note The archive must not be closed or saved while the reader is in use.
+         */
+        std::function<size_t(char*, size_t)> openEntryStream(const std::string& name) const;
+
+        /**
+         * @brief Get the names of all file entries (directories excluded) in the archive.
+         * @return A std::vector with the entry names, in archive order.
+         */
+        std::vector<std::string> entryNames() const;
+
+        /**
+         * @brief Set the compression level of the entries written by subsequent calls to save().
+         * @param levelFor A function returning the level (0 = store, 1 = fastest, 9 = best) for an entry name, or a
+         * negative value if no rule applies to it. An empty std::function restores the default behaviour.
+         * @note Unmodified entries without a rule are copied as they are and keep their original compression; unmodified
+         * entries with a rule are recompressed at that level.
+         */
+        void setCompressionLevel(std::function<int(const std::string&)> levelFor);
+
     private:
         std::shared_ptr<Zippy::ZipArchive> m_archive; /**< */
     };
@@ -0,0 +1,170 @@
+/*
+
+   ____                               ____      ___ ____       ____  ____      ___
+  6MMMMb                              `MM(      )M' `MM'      6MMMMb\`MM(      )M'
+ 8P    Y8                              `MM.     d'   MM      6M'    ` `MM.     d'
+6M      Mb __ ____     ____  ___  __    `MM.   d'    MM      MM        `MM.   d'
+MM      MM `M6MMMMb   6MMMMb `MM 6MMb    `MM. d'     MM      YM.        `MM. d'
+MM      MM  MM'  `Mb 6M'  `Mb MMM9 `Mb    `MMd       MM       YMMMMb     `MMd
+MM      MM  MM    MM MM    MM MM'   MM     dMM.      MM           `Mb     dMM.
+MM      MM  MM    MM MMMMMMMM MM    MM    d'`MM.     MM            MM    d'`MM.
+YM      M9  MM    MM MM       MM    MM   d'  `MM.    MM            MM   d'  `MM.
+ 8b    d8   MM.  ,M9 YM    d9 MM    MM  d'    `MM.   MM    / L    ,M9  d'    `MM.
+  YMMMM9    MMYMMM9   YMMMM9 _MM_  _MM_M(_    _)MM_ _MMMMMMM MYMMMM9 _M(_    _)MM_
+            MM
+            MM
+           _MM_
+
+  Copyright (c) 2018, Kenneth Troldal Balslev
+
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+  - Neither the name of the author nor the
+    names of any contributors may be used to endorse or promote products
+    derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+#ifndef OPENXLSX_XLZIPSTREAMWRITER_HPP
+#define OPENXLSX_XLZIPSTREAMWRITER_HPP
+
+#ifdef _MSC_VER    // conditionally enable MSVC specific pragmas to avoid other compilers warning about unknown pragmas
+#   pragma warning(push)
+#   pragma warning(disable : 4251)
+#   pragma warning(disable : 4275)
+#endif // _MSC_VER
+
+// ===== External Includes ===== //
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// ===== OpenXLSX Includes ===== //
+#include "OpenXLSX-Exports.hpp"
+
+namespace OpenXLSX
+{
+    /**
+     * @brief A forward-only zip writer that deflates entry data while it is being written.
+     * @details Entries are written one at a time: beginEntry(), any number of write() calls, then endEntry().
+     * Entry data is compressed on the fly and handed to the output immediately, so memory use does not depend on the
+     * size of the entries. CRC and sizes are stored in a data descriptor after each entry, and the central directory
+     * is written by close(). Entries and archives larger than 4 GiB (zip64) are not supported.
+     */
+    class OPENXLSX_EXPORT XLZipStreamWriter
+    {
+    public:
+        /**
+         * @brief Receives the bytes of the archive, in order.
+         */
+        using WriteCallback = std::function<void(const char* data, size_t size)>;
+
+        /**
+         * @brief Default deflate level used by beginEntry() and addEntry().
+         */
+        static constexpr int DefaultLevel = 6;
+
+        /**
+         * @brief Constructor. The writer must be opened before use.
+         */
+        XLZipStreamWriter();
+
+        /**
+         * @brief Destructor. An archive that has not been closed is abandoned, and its output is incomplete.
+         */
+        ~XLZipStreamWriter();
+
+        XLZipStreamWriter(const XLZipStreamWriter& other)            = delete;
+        XLZipStreamWriter& operator=(const XLZipStreamWriter& other) = delete;
+        XLZipStreamWriter(XLZipStreamWriter&& other) noexcept;
+        XLZipStreamWriter& operator=(XLZipStreamWriter&& other) noexcept;
+
+        /**
+         * @brief Start a new archive in the given file. An existing file is overwritten.
+         * @param fileName The path of the archive to create.
+         * @throws XLInputError if the file cannot be created.
+         */
+        void open(const std::string& fileName);
+
+        /**
+         * @brief Start a new archive whose bytes are passed to a callback.
+         * @param sink The callback receiving the archive bytes.
+         */
+        void open(WriteCallback sink);
+
+        /**
+         * @brief Check if an archive is being written.
+         * @return true between open() and close().
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Start a new entry. Any entry still open is ended first.
+         * @param name The name of the entry, e.g. "xl/worksheets/sheet1.xml".
+         * @param level The deflate level, 0 (no compression) to 10.
+         */
+        void beginEntry(const std::string& name, int level = DefaultLevel);
+
+        /**
+         * @brief Append data to the current entry.
+         * @param data Pointer to the data.
+         * @param size The size of the data in bytes.
+         * @throws XLInternalError if no entry has been started.
+         */
+        void write(const char* data, size_t size);
+
+        /**
+         * @brief Append data to the current entry.
+         * @param data The data to append.
+         */
+        void write(std::string_view data);
+
+        /**
+         * @brief Finish the current entry and write its data descriptor.
+         */
+        void endEntry();
+
+        /**
+         * @brief Write a complete entry in one call.
+         * @param name The name of the entry.
+         * @param data The entry data.
+         * @param level The deflate level, 0 (no compression) to 10.
+         */
+        void addEntry(const std::string& name, std::string_view data, int level = DefaultLevel);
+
+        /**
+         * @brief End the current entry (if any), write the central directory and close the output.
+         */
+        void close();
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl; /**< Deflate state, output and central directory records. */
+    };
+}    // namespace OpenXLSX
+
+#ifdef _MSC_VER    // conditionally enable MSVC specific pragmas to avoid other compilers warning about unknown pragmas
+#   pragma warning(pop)
+#endif // _MSC_VER
+
+#endif    // OPENXLSX_XLZIPSTREAMWRITER_HPP
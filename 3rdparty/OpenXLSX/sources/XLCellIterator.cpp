@@ -107,14 +107,14 @@ namespace OpenXLSX { // utility functions findRowNode and findCellNode
         XMLNode cellNode = rowNode.last_child_of_type(pugi::node_element);
 
         // ===== If there are no cells in the current row, or the requested cell is beyond the last cell in the row...
-        if (cellNode.empty() || (XLCellReference(cellNode.attribute("r").value()).column() < columnNumber))
+        if (cellNode.empty() || (columnNumberFromAddress(cellNode.attribute("r").value()) < columnNumber))
             return XMLNode{};
 
         // ===== If the requested node is closest to the end, start from the end and search backwards...
-        if (XLCellReference(cellNode.attribute("r").value()).column() - columnNumber < columnNumber) {
-            while (not cellNode.empty() && (XLCellReference(cellNode.attribute("r").value()).column() > columnNumber))
+        if (columnNumberFromAddress(cellNode.attribute("r").value()) - columnNumber < columnNumber) {
+            while (not cellNode.empty() && (columnNumberFromAddress(cellNode.attribute("r").value()) > columnNumber))
                 cellNode = cellNode.previous_sibling_of_type(pugi::node_element);
-            if (cellNode.empty() || (XLCellReference(cellNode.attribute("r").value()).column() < columnNumber))
+            if (cellNode.empty() || (columnNumberFromAddress(cellNode.attribute("r").value()) < columnNumber))
                 return XMLNode{};
         }
         // ===== Otherwise, start from the beginning
@@ -123,9 +123,9 @@ namespace OpenXLSX { // utility functions findRowNode and findCellNode
             cellNode = rowNode.first_child_of_type(pugi::node_element);
 
             // ===== It has been verified above that the requested columnNumber is <= the column number of the last node_element, therefore this loop will halt:
-            while (XLCellReference(cellNode.attribute("r").value()).column() < columnNumber)
+            while (columnNumberFromAddress(cellNode.attribute("r").value()) < columnNumber)
                 cellNode = cellNode.next_sibling_of_type(pugi::node_element);
-            if (XLCellReference(cellNode.attribute("r").value()).column() > columnNumber)
+            if (columnNumberFromAddress(cellNode.attribute("r").value()) > columnNumber)
                 return XMLNode{};
         }
         return cellNode;
@@ -265,7 +265,7 @@ void XLCellIterator::updateCurrentCell(bool createIfMissing)
             XMLNode cellNode = m_hintNode.next_sibling_of_type(pugi::node_element);
             uint16_t colNo = 0;
             while (not cellNode.empty()) {
-                colNo = XLCellReference(cellNode.attribute("r").value()).column();
+                colNo = columnNumberFromAddress(cellNode.attribute("r").value());
                 if(colNo >= m_currentColumn) break; // if desired cell was reached / passed, break before incrementing cellNode
                 cellNode = cellNode.next_sibling_of_type(pugi::node_element);
             }
@@ -417,10 +417,10 @@ void XLCellValueProxy::setString(const char* stringValue) // NOLINT
     // ===== Set the type attribute.
     m_cellNode->attribute("t").set_value("s");
 
-    // ===== Get or create the index in the XLSharedStrings object.
-    const auto index = (m_cell->m_sharedStrings.get().stringExists(stringValue)
-    /**/                                                    ?          m_cell->m_sharedStrings.get().getStringIndex(stringValue)
-    /**/                                                             : m_cell->m_sharedStrings.get().appendString(stringValue));
+    // ===== Get or create the index in the XLSharedStrings object (a single lookup: the string is converted only once).
+    const std::string str = stringValue;
+    int32_t           index = m_cell->m_sharedStrings.get().getStringIndex(str);
+    if (index < 0) index = m_cell->m_sharedStrings.get().appendString(str);
 
     // ===== Set the text of the value node.
     m_cellNode->child("v").text().set(index);
@@ -477,8 +477,8 @@ void XLDocument::open(const std::string& fileName)
 
     // ===== Add and open the Relationships and [Content_Types] files for the document level.
     std::string relsFilename = "_rels/.rels";
-    m_data.emplace_back(this, "[Content_Types].xml");
-    m_data.emplace_back(this, relsFilename);
+    m_data.emplace(this, "[Content_Types].xml");
+    m_data.emplace(this, relsFilename);
 
     m_contentTypes     = XLContentTypes(getXmlData("[Content_Types].xml"));
     m_docRelationships = XLRelationships(getXmlData(relsFilename), relsFilename);
@@ -488,7 +488,7 @@ void XLDocument::open(const std::string& fileName)
         if (item.type() == XLRelationshipType::Workbook) {
             workbookPath = item.target();
             if( workbookPath[ 0 ] == '/' ) workbookPath = workbookPath.substr(1); // NON STANDARD FORMATS: strip leading '/'
-            m_data.emplace_back(this, workbookPath, item.id(), XLContentType::Workbook);
+            m_data.emplace(this, workbookPath, item.id(), XLContentType::Workbook);
             workbookAdded = true;
     break;
         }
@@ -501,7 +501,7 @@ void XLDocument::open(const std::string& fileName)
         throw XLInputError(std::string("workbook path from "s + relsFilename + " has no folder name: "s) + workbookPath);
     }
     std::string workbookRelsFilename = std::string("xl/_rels/") + workbookPath.substr(pos + 1) + std::string(".rels");
-    m_data.emplace_back(this, workbookRelsFilename); // m_data.emplace_back(this, "xl/_rels/workbook.xml.rels");
+    m_data.emplace(this, workbookRelsFilename); // m_data.emplace(this, "xl/_rels/workbook.xml.rels");
     m_wbkRelationships = XLRelationships(getXmlData(workbookRelsFilename), workbookRelsFilename);
 
     // ===== Create xl/styles.xml if missing
@@ -536,7 +536,7 @@ void XLDocument::open(const std::string& fileName)
                    ||(item.path().substr(4)     == "styles.xml")
                    ||(item.path().substr(4, 11) == "theme/theme"))
             {
-                m_data.emplace_back(/* parentDoc */ this,
+                m_data.emplace(/* parentDoc */ this,
                                     /* xmlPath   */ item.path().substr(1),
                                     /* xmlID     */ m_wbkRelationships.relationshipByTarget(item.path().substr(4)).id(),
                                     /* xmlType   */ item.type());
@@ -552,7 +552,7 @@ void XLDocument::open(const std::string& fileName)
                 std::cerr << "adding missing workbook relationship to _rels/.rels" << std::endl;
                 m_docRelationships.addRelationship(XLRelationshipType::Workbook, workbookPath);    // Pull request #185: Fix missing workbook relationship
             }
-            m_data.emplace_back(/* parentDoc */ this,
+            m_data.emplace(/* parentDoc */ this,
                                 /* xmlPath   */ item.path().substr(1),
                                 /* xmlID     */ m_docRelationships.relationshipByTarget(item.path().substr(1)).id(),
                                 /* xmlType   */ item.type());
@@ -619,7 +619,7 @@ void XLDocument::open(const std::string& fileName)
     // ===== 2024-09-02: ensure that all worksheets are contained in app.xml <TitlesOfParts> and reflected in <HeadingPairs> value for Worksheets
     m_appProperties.alignWorksheets(m_workbook.sheetNames());
 
-    m_sharedStrings  = XLSharedStrings(getXmlData("xl/sharedStrings.xml"), &m_sharedStringCache);
+    m_sharedStrings  = XLSharedStrings(getXmlData("xl/sharedStrings.xml"), &m_sharedStringCache, &m_sharedStringIndex);
     m_styles         = XLStyles(getXmlData("xl/styles.xml"), m_suppressWarnings); // 2024-10-14: forward supress warnings setting to XLStyles
 }
 
@@ -713,6 +713,7 @@ void XLDocument::close()
 
     m_data.clear();
     m_sharedStringCache.clear();             // 2024-12-18 BUGFIX: clear shared strings cache - addresses issue #283
+    m_sharedStringIndex.clear();
     m_sharedStrings    = XLSharedStrings();  //
 
     m_docRelationships = XLRelationships();
@@ -744,30 +745,41 @@ void XLDocument::saveAs(const std::string& fileName, bool forceOverwrite)
     }
 
     m_filePath = fileName;
+    commit();
+    m_archive.save(m_filePath);
+}
+
+/**
+ * @details Legacy function to save the document with a new name
+ * @deprecated use instead void XLDocument::saveAs(const std::string& fileName, bool forceOverwrite)
+ * @warning This deprecated function overwrites an existing file without prompt
+ */
+void XLDocument::saveAs(const std::string& fileName) { saveAs( fileName, XLForceOverwrite ); }
 
+/**
+ * @details
+ */
+void XLDocument::commit()
+{
     // ===== Delete the calcChain.xml file in order to force re-calculation of the sheet
     // TODO: Is this the best way to do it? Maybe there is a flag that can be set, that forces re-calculalion.
     execCommand(XLCommand(XLCommandType::ResetCalcChain));
 
-    // ===== Add all xml items to archive and save the archive.
+    // ===== Add all modified xml items to the archive.
+    // ===== Items that were never loaded, or whose content is unchanged since they were parsed (or last committed), are left
+    // ===== alone: their compressed bytes are copied from the source archive as is, instead of being serialized and recompressed.
     for (auto& item : m_data) {
+        if (item.state() != XLXmlDataState::Dirty) continue;
         bool xmlIsStandalone = m_xmlSavingDeclaration.standalone_as_bool();
         if ((item.getXmlPath() == "docProps/core.xml")
           ||(item.getXmlPath() == "docProps/app.xml"))
             xmlIsStandalone = XLXmlStandalone;
         m_archive.addEntry(item.getXmlPath(),
             item.getRawData(XLXmlSavingDeclaration(m_xmlSavingDeclaration.version(), m_xmlSavingDeclaration.encoding(),xmlIsStandalone)));
+        item.markClean();    // after getRawData, which may have added the saving declaration
     }
-    m_archive.save(m_filePath);
 }
 
-/**
- * @details Legacy function to save the document with a new name
- * @deprecated use instead void XLDocument::saveAs(const std::string& fileName, bool forceOverwrite)
- * @warning This deprecated function overwrites an existing file without prompt
- */
-void XLDocument::saveAs(const std::string& fileName) { saveAs( fileName, XLForceOverwrite ); }
-
 /**
  * @details
  */
@@ -1079,7 +1091,7 @@ XLRelationships XLDocument::sheetRelationships(uint16_t sheetXmlNo)
     constexpr const bool DO_NOT_THROW = true;
     XLXmlData *xmlData = getXmlData(relsFilename, DO_NOT_THROW);
     if (xmlData == nullptr) // if not yet managed: add the sheet relationships file to the managed files
-        xmlData = &m_data.emplace_back(this, relsFilename, "", XLContentType::Relationships);
+        xmlData = &m_data.emplace(this, relsFilename, "", XLContentType::Relationships);
 
     return XLRelationships(xmlData, relsFilename);
 }
@@ -1100,7 +1112,7 @@ XLVmlDrawing XLDocument::sheetVmlDrawing(uint16_t sheetXmlNo)
     constexpr const bool DO_NOT_THROW = true;
     XLXmlData *xmlData = getXmlData(vmlDrawingFilename, DO_NOT_THROW);
     if (xmlData == nullptr) // if not yet managed: add the sheet drawing file to the managed files
-        xmlData = &m_data.emplace_back(this, vmlDrawingFilename, "", XLContentType::VMLDrawing);
+        xmlData = &m_data.emplace(this, vmlDrawingFilename, "", XLContentType::VMLDrawing);
 
     return XLVmlDrawing(xmlData);
 }
@@ -1121,7 +1133,7 @@ XLComments XLDocument::sheetComments(uint16_t sheetXmlNo)
     constexpr const bool DO_NOT_THROW = true;
     XLXmlData *xmlData = getXmlData(commentsFilename, DO_NOT_THROW);
     if (xmlData == nullptr) // if not yet managed: add the sheet comments file to the managed files
-        xmlData = &m_data.emplace_back(this, commentsFilename, "", XLContentType::Comments);
+        xmlData = &m_data.emplace(this, commentsFilename, "", XLContentType::Comments);
 
     return XLComments(xmlData);
 }
@@ -1142,7 +1154,7 @@ XLTables XLDocument::sheetTables(uint16_t sheetXmlNo)
     constexpr const bool DO_NOT_THROW = true;
     XLXmlData *xmlData = getXmlData(tablesFilename, DO_NOT_THROW);
     if (xmlData == nullptr) // if not yet managed: add the sheet tables file to the managed files
-        xmlData = &m_data.emplace_back(this, tablesFilename, "", XLContentType::Table);
+        xmlData = &m_data.emplace(this, tablesFilename, "", XLContentType::Table);
 
     return XLTables(xmlData);
 }
@@ -1233,10 +1245,7 @@ bool XLDocument::execCommand(const XLCommand& command)
 
         case XLCommandType::ResetCalcChain: {
             m_archive.deleteEntry("xl/calcChain.xml");
-            const auto item =
-                std::find_if(m_data.begin(), m_data.end(), [&](const XLXmlData& theItem) { return theItem.getXmlPath() == "xl/calcChain.xml"; });
-
-            if (item != m_data.end()) m_data.erase(item);
+            m_data.erase("xl/calcChain.xml");
         } break;
         case XLCommandType::CheckAndFixCoreProperties: {    // does nothing if core properties are in good shape
             // ===== If _rels/.rels has no entry for docProps/core.xml
@@ -1251,7 +1260,7 @@ bool XLDocument::execCommand(const XLCommand& command)
             // ===== If [Content Types].xml has no relationship for docProps/core.xml
             if (!hasXmlData("docProps/core.xml")) {
                 m_contentTypes.addOverride("/docProps/core.xml", XLContentType::CoreProperties);    // add content types entry
-                m_data.emplace_back(                                                                // store new entry in m_data
+                m_data.emplace(                                                                     // store new entry in m_data
                     /* parentDoc */ this,
                     /* xmlPath   */ "docProps/core.xml",
                     /* xmlID     */ m_docRelationships.relationshipByTarget("docProps/core.xml").id(),
@@ -1271,7 +1280,7 @@ bool XLDocument::execCommand(const XLCommand& command)
             // ===== If [Content Types].xml has no relationship for docProps/app.xml
             if (!hasXmlData("docProps/app.xml")) {
                 m_contentTypes.addOverride("/docProps/app.xml", XLContentType::ExtendedProperties);    // add content types entry
-                m_data.emplace_back(                                                                   // store new entry in m_data
+                m_data.emplace(                                                                        // store new entry in m_data
                     /* parentDoc */ this,
                     /* xmlPath   */ "docProps/app.xml",
                     /* xmlID     */ m_docRelationships.relationshipByTarget("docProps/app.xml").id(),
@@ -1305,7 +1314,7 @@ bool XLDocument::execCommand(const XLCommand& command)
             m_wbkRelationships.addRelationship(XLRelationshipType::Worksheet, command.getParam<std::string>("sheetPath").substr(4));
             m_appProperties.appendSheetName(command.getParam<std::string>("sheetName"));
             m_archive.addEntry(command.getParam<std::string>("sheetPath").substr(1), emptyWorksheet);
-            m_data.emplace_back(
+            m_data.emplace(
                 /* parentDoc */ this,
                 /* xmlPath   */ command.getParam<std::string>("sheetPath").substr(1),
                 /* xmlID     */ m_wbkRelationships.relationshipByTarget(command.getParam<std::string>("sheetPath").substr(4)).id(),
@@ -1321,9 +1330,7 @@ bool XLDocument::execCommand(const XLCommand& command)
             m_archive.deleteEntry(sheetPath.substr(1));
             m_contentTypes.deleteOverride(sheetPath);
             m_wbkRelationships.deleteRelationship(command.getParam<std::string>("sheetID"));
-            m_data.erase(std::find_if(m_data.begin(), m_data.end(), [&](const XLXmlData& item) {
-                return item.getXmlPath() == sheetPath.substr(1);
-            }));
+            m_data.erase(sheetPath.substr(1));
         } break;
         case XLCommandType::CloneSheet: {
             validateSheetName(command.getParam<std::string>("cloneName"), THROW_ON_INVALID);
@@ -1341,10 +1348,8 @@ bool XLDocument::execCommand(const XLCommand& command)
                 m_wbkRelationships.addRelationship(XLRelationshipType::Worksheet, sheetPath.substr(4));
                 m_appProperties.appendSheetName(command.getParam<std::string>("cloneName"));
                 m_archive.addEntry(sheetPath.substr(1),
-                                   std::find_if(m_data.begin(), m_data.end(), [&](const XLXmlData& data) {
-                                       return data.getXmlPath().substr(3) == sheetToClonePath; // 2024-12-15: ensure relative sheet path
-                                   })->getRawData());
-                m_data.emplace_back(
+                                   getXmlData("xl/" + sheetToClonePath)->getRawData()); // 2024-12-15: ensure relative sheet path
+                m_data.emplace(
                     /* parentDoc */ this,
                     /* xmlPath   */ sheetPath.substr(1),
                     /* xmlID     */ m_wbkRelationships.relationshipByTarget(sheetPath.substr(4)).id(),
@@ -1355,10 +1360,8 @@ bool XLDocument::execCommand(const XLCommand& command)
                 m_wbkRelationships.addRelationship(XLRelationshipType::Chartsheet, sheetPath.substr(4));
                 m_appProperties.appendSheetName(command.getParam<std::string>("cloneName"));
                 m_archive.addEntry(sheetPath.substr(1),
-                                   std::find_if(m_data.begin(), m_data.end(), [&](const XLXmlData& data) {
-                                       return data.getXmlPath().substr(3) == sheetToClonePath; // 2024-12-15: ensure relative sheet path
-                                   })->getRawData());
-                m_data.emplace_back(
+                                   getXmlData("xl/" + sheetToClonePath)->getRawData()); // 2024-12-15: ensure relative sheet path
+                m_data.emplace(
                     /* parentDoc */ this,
                     /* xmlPath   */ sheetPath.substr(1),
                     /* xmlID     */ m_wbkRelationships.relationshipByTarget(sheetPath.substr(4)).id(),
@@ -1430,12 +1433,10 @@ XLQuery XLDocument::execQuery(const XLQuery& query) const
             return XLQuery(query).setResult(m_sharedStrings);
 
         case XLQueryType::QueryXmlData: {
-            const auto result = std::find_if(m_data.begin(), m_data.end(), [&](const XLXmlData& item) {
-                return item.getXmlPath() == query.getParam<std::string>("xmlPath");
-            });
-            if (result == m_data.end())
+            XLXmlData* result = m_data.find(query.getParam<std::string>("xmlPath"));
+            if (result == nullptr)
                 throw XLInternalError("Path does not exist in zip archive (" + query.getParam<std::string>("xmlPath") + ")");
-            return XLQuery(query).setResult(&*result);
+            return XLQuery(query).setResult(result);
         }
         default:
             throw XLInternalError("XLDocument::execQuery: unknown query type " + std::to_string(static_cast<uint8_t>(query.type())));
@@ -1506,6 +1507,7 @@ void XLDocument::cleanupSharedStrings()
         newStringCache.end(),
         std::back_inserter(m_sharedStringCache)
     );
+    m_sharedStrings.rebuildIndex();    // the index keys pointed into the strings that were moved out of the cache
     if (static_cast<int32_t>(newStringCache.size()) != m_sharedStrings.rewriteXmlFromCache())
         throw XLInternalError("XLDocument::cleanupSharedStrings: failed to rewrite shared string table - document would be corrupted");
 }
@@ -1536,12 +1538,10 @@ XLXmlData* XLDocument::getXmlData(const std::string& path, bool doNotThrow)
  */
 const XLXmlData* XLDocument::getXmlData(const std::string& path, bool doNotThrow) const
 {
-    std::list<XLXmlData>::iterator result = std::find_if(m_data.begin(), m_data.end(), [&](const XLXmlData& item) { return item.getXmlPath() == path; });
-    if (result == m_data.end()) {
-        if (doNotThrow) return nullptr; // use with caution
-        else throw XLInternalError("Path " + path + " does not exist in zip archive.");
-    }
-    return &*result;
+    const XLXmlData* result = m_data.find(path);
+    if (result == nullptr && not doNotThrow) // with doNotThrow, nullptr is returned - use with caution
+        throw XLInternalError("Path " + path + " does not exist in zip archive.");
+    return result;
 }
 
 /**
@@ -1549,7 +1549,7 @@ const XLXmlData* XLDocument::getXmlData(const std::string& path, bool doNotThrow
  */
 bool XLDocument::hasXmlData(const std::string& path) const
 {
-    return std::find_if(m_data.begin(), m_data.end(), [&](const XLXmlData& item) { return item.getXmlPath() == path; }) != m_data.end();
+    return m_data.contains(path);
 }
 
 
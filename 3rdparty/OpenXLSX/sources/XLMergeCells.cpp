@@ -46,16 +46,107 @@ YM      M9  MM    MM MM       MM    MM   d'  `MM.    MM            MM   d'  `MM.
 // ===== External Includes ===== //
 #include <algorithm>
 #include <iostream>
+#include <iterator>    // std::prev
 #include <pugixml.hpp>
 
 // ===== OpenXLSX Includes ===== //
 #include "XLMergeCells.hpp"
 #include "XLCellReference.hpp"
+#include "XLConstants.hpp" // MAX_ROWS
 #include "XLException.hpp"
 #include "utilities/XLUtilities.hpp" // appendAndGetNode
 
 using namespace OpenXLSX;
 
+namespace { // anonymous namespace: do not export any symbols from here
+    /**
+     * @brief Parse a merge range reference into its rectangle
+     * @param reference the range reference, e.g. A1:B5
+     * @param caller the function name to use in the exception message
+     * @return the rectangle spanned by reference, with index set to XLMergeNotFound
+     * @throws XLInputError if reference is not a valid range of at least two cells
+     */
+    XLMergeRect parseMergeReference(const std::string& reference, const char* caller)
+    {
+        using namespace std::literals::string_literals;
+
+        size_t pos = reference.find_first_of(':'); // find split mark between top left and bottom right cell
+        if (pos < 2 || pos + 2 >= reference.length()) // range reference must have at least 2 characters before and after the colon
+            throw XLInputError("XLMergeCells::"s + caller + ": not a valid range reference: \""s + reference + "\""s);
+        XLCellReference refTL(reference.substr(0, pos));  // get top left cell reference
+        XLCellReference refBR(reference.substr(pos + 1)); // get bottom right cell reference
+
+        XLMergeRect rect{ refTL.row(), refTL.column(), refBR.row(), refBR.column(), XLMergeNotFound };
+        if (rect.bottomRow < rect.topRow || rect.lastCol < rect.firstCol || (rect.bottomRow == rect.topRow && rect.lastCol == rect.firstCol))
+            throw XLInputError("XLMergeCells::"s + caller + ": not a valid range reference: \""s + reference + "\""s);
+        return rect;
+    }
+
+    /**
+     * @brief Get the center row of the interval tree node that stores a merge spanning topRow to bottomRow
+     * @details Descends the implicit binary subdivision of [1;MAX_ROWS] until the center row of a node lies within the merge
+     */
+    uint32_t mergeNodeRow(uint32_t topRow, uint32_t bottomRow)
+    {
+        uint32_t lo = 1;
+        uint32_t hi = MAX_ROWS;
+        while (true) {
+            const uint32_t mid = lo + (hi - lo) / 2;
+            if (bottomRow < mid)   hi = mid - 1;
+            else if (topRow > mid) lo = mid + 1;
+            else                   return mid;
+        }
+    }
+
+    /**
+     * @brief Call visit(centerRow) for each interval tree node on the path from the root to row, until visit returns false
+     * @details Only these nodes can store a merge that contains row - at most log2(MAX_ROWS) + 1 of them
+     */
+    template<typename Visitor>
+    void visitNodesOnPath(uint32_t row, Visitor&& visit)
+    {
+        uint32_t lo = 1;
+        uint32_t hi = MAX_ROWS;
+        while (lo <= hi) {
+            const uint32_t mid = lo + (hi - lo) / 2;
+            if (not visit(mid) || row == mid) return;
+            if (row < mid) hi = mid - 1;
+            else           lo = mid + 1;
+        }
+    }
+
+    /**
+     * @brief Get the first merge of a node that may contain column col, or merges.end() if there is none
+     * @details The merges of a node do not overlap in columns: only the last one starting at or before col can contain it
+     */
+    std::vector<XLMergeRect>::const_iterator firstMergeFromColumn(const std::vector<XLMergeRect>& merges, uint16_t col)
+    {
+        auto iter = std::upper_bound(merges.begin(), merges.end(), col, [](uint16_t c, const XLMergeRect& rect) { return c < rect.firstCol; });
+        return iter == merges.begin() ? iter : std::prev(iter);
+    }
+
+    /**
+     * @brief Add rect to the node of index that spans its rows, keeping the node sorted by firstCol
+     */
+    void indexMerge(XLMergeRowIndex& index, const XLMergeRect& rect)
+    {
+        std::vector<XLMergeRect>& merges = index[mergeNodeRow(rect.topRow, rect.bottomRow)];
+        merges.insert(std::upper_bound(merges.begin(), merges.end(), rect,
+                                       [](const XLMergeRect& lhs, const XLMergeRect& rhs) { return lhs.firstCol < rhs.firstCol; }),
+                      rect);
+    }
+
+    /**
+     * @brief Test if rect overlaps with the cell window defined by topRow, firstCol, bottomRow, lastCol
+     * @return true in case of overlap, false if no overlap
+     */
+    bool XLMergeOverlaps(const XLMergeRect& rect, uint32_t topRow, uint16_t firstCol, uint32_t bottomRow, uint16_t lastCol)
+    {
+        return rect.topRow <= bottomRow && rect.bottomRow >= topRow        // vertical overlap
+            && rect.firstCol <= lastCol && rect.lastCol >= firstCol;       // horizontal overlap
+    }
+} // anonymous namespace
+
 /**
  * @details Constructs an uninitialized XLMergeCells object
  */
@@ -83,6 +174,12 @@ XLMergeCells::XLMergeCells(const XMLNode& rootNode, std::vector< std::string_vie
         if (std::string(mergeNode.name()) == "mergeCell") {
             std::string ref = mergeNode.attribute("ref").value();
             if (ref.length() > 0) {
+                try {
+                    XLMergeRect rect = parseMergeReference(ref, __func__);
+                    rect.index = static_cast<XLMergeIndex>(m_referenceCache.size());
+                    indexMerge(m_mergeIndex, rect);
+                }
+                catch (const XLException&) {} // an unparsable reference is kept as is, but can not be found by cell
                 m_referenceCache.emplace_back(ref);
                 invalidNode = false;
             }
@@ -130,6 +227,7 @@ XLMergeCells::XLMergeCells(const XLMergeCells& other)
     m_nodeOrder = other.m_nodeOrder;
     m_mergeCellsNode = other.m_mergeCellsNode ? std::make_unique<XMLNode>( *other.m_mergeCellsNode ) : std::unique_ptr<XMLNode> {};
     m_referenceCache = other.m_referenceCache;
+    m_mergeIndex = other.m_mergeIndex;
 }
 
 /**
@@ -141,6 +239,7 @@ XLMergeCells::XLMergeCells(XLMergeCells&& other)
     m_nodeOrder = std::move( other.m_nodeOrder );
     m_mergeCellsNode = std::move( other.m_mergeCellsNode );
     m_referenceCache = std::move( other.m_referenceCache );
+    m_mergeIndex = std::move( other.m_mergeIndex );
 }
 
 /**
@@ -152,6 +251,7 @@ XLMergeCells& XLMergeCells::operator=(const XLMergeCells& other)
     m_nodeOrder = other.m_nodeOrder;
     m_mergeCellsNode = other.m_mergeCellsNode ? std::make_unique<XMLNode>( *other.m_mergeCellsNode ) : std::unique_ptr<XMLNode> {};
     m_referenceCache = other.m_referenceCache;
+    m_mergeIndex = other.m_mergeIndex;
     return *this;
 }
 
@@ -164,6 +264,7 @@ XLMergeCells& XLMergeCells::operator=(XLMergeCells&& other)
     m_nodeOrder = std::move( other.m_nodeOrder );
     m_mergeCellsNode = std::move( other.m_mergeCellsNode );
     m_referenceCache = std::move( other.m_referenceCache );
+    m_mergeIndex = std::move( other.m_mergeIndex );
     return *this;
 }
 
@@ -173,40 +274,6 @@ XLMergeCells& XLMergeCells::operator=(XLMergeCells&& other)
 bool XLMergeCells::valid() const { return ( m_rootNode != nullptr && not m_rootNode->empty() ); }
 
 
-namespace { // anonymous namespace: do not export any symbols from here
-    /**
-     * @brief Test if (range) reference overlaps with the cell window defined by topRow, firstCol, bottomRow, lastCol
-     * @return true in case of overlap, false if no overlap
-     */
-    bool XLReferenceOverlaps(std::string reference, uint32_t topRow, uint16_t firstCol, uint32_t bottomRow, uint16_t lastCol)
-    {
-        using namespace std::literals::string_literals;
-
-        size_t pos = reference.find_first_of(':'); // find split mark between top left and bottom right cell
-        if (pos < 2 || pos + 2 >= reference.length()) // range reference must have at least 2 characters before and after the colon
-            throw XLInputError("XLMergeCells::"s + __func__ + ": not a valid range reference: \""s + reference + "\""s);
-        XLCellReference refTL(reference.substr(0, pos));  // get top left cell reference
-        XLCellReference refBR(reference.substr(pos + 1)); // get bottom right cell reference
-
-        uint32_t refTopRow    = refTL.row();
-        uint16_t refFirstCol  = refTL.column();
-        uint32_t refBottomRow = refBR.row();
-        uint16_t refLastCol   = refBR.column();
-        if (refBottomRow < refTopRow || refLastCol < refFirstCol || (refBottomRow == refTopRow && refLastCol == refFirstCol))
-            throw XLInputError("XLMergeCells::"s + __func__ + ": not a valid range reference: \""s + reference + "\""s);
-
-// std::cout << __func__ << ":" << " reference is " << reference
-//    << " refTopRow is " << refTopRow << " refBottomRow is " << refBottomRow << " refFirstCol is " << refFirstCol << " refLastCol is " << refLastCol
-//    << " topRow is " << topRow << " bottomRow is " << bottomRow << " firstCol is " << firstCol << " lastCol is " << lastCol
-//    << std::endl;
-
-        // overlap
-        if (refTopRow <= bottomRow && refBottomRow >= topRow        // vertical overlap
-            && refFirstCol <= lastCol && refLastCol >= firstCol)    // horizontal overlap
-            return true;
-        return false; // otherwise: no overlap
-    }
-} // anonymous namespace
 
 /**
  * @details Look up a merge index by the reference. If the reference does not exist, the returned index is XLMergeNotFound (-1).
@@ -225,16 +292,25 @@ bool XLMergeCells::mergeExists(const std::string& reference) const { return find
 
 /**
  * @details Find the index of the merge of which cellRef is a part. If no such merge exists, the returned index is XLMergeNotFound (-1).
+ *          Only the interval tree nodes on the path to the row of cellRef can store a merge containing it, and each of them has at
+ *          most one candidate for the column: O(log n) for any merge sizes.
  */
 XLMergeIndex XLMergeCells::findMergeByCell(const std::string& cellRef) const { return findMergeByCell(XLCellReference(cellRef)); }
 XLMergeIndex XLMergeCells::findMergeByCell(XLCellReference cellRef) const
 {
-    const auto iter = std::find_if(m_referenceCache.begin(), m_referenceCache.end(),
-    /**/                           [&](const std::string& ref) { // use XLReferenceOverlaps with a "range" that only contains cellRef
-    /**/                               return XLReferenceOverlaps( ref, cellRef.row(), cellRef.column(), cellRef.row(), cellRef.column());
-    /**/                           });
-
-    return iter == m_referenceCache.end() ? XLMergeNotFound : static_cast<XLMergeIndex>(std::distance(m_referenceCache.begin(), iter));
+    const uint32_t row   = cellRef.row();
+    const uint16_t col   = cellRef.column();
+    XLMergeIndex   found = XLMergeNotFound;
+    if (m_mergeIndex.empty()) return found;
+
+    visitNodesOnPath(row, [&](uint32_t center) {
+        const auto node = m_mergeIndex.find(center);
+        if (node == m_mergeIndex.end()) return true;
+        const auto candidate = firstMergeFromColumn(node->second, col);
+        if (candidate != node->second.end() && XLMergeOverlaps(*candidate, row, col, row, col)) found = candidate->index;
+        return found == XLMergeNotFound;
+    });
+    return found;
 }
 
 /**
@@ -267,23 +343,26 @@ XLMergeIndex XLMergeCells::appendMerge(const std::string& reference)
     if (referenceCacheSize >= XLMaxMergeCells)
         throw XLInputError("XLMergeCells::"s + __func__ + ": exceeded max merge cells count "s + std::to_string(XLMaxMergeCells));
 
-    size_t pos = reference.find_first_of(':'); // find split mark between top left and bottom right cell
-    if (pos < 2 || pos + 2 >= reference.length()) // range reference must have at least 2 characters before and after the colon
-        throw XLInputError("XLMergeCells::"s + __func__ + ": not a valid range reference: \""s + reference + "\""s);
-    XLCellReference refTL(reference.substr(0, pos));  // get top left cell reference
-    XLCellReference refBR(reference.substr(pos + 1)); // get bottom right cell reference
-
-    uint32_t refTopRow    = refTL.row();
-    uint16_t refFirstCol  = refTL.column();
-    uint32_t refBottomRow = refBR.row();
-    uint16_t refLastCol   = refBR.column();
-    if (refBottomRow < refTopRow || refLastCol < refFirstCol || (refBottomRow == refTopRow && refLastCol == refFirstCol))
-        throw XLInputError("XLMergeCells::"s + __func__ + ": not a valid range reference: \""s + reference + "\""s);
-
-    for (std::string ref : m_referenceCache) {
-        if (XLReferenceOverlaps(ref, refTopRow, refFirstCol, refBottomRow, refLastCol))
-            throw XLInputError("XLMergeCells::"s + __func__ + ": reference \""s + reference
-            /**/                   + "\" overlaps with existing reference \""s + ref + "\""s);
+    XLMergeRect rect = parseMergeReference(reference, __func__);
+
+    // ===== A merge overlapping reference is stored at a node whose center row lies within reference, or it contains the top
+    //       or the bottom row of reference, in which case it is stored at a node on the path to that row
+    const auto checkOverlaps = [&](const std::vector<XLMergeRect>& merges) {
+        for (auto iter = firstMergeFromColumn(merges, rect.firstCol); iter != merges.end() && iter->firstCol <= rect.lastCol; ++iter) {
+            if (XLMergeOverlaps(*iter, rect.topRow, rect.firstCol, rect.bottomRow, rect.lastCol))
+                throw XLInputError("XLMergeCells::"s + __func__ + ": reference \""s + reference
+                /**/                   + "\" overlaps with existing reference \""s + m_referenceCache[iter->index] + "\""s);
+        }
+    };
+    for (auto node = m_mergeIndex.lower_bound(rect.topRow); node != m_mergeIndex.end() && node->first <= rect.bottomRow; ++node)
+        checkOverlaps(node->second);
+    for (const uint32_t row : { rect.topRow, rect.bottomRow }) {
+        visitNodesOnPath(row, [&](uint32_t center) {
+            if (center >= rect.topRow && center <= rect.bottomRow) return true; // checked above
+            const auto node = m_mergeIndex.find(center);
+            if (node != m_mergeIndex.end()) checkOverlaps(node->second);
+            return true;
+        });
     }
     // if execution gets here: no overlaps
 
@@ -301,6 +380,9 @@ XLMergeIndex XLMergeCells::appendMerge(const std::string& reference)
 
     m_referenceCache.emplace_back(newMerge.attribute("ref").value()); // index of this element = previous referenceCacheSize
 
+    rect.index = static_cast<XLMergeIndex>(referenceCacheSize);
+    indexMerge(m_mergeIndex, rect);
+
     // ===== Update the array count attribute
     XMLAttribute attr = m_mergeCellsNode->attribute("count");
     if (attr.empty()) attr = m_mergeCellsNode->append_attribute("count");
@@ -332,6 +414,21 @@ void XLMergeCells::deleteMerge(XLMergeIndex index)
     while (node.previous_sibling().type() == pugi::node_pcdata) m_mergeCellsNode->remove_child(node.previous_sibling());
     m_mergeCellsNode->remove_child(node);
 
+    // ===== Remove the merge from the index (an unparsable reference is not indexed) and shift the indexes of subsequent merges
+    try {
+        const XLMergeRect rect = parseMergeReference(m_referenceCache[curIndex], __func__);
+        const auto node = m_mergeIndex.find(mergeNodeRow(rect.topRow, rect.bottomRow));
+        if (node != m_mergeIndex.end()) {
+            auto& merges = node->second;
+            merges.erase(std::remove_if(merges.begin(), merges.end(), [&](const XLMergeRect& other) { return other.index == curIndex; }), merges.end());
+            if (merges.empty()) m_mergeIndex.erase(node);
+        }
+    }
+    catch (const XLException&) {}
+    for (auto& node : m_mergeIndex)
+        for (XLMergeRect& rect : node.second)
+            if (rect.index > curIndex) --rect.index;
+
     m_referenceCache.erase(m_referenceCache.begin() + curIndex);
 
     if (m_referenceCache.size() > 0) {
@@ -347,6 +444,7 @@ void XLMergeCells::deleteMerge(XLMergeIndex index)
 void XLMergeCells::deleteAll()
 {
     m_referenceCache.clear();
+    m_mergeIndex.clear();
     m_rootNode->remove_child(*m_mergeCellsNode);
     m_mergeCellsNode = std::make_unique<XMLNode>(XMLNode());
 }
@@ -75,9 +75,10 @@ namespace OpenXLSX
      * @pre
      * @post
      */
-    XLRow::XLRow(const XMLNode& rowNode, const XLSharedStrings& sharedStrings)
+    XLRow::XLRow(const XMLNode& rowNode, const XLSharedStrings& sharedStrings, XLSheetNodeIndex* nodeIndex)
         : m_rowNode(std::make_unique<XMLNode>(rowNode)),
           m_sharedStrings(sharedStrings),
+          m_nodeIndex(nodeIndex),
           m_rowDataProxy(this, m_rowNode.get())
     {}
 
@@ -89,6 +90,7 @@ namespace OpenXLSX
     XLRow::XLRow(const XLRow& other)
         : m_rowNode(other.m_rowNode ? std::make_unique<XMLNode>(*other.m_rowNode) : nullptr),
           m_sharedStrings(other.m_sharedStrings),
+          m_nodeIndex(other.m_nodeIndex),
           m_rowDataProxy(this, m_rowNode.get())
     {}
 
@@ -101,6 +103,7 @@ namespace OpenXLSX
     XLRow::XLRow(XLRow&& other) noexcept
         : m_rowNode(std::move(other.m_rowNode)),
           m_sharedStrings(std::move(other.m_sharedStrings)),
+          m_nodeIndex(other.m_nodeIndex),
           m_rowDataProxy(this, m_rowNode.get())
     {}
 
@@ -136,6 +139,7 @@ namespace OpenXLSX
         if (&other != this) {
             m_rowNode       = std::move(other.m_rowNode);
             m_sharedStrings = std::move(other.m_sharedStrings);
+            m_nodeIndex     = other.m_nodeIndex;
             m_rowDataProxy  = XLRowDataProxy(this, m_rowNode.get());
         }
         return *this;
@@ -390,6 +394,7 @@ namespace OpenXLSX
           m_lastRow(rowRange.m_lastRow),
           m_currentRow(),
           m_sharedStrings(rowRange.m_sharedStrings),
+          m_nodeIndex(rowRange.m_nodeIndex),
           m_endReached(false),
           m_hintRow(),
           m_hintRowNumber(0),
@@ -421,6 +426,7 @@ namespace OpenXLSX
           m_lastRow(other.m_lastRow),
           m_currentRow(other.m_currentRow),
           m_sharedStrings(other.m_sharedStrings),
+          m_nodeIndex(other.m_nodeIndex),
           m_endReached(other.m_endReached),
           m_hintRow(other.m_hintRow),
           m_hintRowNumber(other.m_hintRowNumber),
@@ -475,9 +481,9 @@ namespace OpenXLSX
 
         if (m_hintRow.empty()) {  // no hint has been established: fetch first row node the "tedious" way
             if (createIfMissing)     // getRowNode creates missing rows
-                m_currentRow = XLRow(getRowNode(*m_dataNode, m_currentRowNumber), m_sharedStrings.get());
+                m_currentRow = XLRow(getRowNode(*m_dataNode, m_currentRowNumber), m_sharedStrings.get(), m_nodeIndex);
             else                    // findRowNode returns an empty row for missing rows
-                m_currentRow = XLRow(findRowNode(*m_dataNode, m_currentRowNumber), m_sharedStrings.get());
+                m_currentRow = XLRow(findRowNode(*m_dataNode, m_currentRowNumber), m_sharedStrings.get(), m_nodeIndex);
         }
         else {
             // ===== Find or create, and fetch an XLRow at m_currentRowNumber
@@ -500,7 +506,7 @@ namespace OpenXLSX
                 if (rowNode.empty())    // if row could not be found / created
                     m_currentRow = XLRow{}; // make sure m_currentRow is set to an empty cell
                 else
-                    m_currentRow = XLRow(rowNode, m_sharedStrings.get());
+                    m_currentRow = XLRow(rowNode, m_sharedStrings.get(), m_nodeIndex);
             }
             else
                 throw XLInternalError("XLRowIterator::updateCurrentRow: an internal error occured (m_currentRowNumber <= m_hintRowNumber)");
@@ -628,11 +634,16 @@ namespace OpenXLSX
      * @pre
      * @post
      */
-    XLRowRange::XLRowRange(const XMLNode& dataNode, uint32_t first, uint32_t last, const XLSharedStrings& sharedStrings)
+    XLRowRange::XLRowRange(const XMLNode&         dataNode,
+                           uint32_t               first,
+                           uint32_t               last,
+                           const XLSharedStrings& sharedStrings,
+                           XLSheetNodeIndex*      nodeIndex)
         : m_dataNode(std::make_unique<XMLNode>(dataNode)),
           m_firstRow(first),
           m_lastRow(last),
-          m_sharedStrings(sharedStrings)
+          m_sharedStrings(sharedStrings),
+          m_nodeIndex(nodeIndex)
     {}
 
     /**
@@ -644,7 +655,8 @@ namespace OpenXLSX
         : m_dataNode(std::make_unique<XMLNode>(*other.m_dataNode)),
           m_firstRow(other.m_firstRow),
           m_lastRow(other.m_lastRow),
-          m_sharedStrings(other.m_sharedStrings)
+          m_sharedStrings(other.m_sharedStrings),
+          m_nodeIndex(other.m_nodeIndex)
     {}
 
     /**
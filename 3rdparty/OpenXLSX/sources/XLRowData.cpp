@@ -51,6 +51,7 @@ YM      M9  MM    MM MM       MM    MM   d'  `MM.    MM            MM   d'  `MM.
 #include "XLCell.hpp"
 #include "XLRow.hpp"
 #include "XLRowData.hpp"
+#include "XLSheetNodeIndex.hpp"
 #include "utilities/XLUtilities.hpp"
 
 // ========== XLRowDataIterator  ============================================ //
@@ -506,6 +507,7 @@ namespace OpenXLSX
 
         // ===== Delete selected cell nodes
         for (auto cellNodeToDelete : toBeDeleted) m_rowNode->remove_child(cellNodeToDelete);
+        if (m_row->m_nodeIndex) m_row->m_nodeIndex->invalidateRow(static_cast<uint32_t>(m_row->rowNumber()));
     }
 
     /**
@@ -535,6 +537,10 @@ namespace OpenXLSX
      * @pre
      * @post
      */
-    void XLRowDataProxy::clear() { m_rowNode->remove_children(); }    // NOLINT
+    void XLRowDataProxy::clear()    // NOLINT
+    {
+        m_rowNode->remove_children();
+        if (m_row->m_nodeIndex) m_row->m_nodeIndex->invalidateRow(static_cast<uint32_t>(m_row->rowNumber()));
+    }
 
 }    // namespace OpenXLSX
@@ -63,10 +63,12 @@ using namespace OpenXLSX;
  * @details Constructs a new XLSharedStrings object. Only one (common) object is allowed per XLDocument instance.
  * A filepath to the underlying XML file must be provided.
  */
-XLSharedStrings::XLSharedStrings(XLXmlData* xmlData, std::deque<std::string>* stringCache)
+XLSharedStrings::XLSharedStrings(XLXmlData* xmlData, std::deque<std::string>* stringCache, XLSharedStringIndex* stringIndex)
     : XLXmlFile(xmlData),
-      m_stringCache(stringCache)
+      m_stringCache(stringCache),
+      m_stringIndex(stringIndex)
 {
+    rebuildIndex();
     XMLDocument & doc = xmlDocument();
     if (doc.document_element().empty())    // handle a bad (no document element) xl/sharedStrings.xml
         doc.load_string(
@@ -89,9 +91,16 @@ XLSharedStrings::~XLSharedStrings() = default;
 
 /**
  * @details Look up a string index by the string content. If the string does not exist, the returned index is -1.
+ * If the same string occurs more than once in the table, the first index is returned. With a hash index, the lookup
+ * is O(1) instead of a linear search of the cache.
  */
 int32_t XLSharedStrings::getStringIndex(const std::string& str) const
 {
+    if (m_stringIndex != nullptr) {
+        const auto iter = m_stringIndex->find(std::string_view(str));
+        return iter == m_stringIndex->end() ? -1 : iter->second;
+    }
+
     const auto iter = std::find_if(m_stringCache->begin(), m_stringCache->end(), [&](const std::string& s) { return str == s; });
 
     return iter == m_stringCache->end() ? -1 : static_cast<int32_t>(std::distance(m_stringCache->begin(), iter));
@@ -126,11 +135,13 @@ int32_t XLSharedStrings::appendString(const std::string& str) const
         using namespace std::literals::string_literals;
         throw XLInternalError("XLSharedStrings::"s + __func__ + ": exceeded max strings count "s + std::to_string(XLMaxSharedStrings));
     }
+    m_xmlData->markDirty();
     auto textNode = xmlDocument().document_element().append_child("si").append_child("t");
     if ((!str.empty()) && (str.front() == ' ' || str.back() == ' '))
         textNode.append_attribute("xml:space").set_value("preserve");    // pull request #161
     textNode.text().set(str.c_str());
     m_stringCache->emplace_back(textNode.text().get());    // index of this element = previous stringCacheSize
+    if (m_stringIndex != nullptr) m_stringIndex->try_emplace(std::string_view(m_stringCache->back()), static_cast<int32_t>(stringCacheSize));
 
     return static_cast<int32_t>(stringCacheSize);
 }
@@ -152,7 +163,31 @@ void XLSharedStrings::clearString(int32_t index) const   // 2024-04-30: whitespa
         throw XLInternalError("XLSharedStrings::"s + __func__ + ": index "s + std::to_string(index) + " is out of range"s);
     }
 
+    if (m_stringIndex != nullptr) {
+        // ===== Drop the index entry for the old content; a later duplicate of that content becomes its first occurrence
+        const std::string& old = (*m_stringCache)[index];
+        if (const auto iter = m_stringIndex->find(std::string_view(old)); iter != m_stringIndex->end() && iter->second == index) {
+            m_stringIndex->erase(iter);
+            for (size_t i = static_cast<size_t>(index) + 1; i < m_stringCache->size(); ++i) {
+                if ((*m_stringCache)[i] == old) {
+                    m_stringIndex->emplace(std::string_view((*m_stringCache)[i]), static_cast<int32_t>(i));
+                    break;
+                }
+            }
+        }
+    }
+
     (*m_stringCache)[index] = "";
+    m_xmlData->markDirty();
+
+    if (m_stringIndex != nullptr) {
+        // ===== The cleared entry may now be the first occurrence of the empty string
+        const auto iter = m_stringIndex->find(std::string_view());
+        if (iter == m_stringIndex->end() || iter->second > index) {
+            if (iter != m_stringIndex->end()) m_stringIndex->erase(iter);
+            m_stringIndex->emplace(std::string_view((*m_stringCache)[index]), index);
+        }
+    }
     // auto iter            = xmlDocument().document_element().children().begin();
     // std::advance(iter, index);
     // iter->text().set(""); // 2024-04-30: BUGFIX: this was never going to work, <si> entries can be plenty that need to be cleared,
@@ -175,12 +210,25 @@ void XLSharedStrings::clearString(int32_t index) const   // 2024-04-30: whitespa
     }
 }
 
+/**
+ * @details Strings that occur more than once keep the index of their first occurrence, as with a linear search.
+ */
+void XLSharedStrings::rebuildIndex()
+{
+    if (m_stringIndex == nullptr || m_stringCache == nullptr) return;
+    m_stringIndex->clear();
+    m_stringIndex->reserve(m_stringCache->size());
+    int32_t index = 0;
+    for (const std::string& s : *m_stringCache) m_stringIndex->try_emplace(std::string_view(s), index++);
+}
+
 /**
  * @details
  */
 int32_t XLSharedStrings::rewriteXmlFromCache()
 {
     int32_t writtenStrings = 0;
+    m_xmlData->markDirty();
     xmlDocument().document_element().remove_children();  // clear all existing XML
     for (std::string& s : *m_stringCache) {
         XMLNode textNode = xmlDocument().document_element().append_child("si").append_child("t");
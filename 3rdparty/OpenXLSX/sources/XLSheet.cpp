@@ -946,6 +946,9 @@ std::string XLConditionalFormats::summary() const
  */
 XLWorksheet::XLWorksheet(XLXmlData* xmlData) : XLSheetBase(xmlData)
 {
+    // ===== All XLWorksheet objects of the same sheet share one node index, so that a node removal through one of them is seen by all
+    if (xmlData) m_nodeIndex = xmlData->nodeIndex();
+
     // ===== Read the dimensions of the Sheet and set data members accordingly.
     if (const std::string dimensions = xmlDocument().document_element().child("dimension").attribute("ref").value();
         dimensions.find(':') == std::string::npos)
@@ -994,6 +997,7 @@ XLWorksheet::XLWorksheet(const XLWorksheet& other) : XLSheetBase<XLWorksheet>(ot
     m_vmlDrawing    = other.m_vmlDrawing;     //  "     XLVmlDrawing
     m_comments      = other.m_comments;       //  "     XLComments         "
     m_tables        = other.m_tables;         //  "     XLTables           "
+    m_nodeIndex     = other.m_nodeIndex;      // share the node index between copies of the worksheet
 }
 
 /**
@@ -1006,6 +1010,7 @@ XLWorksheet::XLWorksheet(XLWorksheet&& other) : XLSheetBase< XLWorksheet >(other
     m_vmlDrawing    = std::move(other.m_vmlDrawing);     //  "     XLVmlDrawing
     m_comments      = std::move(other.m_comments);       //  "     XLComments         "
     m_tables        = std::move(other.m_tables);         //  "     XLTables           "
+    m_nodeIndex     = other.m_nodeIndex;                 // share: other remains a usable worksheet
 }
 
 /**
@@ -1019,6 +1024,7 @@ XLWorksheet& XLWorksheet::operator=(const XLWorksheet& other)
     m_vmlDrawing    = other.m_vmlDrawing;
     m_comments      = other.m_comments;
     m_tables        = other.m_tables;
+    m_nodeIndex     = other.m_nodeIndex;
     return *this;
 }
 
@@ -1033,6 +1039,7 @@ XLWorksheet& XLWorksheet::operator=(XLWorksheet&& other)
     m_vmlDrawing    = std::move(other.m_vmlDrawing);
     m_comments      = std::move(other.m_comments);
     m_tables        = std::move(other.m_tables);
+    m_nodeIndex     = other.m_nodeIndex;
     return *this;
 }
 
@@ -1088,12 +1095,13 @@ XLCellAssignable XLWorksheet::cell(const XLCellReference& ref) const { return ce
 
 /**
  * @details This function returns a pointer to an XLCell object in the worksheet. This particular overload
- * also serves as the main function, called by the other overloads.
+ * also serves as the main function, called by the other overloads. Row and cell nodes are looked up through the
+ * node index, so that random access costs O(log n) rather than a walk over the siblings.
  */
 XLCellAssignable XLWorksheet::cell(uint32_t rowNumber, uint16_t columnNumber) const
 {
-    const XMLNode rowNode  = getRowNode(xmlDocument().document_element().child("sheetData"), rowNumber);
-    const XMLNode cellNode = getCellNode(rowNode, columnNumber, rowNumber);
+    const XMLNode rowNode  = m_nodeIndex->getRow(xmlDocument().document_element().child("sheetData"), rowNumber);
+    const XMLNode cellNode = m_nodeIndex->getCell(rowNode, rowNumber, columnNumber);
     // ===== Move-construct XLCellAssignable from temporary XLCell
     return XLCellAssignable(XLCell(cellNode, parentDoc().sharedStrings()));
 }
@@ -1113,7 +1121,8 @@ XLCellAssignable XLWorksheet::findCell(const XLCellReference& ref) const { retur
  */
 XLCellAssignable XLWorksheet::findCell(uint32_t rowNumber, uint16_t columnNumber) const
 {
-    return XLCellAssignable(XLCell(findCellNode(findRowNode( xmlDocument().document_element().child("sheetData"), rowNumber ), columnNumber), parentDoc().sharedStrings()));
+    const XMLNode rowNode = m_nodeIndex->findRow(xmlDocument().document_element().child("sheetData"), rowNumber);
+    return XLCellAssignable(XLCell(m_nodeIndex->findCell(rowNode, rowNumber, columnNumber), parentDoc().sharedStrings()));
 }
 
 /**
@@ -1132,6 +1141,124 @@ XLCellRange XLWorksheet::range(const XLCellReference& topLeft, const XLCellRefer
                        parentDoc().sharedStrings());
 }
 
+/**
+ * @details
+ */
+XMLNode XLWorksheet::sheetData() const { return xmlDocument().document_element().child("sheetData"); }
+
+/**
+ * @details Rows and cells in sheetData are sorted, so the range is read by walking the row nodes once and, within
+ *          each row, the cell nodes once.
+ */
+void XLWorksheet::visitRange(const XLCellReference& topLeft,
+                             const XLCellReference& bottomRight,
+                             const std::function<void(uint32_t, uint16_t, const XMLNode&)>& visitor) const
+{
+    const uint32_t firstRow    = topLeft.row();
+    const uint32_t lastRow     = bottomRight.row();
+    const uint16_t firstColumn = topLeft.column();
+    const uint16_t lastColumn  = bottomRight.column();
+
+    XMLNode rowNode = m_nodeIndex->lowerBoundRow(xmlDocument().document_element().child("sheetData"), firstRow);
+    for (; not rowNode.empty(); rowNode = rowNode.next_sibling_of_type(pugi::node_element)) {
+        const auto rowNumber = static_cast<uint32_t>(rowNode.attribute("r").as_ullong());
+        if (rowNumber > lastRow) break;
+
+        for (XMLNode cellNode = rowNode.first_child_of_type(pugi::node_element); not cellNode.empty();
+             cellNode         = cellNode.next_sibling_of_type(pugi::node_element))
+        {
+            const uint16_t columnNumber = columnNumberFromAddress(cellNode.attribute("r").value());
+            if (columnNumber < firstColumn) continue;
+            if (columnNumber > lastColumn) break;
+            visitor(rowNumber, columnNumber, cellNode);
+        }
+    }
+}
+
+/**
+ * @details Like visitRange, but missing rows and cells are inserted in order during the same pass, so that every
+ *          cell of the range is handed to the writer. The cell addresses are assembled from column letters and row
+ *          numbers computed once, and the dimension of the worksheet is updated once at the end.
+ */
+void XLWorksheet::writeRange(const XLCellReference& topLeft,
+                             const XLCellReference& bottomRight,
+                             const std::function<void(uint32_t, uint16_t, XMLNode&)>& writer)
+{
+    const uint32_t firstRow    = topLeft.row();
+    const uint32_t lastRow     = bottomRight.row();
+    const uint16_t firstColumn = topLeft.column();
+    const uint16_t lastColumn  = bottomRight.column();
+    if (firstRow > lastRow || firstColumn > lastColumn)
+        throw XLInputError("XLWorksheet::writeRange: topLeft (" + topLeft.address() + ") is below or right of bottomRight (" +
+                           bottomRight.address() + ")");
+    m_xmlData->markDirty();
+
+    XMLNode    sheetData = xmlDocument().document_element().child("sheetData");
+    const bool hadRows   = not sheetData.first_child_of_type(pugi::node_element).empty();
+    XMLNode    rowNode   = m_nodeIndex->lowerBoundRow(sheetData, firstRow);
+    bool       inserted  = false;    // whether nodes were inserted bypassing the node index
+
+    std::vector<std::string>  columnLetters;
+    std::vector<XLStyleIndex> colStyles;    // indexed by column number - 1, as expected by setDefaultCellAttributes
+    columnLetters.reserve(lastColumn - firstColumn + 1u);
+    for (uint16_t column = firstColumn; column <= lastColumn; ++column) columnLetters.push_back(XLCellReference::columnAsString(column));
+
+    for (uint32_t row = firstRow; row <= lastRow; ++row) {
+        // ===== Find or insert the row node. rowNode is the first row node >= row, or empty if there is none.
+        while (not rowNode.empty() && rowNode.attribute("r").as_ullong() < row) rowNode = rowNode.next_sibling_of_type(pugi::node_element);
+        if (rowNode.empty() || rowNode.attribute("r").as_ullong() > row) {
+            rowNode = rowNode.empty() ? sheetData.append_child("row") : sheetData.insert_child_before("row", rowNode);
+            rowNode.append_attribute("r") = row;
+            inserted = true;
+        }
+
+        // ===== Column styles only depend on the <cols> element, so they are looked up once
+        if (colStyles.empty()) {
+            colStyles.assign(lastColumn, XLDefaultCellFormat);
+            for (uint16_t column = firstColumn; column <= lastColumn; ++column) colStyles[column - 1] = getColumnStyle(rowNode, column);
+        }
+
+        const std::string rowString = std::to_string(row);
+        XMLNode           cellNode  = rowNode.first_child_of_type(pugi::node_element);
+        for (uint16_t column = firstColumn; column <= lastColumn; ++column) {
+            while (not cellNode.empty() && columnNumberFromAddress(cellNode.attribute("r").value()) < column)
+                cellNode = cellNode.next_sibling_of_type(pugi::node_element);
+            if (cellNode.empty() || columnNumberFromAddress(cellNode.attribute("r").value()) > column) {
+                cellNode = cellNode.empty() ? rowNode.append_child("c") : rowNode.insert_child_before("c", cellNode);
+                setDefaultCellAttributes(cellNode, columnLetters[column - firstColumn] + rowString, rowNode, column, colStyles);
+                inserted = true;
+            }
+            writer(row, column, cellNode);
+        }
+    }
+
+    // ===== A block of inserted nodes would make later lookups walk it: rebuild the node index on next access instead
+    if (inserted) m_nodeIndex->invalidate();
+
+    // ===== Extend the dimension to cover the written range
+    XMLNode dimension = xmlDocument().document_element().child("dimension");
+    if (dimension.empty()) {
+        XMLNode sheetPr = xmlDocument().document_element().child("sheetPr");
+        dimension       = sheetPr.empty() ? xmlDocument().document_element().prepend_child("dimension")
+                                          : xmlDocument().document_element().insert_child_after("dimension", sheetPr);
+    }
+    uint32_t top = firstRow, bottom = lastRow;
+    uint16_t left = firstColumn, right = lastColumn;
+    if (hadRows && not dimension.attribute("ref").empty()) {
+        const std::string ref   = dimension.attribute("ref").value();
+        const size_t      colon = ref.find(':');
+        const XLCellReference first(ref.substr(0, colon));
+        const XLCellReference last(colon == std::string::npos ? ref : ref.substr(colon + 1));
+        top    = std::min(top, first.row());
+        left   = std::min(left, first.column());
+        bottom = std::max(bottom, last.row());
+        right  = std::max(right, last.column());
+    }
+    const std::string newRef = XLCellReference(top, left).address() + ":" + XLCellReference(bottom, right).address();
+    if (dimension.attribute("ref").empty()) dimension.append_attribute("ref");
+    dimension.attribute("ref").set_value(newRef.c_str());
+}
+
 /**
  * @details Get a range based on two cell reference strings
  */
@@ -1162,7 +1289,8 @@ XLRowRange XLWorksheet::rows() const    // 2024-04-29: patched for whitespace
                       (sheetDataNode.last_child_of_type(pugi::node_element).empty()
                            ? 1
                            : static_cast<uint32_t>(sheetDataNode.last_child_of_type(pugi::node_element).attribute("r").as_ullong())),
-                      parentDoc().sharedStrings());
+                      parentDoc().sharedStrings(),
+                      m_nodeIndex.get());
 }
 
 /**
@@ -1175,7 +1303,8 @@ XLRowRange XLWorksheet::rows(uint32_t rowCount) const
     return XLRowRange(xmlDocument().document_element().child("sheetData"),
                       1,
                       rowCount,
-                      parentDoc().sharedStrings());
+                      parentDoc().sharedStrings(),
+                      m_nodeIndex.get());
 }
 
 /**
@@ -1188,7 +1317,8 @@ XLRowRange XLWorksheet::rows(uint32_t firstRow, uint32_t lastRow) const
     return XLRowRange(xmlDocument().document_element().child("sheetData"),
                       firstRow,
                       lastRow,
-                      parentDoc().sharedStrings());
+                      parentDoc().sharedStrings(),
+                      m_nodeIndex.get());
 }
 
 /**
@@ -1198,8 +1328,9 @@ XLRowRange XLWorksheet::rows(uint32_t firstRow, uint32_t lastRow) const
  */
 XLRow XLWorksheet::row(uint32_t rowNumber) const
 {
-    return XLRow { getRowNode(xmlDocument().document_element().child("sheetData"), rowNumber),
-                   parentDoc().sharedStrings() };
+    return XLRow { m_nodeIndex->getRow(xmlDocument().document_element().child("sheetData"), rowNumber),
+                   parentDoc().sharedStrings(),
+                   m_nodeIndex.get() };
 }
 
 /**
@@ -1336,6 +1467,7 @@ bool XLWorksheet::deleteRow(uint32_t rowNumber)
 
     // ===== Fail if rowNumber is not in XML
     if (rowNumber < row.attribute("r").as_ullong() || rowNumber > lastRow.attribute("r").as_ullong()) return false;
+    m_xmlData->markDirty();
 
     // ===== If rowNumber is closer to first (existing) row than to last row, search forwards
     if (rowNumber - row.attribute("r").as_ullong() < lastRow.attribute("r").as_ullong() - rowNumber)
@@ -1349,8 +1481,10 @@ bool XLWorksheet::deleteRow(uint32_t rowNumber)
 
     if (row.attribute("r").as_ullong() != rowNumber) return false;    // row not found in XML
 
-    // ===== If row was located: remove it
-    return xmlDocument().document_element().child("sheetData").remove_child(row);
+    // ===== If row was located: remove it, and drop the node index that still refers to it
+    if (not xmlDocument().document_element().child("sheetData").remove_child(row)) return false;
+    m_nodeIndex->invalidate();
+    return true;
 }
 
 /**
@@ -1422,6 +1556,7 @@ void XLWorksheet::mergeCells(XLCellRange const& rangeToMerge, bool emptyHiddenCe
     }
 
     merges().appendMerge(rangeToMerge.address());
+    m_xmlData->markDirty();
     if (emptyHiddenCells) {
         // ===== Iterate over rangeToMerge, delete values & attributes (except r and s) for all but the first cell in the range
         XLCellIterator it = rangeToMerge.begin();
@@ -1447,8 +1582,10 @@ void XLWorksheet::mergeCells(const std::string& rangeReference, bool emptyHidden
 void XLWorksheet::unmergeCells(XLCellRange const& rangeToUnmerge)
 {
     int32_t mergeIndex = merges().findMerge(rangeToUnmerge.address());
-    if (mergeIndex != -1)
+    if (mergeIndex != -1) {
         merges().deleteMerge(mergeIndex);
+        m_xmlData->markDirty();
+    }
     else {
         using namespace std::literals::string_literals;
         throw XLInputError("XLWorksheet::"s + __func__ + ": merged range "s + rangeToUnmerge.address() + " does not exist"s);
@@ -0,0 +1,268 @@
+/*
+
+   ____                               ____      ___ ____       ____  ____      ___
+  6MMMMb                              `MM(      )M' `MM'      6MMMMb\`MM(      )M'
+ 8P    Y8                              `MM.     d'   MM      6M'    ` `MM.     d'
+6M      Mb __ ____     ____  ___  __    `MM.   d'    MM      MM        `MM.   d'
+MM      MM `M6MMMMb   6MMMMb `MM 6MMb    `MM. d'     MM      YM.        `MM. d'
+MM      MM  MM'  `Mb 6M'  `Mb MMM9 `Mb    `MMd       MM       YMMMMb     `MMd
+MM      MM  MM    MM MM    MM MM'   MM     dMM.      MM           `Mb     dMM.
+MM      MM  MM    MM MMMMMMMM MM    MM    d'`MM.     MM            MM    d'`MM.
+YM      M9  MM    MM MM       MM    MM   d'  `MM.    MM            MM   d'  `MM.
+ 8b    d8   MM.  ,M9 YM    d9 MM    MM  d'    `MM.   MM    / L    ,M9  d'    `MM.
+  YMMMM9    MMYMMM9   YMMMM9 _MM_  _MM_M(_    _)MM_ _MMMMMMM MYMMMM9 _M(_    _)MM_
+            MM
+            MM
+           _MM_
+
+  Copyright (c) 2018, Kenneth Troldal Balslev
+
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+  - Neither the name of the author nor the
+    names of any contributors may be used to endorse or promote products
+    derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+// ===== External Includes ===== //
+#include <algorithm>
+#include <string>
+
+// ===== OpenXLSX Includes ===== //
+#include "XLSheetNodeIndex.hpp"
+#include "XLCellReference.hpp"
+#include "XLConstants.hpp"
+#include "XLException.hpp"
+#include "utilities/XLUtilities.hpp" // columnNumberFromAddress, setDefaultCellAttributes
+
+using namespace OpenXLSX;
+
+namespace { // anonymous namespace: do not export any symbols from here
+    /**
+     * @brief If a lookup has to walk more than this many unindexed sibling nodes, the index is rebuilt
+     */
+    constexpr const size_t XLNodeIndexRebuildSteps = 64;
+
+    /**
+     * @brief The result of locate: the node with the requested key, or the last node with a smaller key
+     */
+    struct XLNodeLocation
+    {
+        XMLNode match;          /**< the node with the requested key, empty if there is none */
+        XMLNode predecessor;    /**< if match is empty: the last node with a smaller key, empty if there is none */
+        bool    rebuild;        /**< true if the walk over unindexed nodes was long enough to warrant a rebuild */
+    };
+
+    uint32_t rowKey(const XMLNode& rowNode) { return static_cast<uint32_t>(rowNode.attribute("r").as_ullong()); }
+    uint32_t cellKey(const XMLNode& cellNode) { return columnNumberFromAddress(cellNode.attribute("r").value()); }
+
+    /**
+     * @brief Locate the child node of parent with the given key, using the sorted entries
+     * @details A binary search in entries yields the closest indexed neighbours. The element siblings between them, if any,
+     *  were inserted without going through the index: they are walked, and a node matching key is added to entries.
+     */
+    template<class KeyOf>
+    XLNodeLocation locate(std::vector<XLNodeIndexEntry>& entries, const XMLNode& parent, uint32_t key, KeyOf keyOf)
+    {
+        const auto iter = std::lower_bound(entries.begin(), entries.end(), key,
+                                           [](const XLNodeIndexEntry& entry, uint32_t k) { return entry.key < k; });
+        if (iter != entries.end() && iter->key == key) return { iter->node, XMLNode{}, false };
+
+        const XMLNode stop        = (iter == entries.end() ? XMLNode{} : iter->node);
+        XMLNode       predecessor = (iter == entries.begin() ? XMLNode{} : std::prev(iter)->node);
+        XMLNode       node        = predecessor.empty() ? parent.first_child_of_type(pugi::node_element)
+                                                        : predecessor.next_sibling_of_type(pugi::node_element);
+        size_t steps = 0;
+        while (not node.empty() && node != stop && keyOf(node) < key) {
+            predecessor = node;
+            node        = node.next_sibling_of_type(pugi::node_element);
+            ++steps;
+        }
+
+        XLNodeLocation result { XMLNode{}, predecessor, steps > XLNodeIndexRebuildSteps };
+        if (not node.empty() && node != stop && keyOf(node) == key) {
+            result.match = node;
+            entries.insert(iter, XLNodeIndexEntry{ key, node });
+        }
+        return result;
+    }
+
+    /**
+     * @brief Insert a new child element after predecessor, or at the beginning of parent if predecessor is empty
+     * @note Mirrors getRowNode / getCellNode: a node inserted before all other elements is prepended, so that whitespace
+     *  formatting towards the next element is kept
+     */
+    XMLNode insertAfter(XMLNode parent, const XMLNode& predecessor, const char* name)
+    {
+        if (not predecessor.empty()) return parent.insert_child_after(name, predecessor);
+        if (parent.first_child_of_type(pugi::node_element).empty()) return parent.append_child(name);
+        return parent.prepend_child(name);
+    }
+
+    void checkRowNumber(uint32_t rowNumber)
+    {
+        if (rowNumber < 1 || rowNumber > OpenXLSX::MAX_ROWS) {
+            using namespace std::literals::string_literals;
+            throw XLCellAddressError("rowNumber "s + std::to_string(rowNumber) + " is outside valid range [1;"s + std::to_string(OpenXLSX::MAX_ROWS) + "]"s);
+        }
+    }
+
+    void checkColumnNumber(uint16_t columnNumber)
+    {
+        if (columnNumber < 1 || columnNumber > OpenXLSX::MAX_COLS) {
+            using namespace std::literals::string_literals;
+            throw XLException("XLWorksheet::column: columnNumber "s + std::to_string(columnNumber) + " is outside allowed range [1;"s + std::to_string(MAX_COLS) + "]"s);
+        }
+    }
+} // anonymous namespace
+
+/**
+ * @details
+ */
+XMLNode XLSheetNodeIndex::findRow(const XMLNode& sheetData, uint32_t rowNumber)
+{
+    checkRowNumber(rowNumber);
+    indexRows(sheetData);
+    const XLNodeLocation location = locate(m_rows, sheetData, rowNumber, rowKey);
+    if (location.rebuild) m_rowsIndexed = false;
+    return location.match;
+}
+
+/**
+ * @details
+ */
+XMLNode XLSheetNodeIndex::getRow(const XMLNode& sheetData, uint32_t rowNumber)
+{
+    checkRowNumber(rowNumber);
+    indexRows(sheetData);
+    const XLNodeLocation location = locate(m_rows, sheetData, rowNumber, rowKey);
+    if (location.rebuild) m_rowsIndexed = false;
+    if (not location.match.empty()) return location.match;
+
+    XMLNode rowNode = insertAfter(sheetData, location.predecessor, "row");
+    rowNode.append_attribute("r") = rowNumber;
+    if (m_rowsIndexed) {
+        const auto iter = std::lower_bound(m_rows.begin(), m_rows.end(), rowNumber,
+                                           [](const XLNodeIndexEntry& entry, uint32_t k) { return entry.key < k; });
+        m_rows.insert(iter, XLNodeIndexEntry{ rowNumber, rowNode });
+    }
+    return rowNode;
+}
+
+/**
+ * @details
+ */
+XMLNode XLSheetNodeIndex::lowerBoundRow(const XMLNode& sheetData, uint32_t rowNumber)
+{
+    indexRows(sheetData);
+    const XLNodeLocation location = locate(m_rows, sheetData, std::max(rowNumber, 1u), rowKey);
+    if (location.rebuild) m_rowsIndexed = false;
+    if (not location.match.empty()) return location.match;
+    return location.predecessor.empty() ? sheetData.first_child_of_type(pugi::node_element)
+                                        : location.predecessor.next_sibling_of_type(pugi::node_element);
+}
+
+/**
+ * @details
+ */
+XMLNode XLSheetNodeIndex::findCell(const XMLNode& rowNode, uint32_t rowNumber, uint16_t columnNumber)
+{
+    checkColumnNumber(columnNumber);
+    if (rowNode.empty()) return XMLNode{};
+
+    std::vector<XLNodeIndexEntry>& cells    = indexCells(rowNode, rowNumber);
+    const XLNodeLocation           location = locate(cells, rowNode, columnNumber, cellKey);
+    if (location.rebuild) m_cells.erase(rowNumber);
+    return location.match;
+}
+
+/**
+ * @details
+ */
+XMLNode XLSheetNodeIndex::getCell(const XMLNode& rowNode, uint32_t rowNumber, uint16_t columnNumber)
+{
+    checkColumnNumber(columnNumber);
+    if (rowNode.empty()) return XMLNode{};
+
+    std::vector<XLNodeIndexEntry>& cells    = indexCells(rowNode, rowNumber);
+    const XLNodeLocation           location = locate(cells, rowNode, columnNumber, cellKey);
+    if (not location.match.empty()) {
+        if (location.rebuild) m_cells.erase(rowNumber);
+        return location.match;
+    }
+
+    XMLNode cellNode = insertAfter(rowNode, location.predecessor, "c");
+    setDefaultCellAttributes(cellNode, XLCellReference::columnAsString(columnNumber) + XLCellReference::rowAsString(rowNumber), rowNode,
+                             columnNumber);
+    if (location.rebuild)
+        m_cells.erase(rowNumber);
+    else
+        cells.insert(std::lower_bound(cells.begin(), cells.end(), columnNumber,
+                                      [](const XLNodeIndexEntry& entry, uint32_t k) { return entry.key < k; }),
+                     XLNodeIndexEntry{ columnNumber, cellNode });
+    return cellNode;
+}
+
+/**
+ * @details
+ */
+void XLSheetNodeIndex::invalidate()
+{
+    m_rowsIndexed = false;
+    m_rows.clear();
+    m_cells.clear();
+}
+
+/**
+ * @details
+ */
+void XLSheetNodeIndex::invalidateRow(uint32_t rowNumber) { m_cells.erase(rowNumber); }
+
+/**
+ * @details Walks all row nodes once. Row nodes are expected in ascending order, as required by the OOXML standard.
+ */
+void XLSheetNodeIndex::indexRows(const XMLNode& sheetData)
+{
+    if (m_rowsIndexed && m_sheetData == sheetData) return;
+    if (m_sheetData != sheetData) m_cells.clear();    // a different sheetData: the cell indexes are stale as well
+
+    m_sheetData = sheetData;
+    m_rows.clear();
+    for (XMLNode rowNode = sheetData.first_child_of_type(pugi::node_element); not rowNode.empty();
+         rowNode         = rowNode.next_sibling_of_type(pugi::node_element))
+        m_rows.push_back(XLNodeIndexEntry{ rowKey(rowNode), rowNode });
+    m_rowsIndexed = true;
+}
+
+/**
+ * @details Walks the cell nodes of the row once, on first access to the row
+ */
+std::vector<XLNodeIndexEntry>& XLSheetNodeIndex::indexCells(const XMLNode& rowNode, uint32_t rowNumber)
+{
+    const auto [iter, inserted] = m_cells.try_emplace(rowNumber);
+    if (inserted) {
+        for (XMLNode cellNode = rowNode.first_child_of_type(pugi::node_element); not cellNode.empty();
+             cellNode         = cellNode.next_sibling_of_type(pugi::node_element))
+            iter->second.push_back(XLNodeIndexEntry{ cellKey(cellNode), cellNode });
+    }
+    return iter->second;
+}
@@ -2683,3 +2683,8 @@ XLCellStyles& XLStyles::cellStyles() const { return *m_cellStyles; }
  * @details return a handle to the underlying differential cell formats
  */
 XLDiffCellFormats& XLStyles::diffCellFormats() const { return *m_diffCellFormats; }
+
+/**
+ * @details Returns the document element of the styles part
+ */
+XMLNode XLStyles::rootNode() const { return xmlDocument().document_element(); }
@@ -49,6 +49,7 @@ YM      M9  MM    MM MM       MM    MM   d'  `MM.    MM            MM   d'  `MM.
 
 // ===== OpenXLSX Includes ===== //
 #include "XLDocument.hpp"
+#include "XLSheetNodeIndex.hpp"
 #include "XLXmlData.hpp"
 
 using namespace OpenXLSX;
@@ -77,6 +78,9 @@ XLXmlData::~XLXmlData() = default;
 void XLXmlData::setRawData(const std::string& data) // NOLINT
 {
     m_xmlDoc->load_string(data.c_str(), pugi_parse_settings);
+    m_dirty          = true;
+    m_hasFingerprint = false;    // taken by markClean once the data was written
+    if (m_nodeIndex) m_nodeIndex->invalidate();    // all indexed nodes were discarded
 }
 
 /**
@@ -165,9 +169,7 @@ XLContentType XLXmlData::getXmlType() const
  */
 XMLDocument* XLXmlData::getXmlDocument()
 {
-    if (!m_xmlDoc->document_element())
-        m_xmlDoc->load_string(m_parentDoc->extractXmlFromArchive(m_xmlPath).c_str(), pugi_parse_settings);
-
+    load();
     return m_xmlDoc.get();
 }
 
@@ -176,8 +178,139 @@ XMLDocument* XLXmlData::getXmlDocument()
  */
 const XMLDocument* XLXmlData::getXmlDocument() const
 {
-    if (!m_xmlDoc->document_element())
-        m_xmlDoc->load_string(m_parentDoc->extractXmlFromArchive(m_xmlPath).c_str(), pugi_parse_settings);
-
+    load();
     return m_xmlDoc.get();
 }
+
+/**
+ * @details
+ */
+XLXmlDataState XLXmlData::state() const
+{
+    if (not isLoaded()) return XLXmlDataState::Unparsed;
+    if (m_dirty) return XLXmlDataState::Dirty;
+
+    // ===== The baseline of a part that was parsed but never written is taken from its source in the archive, so that
+    // ===== read-only access never pays for it, and an edit made before the first call is still detected.
+    if (not m_hasFingerprint) {
+        XMLDocument source;
+        if (m_parentDoc != nullptr)
+            source.load_string(m_parentDoc->extractXmlFromArchive(m_xmlPath).c_str(), pugi_parse_settings);
+        m_fingerprint    = fingerprint(source);
+        m_hasFingerprint = true;
+    }
+    return fingerprint(*m_xmlDoc) != m_fingerprint ? XLXmlDataState::Dirty : XLXmlDataState::Parsed;
+}
+
+/**
+ * @details
+ */
+void XLXmlData::markClean()
+{
+    m_dirty          = false;
+    m_fingerprint    = fingerprint(*m_xmlDoc);
+    m_hasFingerprint = true;
+}
+
+/**
+ * @details
+ */
+void XLXmlData::load() const
+{
+    if (m_xmlDoc->document_element()) return;
+    m_xmlDoc->load_string(m_parentDoc->extractXmlFromArchive(m_xmlPath).c_str(), pugi_parse_settings);
+}
+
+/**
+ * @details FNV-1a over a pre-order walk of the document. Leaving a node is hashed as well, so that moving a node to
+ *  another parent changes the fingerprint.
+ */
+uint64_t XLXmlData::fingerprint(const XMLDocument& doc)
+{
+    uint64_t hash = 14695981039346656037ull;
+    const auto mix = [&hash](const char* text) {
+        for (; *text != '\0'; ++text) hash = (hash ^ static_cast<unsigned char>(*text)) * 1099511628211ull;
+        hash = (hash ^ 0xffu) * 1099511628211ull;    // terminator, so that "ab","c" and "a","bc" differ
+    };
+
+    const pugi::xml_node root = doc;
+    pugi::xml_node       node = root.first_child();
+    while (not node.empty()) {
+        hash = (hash ^ static_cast<uint64_t>(node.type())) * 1099511628211ull;
+        mix(node.name());
+        mix(node.value());
+        for (const pugi::xml_attribute& attr : node.attributes()) {
+            mix(attr.name());
+            mix(attr.value());
+        }
+
+        // ===== Descend first, then advance to the next sibling, climbing up as long as there is none
+        if (not node.first_child().empty()) {
+            node = node.first_child();
+            continue;
+        }
+        while (not node.empty() && node != root && node.next_sibling().empty()) {
+            hash = (hash ^ 0xfeu) * 1099511628211ull;
+            node = node.parent();
+        }
+        if (node.empty() || node == root) break;
+        hash = (hash ^ 0xfeu) * 1099511628211ull;
+        node = node.next_sibling();
+    }
+    return hash;
+}
+
+/**
+ * @details
+ */
+std::shared_ptr<XLSheetNodeIndex> XLXmlData::nodeIndex()
+{
+    if (not m_nodeIndex) m_nodeIndex = std::make_shared<XLSheetNodeIndex>();
+    return m_nodeIndex;
+}
+
+/**
+ * @details
+ */
+XLXmlData* XLXmlDataRegistry::find(const std::string& path)
+{
+    const auto entry = m_index.find(path);
+    return entry == m_index.end() ? nullptr : &*entry->second;
+}
+
+/**
+ * @details
+ */
+const XLXmlData* XLXmlDataRegistry::find(const std::string& path) const
+{
+    const auto entry = m_index.find(path);
+    return entry == m_index.end() ? nullptr : &*entry->second;
+}
+
+/**
+ * @details Erase the indexed part. Should another (unindexed) part with the same path exist, it takes over the index entry.
+ */
+bool XLXmlDataRegistry::erase(const std::string& path)
+{
+    const auto entry = m_index.find(path);
+    if (entry == m_index.end()) return false;
+
+    const iterator next = m_parts.erase(entry->second);
+    m_index.erase(entry);
+    for (iterator part = next; part != m_parts.end(); ++part) {
+        if (part->getXmlPath() == path) {
+            m_index.emplace(path, part);
+            break;
+        }
+    }
+    return true;
+}
+
+/**
+ * @details
+ */
+void XLXmlDataRegistry::clear()
+{
+    m_index.clear();
+    m_parts.clear();
+}
@@ -94,6 +94,21 @@ void XLZipArchive::open(const std::string& fileName)
     }
 }
 
+/**
+ * @details
+ */
+void XLZipArchive::open(const void* data, size_t size)
+{
+    m_archive = std::make_shared<Zippy::ZipArchive>();
+    try {
+        m_archive->Open(data, size);
+    }
+    catch( ... ) {    // catch all exceptions
+        m_archive.reset();    // make m_archive invalid again
+        throw;                // re-throw
+    }
+}
+
 /**
  * @details
  */
@@ -111,6 +126,14 @@ void XLZipArchive::save(const std::string& path) // NOLINT
     m_archive->Save(path);
 }
 
+/**
+ * @details The archive stays open on its current source; modified entries remain in memory.
+ */
+void XLZipArchive::save(const std::function<void(const char*, size_t)>& write)
+{
+    m_archive->Save(write);
+}
+
 /**
  * @details
  */
@@ -140,3 +163,36 @@ std::string XLZipArchive::getEntry(const std::string& name) const {
 bool XLZipArchive::hasEntry(const std::string& entryName) const {
     return m_archive->HasEntry(entryName);
 }
+
+/**
+ * @details
+ */
+std::string_view XLZipArchive::getEntryView(const std::string& name) const {
+    auto view = m_archive->GetEntryView(name);
+    if (!view.first) return {};
+    return { reinterpret_cast<const char*>(view.first), view.second };
+}
+
+/**
+ * @details The returned callable shares ownership of the archive object, but the archive must not be closed or saved
+ * while the entry is being read.
+ */
+std::function<size_t(char*, size_t)> XLZipArchive::openEntryStream(const std::string& name) const {
+    auto stream = std::make_shared<Zippy::ZipEntryStream>(m_archive->OpenEntryStream(name));
+    if (!stream->IsOpen()) return {};
+    return [archive = m_archive, stream](char* buffer, size_t size) { return stream->Read(buffer, size); };
+}
+
+/**
+ * @details
+ */
+std::vector<std::string> XLZipArchive::entryNames() const {
+    return m_archive->GetEntryNames(false, true);
+}
+
+/**
+ * @details
+ */
+void XLZipArchive::setCompressionLevel(std::function<int(const std::string&)> levelFor) {
+    m_archive->SetCompressionLevel(std::move(levelFor));
+}
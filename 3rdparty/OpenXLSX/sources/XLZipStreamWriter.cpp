@@ -0,0 +1,328 @@
+/*
+
+   ____                               ____      ___ ____       ____  ____      ___
+  6MMMMb                              `MM(      )M' `MM'      6MMMMb\`MM(      )M'
+ 8P    Y8                              `MM.     d'   MM      6M'    ` `MM.     d'
+6M      Mb __ ____     ____  ___  __    `MM.   d'    MM      MM        `MM.   d'
+MM      MM `M6MMMMb   6MMMMb `MM 6MMb    `MM. d'     MM      YM.        `MM. d'
+MM      MM  MM'  `Mb 6M'  `Mb MMM9 `Mb    `MMd       MM       YMMMMb     `MMd
+MM      MM  MM    MM MM    MM MM'   MM     dMM.      MM           `Mb     dMM.
+MM      MM  MM    MM MMMMMMMM MM    MM    d'`MM.     MM            MM    d'`MM.
+YM      M9  MM    MM MM       MM    MM   d'  `MM.    MM            MM   d'  `MM.
+ 8b    d8   MM.  ,M9 YM    d9 MM    MM  d'    `MM.   MM    / L    ,M9  d'    `MM.
+  YMMMM9    MMYMMM9   YMMMM9 _MM_  _MM_M(_    _)MM_ _MMMMMMM MYMMMM9 _M(_    _)MM_
+            MM
+            MM
+           _MM_
+
+  Copyright (c) 2018, Kenneth Troldal Balslev
+
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+  - Neither the name of the author nor the
+    names of any contributors may be used to endorse or promote products
+    derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+// ===== External Includes ===== //
+#include <ctime>
+#include <fstream>
+#include <vector>
+#include <zippy.hpp>
+
+// ===== OpenXLSX Includes ===== //
+#include "XLException.hpp"
+#include "XLZipStreamWriter.hpp"
+
+using namespace OpenXLSX;
+
+namespace
+{
+    constexpr uint32_t LocalHeaderSignature     = 0x04034b50;
+    constexpr uint32_t DataDescriptorSignature  = 0x08074b50;
+    constexpr uint32_t CentralHeaderSignature   = 0x02014b50;
+    constexpr uint32_t EndOfCentralDirSignature = 0x06054b50;
+    constexpr uint16_t VersionNeeded            = 20;
+    constexpr uint16_t FlagDataDescriptor       = 0x0008;
+    constexpr uint16_t FlagUtf8Name             = 0x0800;
+    constexpr uint16_t MethodDeflate            = 8;
+
+    /**
+     * @brief Central directory record of a finished entry.
+     */
+    struct EntryRecord
+    {
+        std::string name;
+        uint32_t    crc              = 0;
+        uint64_t    compressedSize   = 0;
+        uint64_t    uncompressedSize = 0;
+        uint64_t    headerOffset     = 0;
+    };
+
+    void putU16(std::string& out, uint16_t value)
+    {
+        out.push_back(static_cast<char>(value & 0xff));
+        out.push_back(static_cast<char>((value >> 8) & 0xff));
+    }
+
+    void putU32(std::string& out, uint32_t value)
+    {
+        putU16(out, static_cast<uint16_t>(value & 0xffff));
+        putU16(out, static_cast<uint16_t>((value >> 16) & 0xffff));
+    }
+
+    /**
+     * @brief Check that a size or offset fits the 32 bit fields of a non-zip64 archive.
+     */
+    uint32_t checked32(uint64_t value)
+    {
+        if (value > 0xffffffffULL) throw XLInternalError("XLZipStreamWriter: entry or archive exceeds 4 GiB (zip64 is not supported)");
+        return static_cast<uint32_t>(value);
+    }
+}    // namespace
+
+/**
+ * @details Holds the output sink, the deflate state of the current entry and the records for the central directory.
+ */
+struct XLZipStreamWriter::Impl
+{
+    WriteCallback                             sink;
+    std::unique_ptr<std::ofstream>            file;
+    std::unique_ptr<ns_miniz::tdefl_compressor> compressor;
+    std::vector<EntryRecord>                  entries;
+    EntryRecord                               current;
+    uint64_t                                  offset  = 0;
+    bool                                      inEntry = false;
+    uint16_t                                  dosTime = 0;
+    uint16_t                                  dosDate = 0;
+
+    void emit(const char* data, size_t size)
+    {
+        sink(data, size);
+        offset += size;
+    }
+
+    void emit(const std::string& data) { emit(data.data(), data.size()); }
+
+    static ns_miniz::mz_bool deflateOutput(const void* buffer, int length, void* user)
+    {
+        auto* self = static_cast<Impl*>(user);
+        self->emit(static_cast<const char*>(buffer), static_cast<size_t>(length));
+        self->current.compressedSize += static_cast<uint64_t>(length);
+        return MZ_TRUE;
+    }
+};
+
+/**
+ * @details
+ */
+XLZipStreamWriter::XLZipStreamWriter() = default;
+
+/**
+ * @details
+ */
+XLZipStreamWriter::~XLZipStreamWriter() = default;
+
+/**
+ * @details
+ */
+XLZipStreamWriter::XLZipStreamWriter(XLZipStreamWriter&& other) noexcept = default;
+
+/**
+ * @details
+ */
+XLZipStreamWriter& XLZipStreamWriter::operator=(XLZipStreamWriter&& other) noexcept = default;
+
+/**
+ * @details
+ */
+void XLZipStreamWriter::open(const std::string& fileName)
+{
+    auto file = std::make_unique<std::ofstream>(fileName, std::ios::binary | std::ios::trunc);
+    if (!file->is_open()) throw XLInputError("XLZipStreamWriter: unable to create " + fileName);
+    std::ofstream* out = file.get();
+    open([out](const char* data, size_t size) { out->write(data, static_cast<std::streamsize>(size)); });
+    m_impl->file = std::move(file);
+}
+
+/**
+ * @details All entries get the time stamp of the moment the archive is opened.
+ */
+void XLZipStreamWriter::open(WriteCallback sink)
+{
+    m_impl             = std::make_unique<Impl>();
+    m_impl->sink       = std::move(sink);
+    m_impl->compressor = std::make_unique<ns_miniz::tdefl_compressor>();
+
+    std::time_t now = std::time(nullptr);
+    std::tm     local{};
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    m_impl->dosTime = static_cast<uint16_t>(((local.tm_hour) << 11) | ((local.tm_min) << 5) | ((local.tm_sec) >> 1));
+    m_impl->dosDate = static_cast<uint16_t>(((local.tm_year + 1900 - 1980) << 9) | ((local.tm_mon + 1) << 5) | local.tm_mday);
+}
+
+/**
+ * @details
+ */
+bool XLZipStreamWriter::isOpen() const { return m_impl != nullptr; }
+
+/**
+ * @details Writes the local file header with zero CRC and sizes; the real values follow in the data descriptor.
+ */
+void XLZipStreamWriter::beginEntry(const std::string& name, int level)
+{
+    if (!isOpen()) throw XLInternalError("XLZipStreamWriter: archive is not open");
+    if (m_impl->inEntry) endEntry();
+
+    m_impl->current              = EntryRecord();
+    m_impl->current.name         = name;
+    m_impl->current.headerOffset = m_impl->offset;
+
+    std::string header;
+    putU32(header, LocalHeaderSignature);
+    putU16(header, VersionNeeded);
+    putU16(header, FlagDataDescriptor | FlagUtf8Name);
+    putU16(header, MethodDeflate);
+    putU16(header, m_impl->dosTime);
+    putU16(header, m_impl->dosDate);
+    putU32(header, 0);    // crc-32, in data descriptor
+    putU32(header, 0);    // compressed size, in data descriptor
+    putU32(header, 0);    // uncompressed size, in data descriptor
+    putU16(header, static_cast<uint16_t>(name.size()));
+    putU16(header, 0);    // extra field length
+    header += name;
+    m_impl->emit(header);
+
+    int  windowBits = -MZ_DEFAULT_WINDOW_BITS;    // raw deflate stream, no zlib header
+    auto flags      = ns_miniz::tdefl_create_comp_flags_from_zip_params(level, windowBits, ns_miniz::MZ_DEFAULT_STRATEGY);
+    if (ns_miniz::tdefl_init(m_impl->compressor.get(), &Impl::deflateOutput, m_impl.get(), static_cast<int>(flags)) != ns_miniz::TDEFL_STATUS_OKAY)
+        throw XLInternalError("XLZipStreamWriter: unable to initialise deflate for " + name);
+    m_impl->inEntry = true;
+}
+
+/**
+ * @details
+ */
+void XLZipStreamWriter::write(const char* data, size_t size)
+{
+    if (!isOpen() || !m_impl->inEntry) throw XLInternalError("XLZipStreamWriter: no entry has been started");
+    if (size == 0) return;
+
+    m_impl->current.crc = static_cast<uint32_t>(ns_miniz::mz_crc32(m_impl->current.crc, reinterpret_cast<const unsigned char*>(data), size));
+    m_impl->current.uncompressedSize += size;
+    if (ns_miniz::tdefl_compress_buffer(m_impl->compressor.get(), data, size, ns_miniz::TDEFL_NO_FLUSH) != ns_miniz::TDEFL_STATUS_OKAY)
+        throw XLInternalError("XLZipStreamWriter: deflate failed for " + m_impl->current.name);
+}
+
+/**
+ * @details
+ */
+void XLZipStreamWriter::write(std::string_view data) { write(data.data(), data.size()); }
+
+/**
+ * @details
+ */
+void XLZipStreamWriter::endEntry()
+{
+    if (!isOpen() || !m_impl->inEntry) return;
+
+    if (ns_miniz::tdefl_compress_buffer(m_impl->compressor.get(), nullptr, 0, ns_miniz::TDEFL_FINISH) != ns_miniz::TDEFL_STATUS_DONE)
+        throw XLInternalError("XLZipStreamWriter: deflate failed for " + m_impl->current.name);
+
+    std::string descriptor;
+    putU32(descriptor, DataDescriptorSignature);
+    putU32(descriptor, m_impl->current.crc);
+    putU32(descriptor, checked32(m_impl->current.compressedSize));
+    putU32(descriptor, checked32(m_impl->current.uncompressedSize));
+    m_impl->emit(descriptor);
+
+    m_impl->entries.push_back(std::move(m_impl->current));
+    m_impl->inEntry = false;
+}
+
+/**
+ * @details
+ */
+void XLZipStreamWriter::addEntry(const std::string& name, std::string_view data, int level)
+{
+    beginEntry(name, level);
+    write(data);
+    endEntry();
+}
+
+/**
+ * @details
+ */
+void XLZipStreamWriter::close()
+{
+    if (!isOpen()) return;
+    endEntry();
+
+    uint64_t    directoryOffset = m_impl->offset;
+    std::string directory;
+    for (const auto& entry : m_impl->entries) {
+        putU32(directory, CentralHeaderSignature);
+        putU16(directory, VersionNeeded);    // version made by
+        putU16(directory, VersionNeeded);    // version needed to extract
+        putU16(directory, FlagDataDescriptor | FlagUtf8Name);
+        putU16(directory, MethodDeflate);
+        putU16(directory, m_impl->dosTime);
+        putU16(directory, m_impl->dosDate);
+        putU32(directory, entry.crc);
+        putU32(directory, checked32(entry.compressedSize));
+        putU32(directory, checked32(entry.uncompressedSize));
+        putU16(directory, static_cast<uint16_t>(entry.name.size()));
+        putU16(directory, 0);    // extra field length
+        putU16(directory, 0);    // comment length
+        putU16(directory, 0);    // disk number start
+        putU16(directory, 0);    // internal attributes
+        putU32(directory, 0);    // external attributes
+        putU32(directory, checked32(entry.headerOffset));
+        directory += entry.name;
+    }
+    m_impl->emit(directory);
+
+    if (m_impl->entries.size() > 0xffff) throw XLInternalError("XLZipStreamWriter: too many entries (zip64 is not supported)");
+    std::string end;
+    putU32(end, EndOfCentralDirSignature);
+    putU16(end, 0);    // number of this disk
+    putU16(end, 0);    // disk where central directory starts
+    putU16(end, static_cast<uint16_t>(m_impl->entries.size()));
+    putU16(end, static_cast<uint16_t>(m_impl->entries.size()));
+    putU32(end, checked32(directory.size()));
+    putU32(end, checked32(directoryOffset));
+    putU16(end, 0);    // comment length
+    m_impl->emit(end);
+
+    if (m_impl->file) {
+        m_impl->file->close();
+        if (m_impl->file->fail()) {
+            m_impl.reset();
+            throw XLInternalError("XLZipStreamWriter: failed to write archive");
+        }
+    }
+    m_impl.reset();
+}
@@ -251,6 +251,21 @@ namespace OpenXLSX
             cellNode.append_attribute("s").set_value(cellStyle);
     }
 
+    /**
+     * @brief Get the column number from a cell address such as "AB12", without constructing an XLCellReference.
+     * @details Only the leading column letters are read; nothing is allocated. Used to compare the r attributes of
+     * sibling cell nodes while searching a row.
+     * @param address The cell address, as stored in the r attribute of a cell node.
+     * @return The column number, or 0 if the address does not start with a column letter.
+     */
+    inline uint16_t columnNumberFromAddress(const char* address)
+    {
+        uint32_t column = 0;
+        for (; *address >= 'A' && *address <= 'Z' && column <= OpenXLSX::MAX_COLS; ++address)
+            column = column * 26 + static_cast<uint32_t>(*address - 'A' + 1);
+        return static_cast<uint16_t>(column);
+    }
+
     /**
      * @brief Retrieve the xml node representing the cell at the given row and column. If the node doesn't
      * exist, it will be created.
@@ -272,25 +287,26 @@ namespace OpenXLSX
 
         XMLNode cellNode = rowNode.last_child_of_type(pugi::node_element);
         if (!rowNumber) rowNumber = rowNode.attribute("r").as_uint(); // if not provided, determine from rowNode
-        auto cellRef  = XLCellReference(rowNumber, columnNumber);
+        // ===== The address of the requested cell is only formatted when a new cell node has to be created.
+        auto cellAddress = [&]() { return XLCellReference::columnAsString(columnNumber) + XLCellReference::rowAsString(rowNumber); };
 
         // ===== If there are no cells in the current row, or the requested cell is beyond the last cell in the row...
-        if (cellNode.empty() || (XLCellReference(cellNode.attribute("r").value()).column() < columnNumber)) {
+        if (cellNode.empty() || (columnNumberFromAddress(cellNode.attribute("r").value()) < columnNumber)) {
             // ===== append a new node to the end.
             cellNode = rowNode.append_child("c");
-            setDefaultCellAttributes(cellNode, cellRef.address(), rowNode, columnNumber, colStyles);
+            setDefaultCellAttributes(cellNode, cellAddress(), rowNode, columnNumber, colStyles);
         }
         // ===== If the requested node is closest to the end, start from the end and search backwards...
-        else if (XLCellReference(cellNode.attribute("r").value()).column() - columnNumber < columnNumber) {
-            while (not cellNode.empty() && (XLCellReference(cellNode.attribute("r").value()).column() > columnNumber))
+        else if (columnNumberFromAddress(cellNode.attribute("r").value()) - columnNumber < columnNumber) {
+            while (not cellNode.empty() && (columnNumberFromAddress(cellNode.attribute("r").value()) > columnNumber))
                 cellNode = cellNode.previous_sibling_of_type(pugi::node_element);
             // ===== If the backwards search failed to locate the requested cell
-            if (cellNode.empty() || (XLCellReference(cellNode.attribute("r").value()).column() < columnNumber)) {
+            if (cellNode.empty() || (columnNumberFromAddress(cellNode.attribute("r").value()) < columnNumber)) {
                 if (cellNode.empty()) // If between row begin and higher column number, only non-element nodes exist
                     cellNode = rowNode.prepend_child("c"); // insert a new cell node at row begin. When saving, this will keep whitespace formatting towards next cell node
                 else
                     cellNode = rowNode.insert_child_after("c", cellNode);
-                setDefaultCellAttributes(cellNode, cellRef.address(), rowNode, columnNumber, colStyles);
+                setDefaultCellAttributes(cellNode, cellAddress(), rowNode, columnNumber, colStyles);
             }
         }
         // ===== Otherwise, start from the beginning
@@ -299,12 +315,12 @@ namespace OpenXLSX
             cellNode = rowNode.first_child_of_type(pugi::node_element);
 
             // ===== It has been verified above that the requested columnNumber is <= the column number of the last node_element, therefore this loop will halt:
-            while (XLCellReference(cellNode.attribute("r").value()).column() < columnNumber)
+            while (columnNumberFromAddress(cellNode.attribute("r").value()) < columnNumber)
                 cellNode = cellNode.next_sibling_of_type(pugi::node_element);
             // ===== If the forwards search failed to locate the requested cell
-            if (XLCellReference(cellNode.attribute("r").value()).column() > columnNumber) {
+            if (columnNumberFromAddress(cellNode.attribute("r").value()) > columnNumber) {
                 cellNode = rowNode.insert_child_before("c", cellNode);
-                setDefaultCellAttributes(cellNode, cellRef.address(), rowNode, columnNumber, colStyles);
+                setDefaultCellAttributes(cellNode, cellAddress(), rowNode, columnNumber, colStyles);
             }
         }
         return cellNode;
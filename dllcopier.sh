@@ -10,13 +10,11 @@ DLLs=(
     "libwinpthread-1.dll"
     "zlib1.dll"
     "libMiniXLSX.dll"
-    "libKFZippa.dll"
 )
 
 DLL_SearchPath=(
     "/usr/x86_64-w64-mingw32/bin"
     "${WINCROSSBUILD}"
-    "${WINCROSSBUILD}/KFZippa"
     "${WINCROSSBUILD}/MiniXLSX"
 )
 
@@ -1,12 +1,20 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <optional>
 #include <vector>
+#include <memory>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
 #include "Types.hpp"
 
 namespace cc::neolux::utils::MiniXLSX
 {
+    class XLArchive;
+
     class MiniXLSX
     {
     public:
@@ -14,17 +22,55 @@ namespace cc::neolux::utils::MiniXLSX
         ~MiniXLSX();
 
         bool open(const std::string& path);
+        // 从内存缓冲区打开，不访问文件系统
+        bool open(std::span<const std::byte> data);
         void close();
         bool isOpen() const;
 
         std::optional<std::string> getCellValue(unsigned int sheetIndex, const std::string& ref) const;
+        // 不复制的文本视图，在下一次读取或修改前有效
+        std::optional<std::string_view> getCellText(unsigned int sheetIndex, const std::string& ref) const;
+        std::optional<std::string_view> getCellText(unsigned int sheetIndex, uint32_t row, uint16_t column) const;
+        // 按类型读取，数值不经格式化；文本视图在下一次读取或修改前有效
+        std::optional<CellValueView> getValue(unsigned int sheetIndex, const std::string& ref) const;
+        std::optional<CellValueView> getValue(unsigned int sheetIndex, uint32_t row, uint16_t column) const;
+        template <typename T>
+        std::optional<T> get(unsigned int sheetIndex, const std::string& ref) const
+        {
+            auto value = getValue(sheetIndex, ref);
+            return value ? cellValueAs<T>(*value) : std::nullopt;
+        }
+        template <typename T>
+        std::optional<T> get(unsigned int sheetIndex, uint32_t row, uint16_t column) const
+        {
+            auto value = getValue(sheetIndex, row, column);
+            return value ? cellValueAs<T>(*value) : std::nullopt;
+        }
         bool setCellValue(unsigned int sheetIndex, const std::string& ref, const std::string& value);
         bool setCellStyle(unsigned int sheetIndex, const std::string& ref, const CellStyle& style);
-        bool save();
+        // 按行列号访问（行、列均从 1 开始），不格式化也不解析单元格地址
+        std::optional<std::string> getCellValue(unsigned int sheetIndex, uint32_t row, uint16_t column) const;
+        bool setCellValue(unsigned int sheetIndex, uint32_t row, uint16_t column, const std::string& value);
+        bool setCellStyle(unsigned int sheetIndex, uint32_t row, uint16_t column, const CellStyle& style);
+        // 一次遍历读取矩形区域（例如 "A2:Z50000"），结果连续存放
+        std::optional<CellRange> getRange(unsigned int sheetIndex, const std::string& range, RangeOrder order = RangeOrder::RowMajor) const;
+        // 一次有序遍历写入 rows x columns 区域，values 按行优先排列
+        bool setRange(unsigned int sheetIndex, const std::string& topLeft, uint32_t rows, uint16_t columns, std::span<const CellValue> values);
+        bool setRange(unsigned int sheetIndex, uint32_t row, uint16_t column, uint32_t rows, uint16_t columns, std::span<const CellValue> values);
+        // 一次有序遍历为区域（例如 "A1:H5000"）应用样式，每种基础格式只解析一次目标格式
+        bool setRangeStyle(unsigned int sheetIndex, const std::string& range, const CellStyle& style);
+        // options 指定压缩级别与按内容类型的压缩策略，例如图片不压缩、工作表快速压缩
+        bool save(const SaveOptions& options = {});
+        // 不经过文件系统输出：按顺序写入回调、内存缓冲区或输出流
+        bool save(const SaveCallback& write, const SaveOptions& options = {});
+        bool save(std::vector<std::byte>& out, const SaveOptions& options = {});
+        bool save(std::ostream& out, const SaveOptions& options = {});
 
         std::vector<PictureInfo> getPictures(unsigned int sheetIndex) const;
 
     private:
+        bool openArchive(std::shared_ptr<XLArchive> archive);
+
         struct Impl;
         Impl* impl_;
     };
@@ -2,29 +2,112 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <optional>
+#include <memory>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
 #include "Types.hpp"
 
 namespace cc::neolux::utils::MiniXLSX
 {
+    class XLArchive;
+
     class OpenXLSXWrapper
     {
     public:
+        /**
+         * @brief 按行优先顺序遍历工作表中有值的单元格。
+         *
+         * 游标记住当前所在的行与单元格节点，每次前进只访问相邻节点，遍历整张表的开销与单元格数成正比；
+         * 不存在的单元格直接跳过，不会被创建。文档关闭或工作表结构变化后游标失效。
+         */
+        class CellCursor
+        {
+        public:
+            CellCursor();
+            ~CellCursor();
+            CellCursor(const CellCursor& other);
+            CellCursor& operator=(const CellCursor& other);
+
+            /**
+             * @brief 前进到下一个有值的单元格。
+             * @return 没有更多单元格时返回 false。
+             */
+            bool next();
+
+            /**
+             * @brief 当前单元格，文本视图在前进到下一个单元格前有效。
+             */
+            const SheetCell& cell() const;
+
+        private:
+            friend class OpenXLSXWrapper;
+            struct Impl;
+            Impl* impl_;
+        };
+
         OpenXLSXWrapper();
         ~OpenXLSXWrapper();
 
         bool open(const std::string& path);
+        // 从内存缓冲区打开，不访问文件系统；保存需调用 saveAs
+        bool open(std::span<const std::byte> data);
+        // 基于已打开的共享压缩包打开，不再重复读取与解压文件
+        bool open(std::shared_ptr<XLArchive> archive);
         void close();
         bool isOpen() const;
 
         unsigned int sheetCount() const;
-        std::string sheetName(unsigned int index) const;
+        // 名称来自打开后构建一次的缓存，返回的引用在关闭或重新打开文档前有效；越界时为空串
+        const std::string& sheetName(unsigned int index) const;
         std::optional<unsigned int> sheetIndex(const std::string& sheetName) const;
 
         std::optional<std::string> getCellValue(unsigned int sheetIndex, const std::string& ref) const;
+        // 不复制的文本视图，指向共享字符串缓存或 XML 文本（数值为原始文本），在下一次读取或修改前有效；不存在的单元格为空视图
+        std::optional<std::string_view> getCellText(unsigned int sheetIndex, const std::string& ref) const;
+        std::optional<std::string_view> getCellText(unsigned int sheetIndex, uint32_t row, uint16_t column) const;
+        // 按类型读取，数值不经格式化；不存在的单元格为 std::monostate，文本视图在下一次读取或修改前有效
+        std::optional<CellValueView> getValue(unsigned int sheetIndex, const std::string& ref) const;
+        std::optional<CellValueView> getValue(unsigned int sheetIndex, uint32_t row, uint16_t column) const;
+        // 读取并转换为 T（规则见 cellValueAs），单元格为空或类型不符时返回 std::nullopt
+        template <typename T>
+        std::optional<T> get(unsigned int sheetIndex, const std::string& ref) const
+        {
+            auto value = getValue(sheetIndex, ref);
+            return value ? cellValueAs<T>(*value) : std::nullopt;
+        }
+        template <typename T>
+        std::optional<T> get(unsigned int sheetIndex, uint32_t row, uint16_t column) const
+        {
+            auto value = getValue(sheetIndex, row, column);
+            return value ? cellValueAs<T>(*value) : std::nullopt;
+        }
         bool setCellValue(unsigned int sheetIndex, const std::string& ref, const std::string& value);
         bool setCellStyle(unsigned int sheetIndex, const std::string& ref, const CellStyle& style);
-        bool save();
+        // 按行列号访问（行、列均从 1 开始），不格式化也不解析单元格地址
+        std::optional<std::string> getCellValue(unsigned int sheetIndex, uint32_t row, uint16_t column) const;
+        bool setCellValue(unsigned int sheetIndex, uint32_t row, uint16_t column, const std::string& value);
+        bool setCellStyle(unsigned int sheetIndex, uint32_t row, uint16_t column, const CellStyle& style);
+        // 行优先遍历工作表中有值的单元格，先调用 next() 再读取 cell()；序号无效时游标为空
+        CellCursor cellCursor(unsigned int sheetIndex) const;
+        // 一次遍历读取矩形区域（例如 "A2:Z50000"）的全部单元格，不存在的单元格为 Empty
+        std::optional<CellRange> getRange(unsigned int sheetIndex, const std::string& range, RangeOrder order = RangeOrder::RowMajor) const;
+        // 一次有序遍历写入以 topLeft 为左上角的 rows x columns 区域，values 按行优先排列；std::monostate 清空单元格的值
+        bool setRange(unsigned int sheetIndex, const std::string& topLeft, uint32_t rows, uint16_t columns, std::span<const CellValue> values);
+        bool setRange(unsigned int sheetIndex, uint32_t row, uint16_t column, uint32_t rows, uint16_t columns, std::span<const CellValue> values);
+        // 一次有序遍历为区域（例如 "A1:H5000"）应用样式，每种基础格式只解析一次目标格式
+        bool setRangeStyle(unsigned int sheetIndex, const std::string& range, const CellStyle& style);
+        // options 指定压缩级别与按内容类型的压缩策略
+        bool save(const SaveOptions& options = {});
+        bool saveAs(const std::string& path, const SaveOptions& options = {});
+        // 不经过文件系统输出：按顺序写入回调、内存缓冲区或输出流
+        bool saveAs(const SaveCallback& write, const SaveOptions& options = {});
+        bool saveAs(std::vector<std::byte>& out, const SaveOptions& options = {});
+        bool saveAs(std::ostream& out, const SaveOptions& options = {});
 
     private:
         struct Impl;
@@ -1,6 +1,17 @@
 #pragma once
 #include <string>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string_view>
 #include <vector>
+#include <variant>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
 
 namespace cc::neolux::utils::MiniXLSX
 {
@@ -18,6 +29,159 @@ namespace cc::neolux::utils::MiniXLSX
         std::string relativePath; // 图片相对于临时目录的路径，如 "media/image1.jpg"
     };
 
+    /**
+     * @brief 写入单元格的值。std::monostate 表示空单元格（不写出）。
+     */
+    using CellValue = std::variant<std::monostate, std::string, int64_t, double, bool>;
+
+    /**
+     * @brief 单元格中的错误值，如 "#DIV/0!"。
+     */
+    struct CellError {
+        std::string_view code;
+    };
+
+    /**
+     * @brief 按类型读取到的单元格值。std::monostate 表示空单元格。
+     * @note 数值不经格式化直接解析；文本视图指向文档内部数据，在下一次读取或修改文档前有效。
+     */
+    using CellValueView = std::variant<std::monostate, int64_t, double, bool, std::string_view, CellError>;
+
+    /**
+     * @brief 遍历工作表时得到的单元格。
+     */
+    struct SheetCell {
+        uint32_t row = 0;       // 行号，从 1 开始
+        uint16_t column = 0;    // 列号，从 1 开始
+        CellValueView value;
+    };
+
+    /**
+     * @brief 将按类型读取的值转换为 T。
+     * @tparam T 整数与浮点类型接受任一数值（整数类型要求值为范围内的整数）；bool、CellError 只接受同类型；
+     *           std::string_view 与 std::string 接受文本。
+     * @return 类型不匹配时返回 std::nullopt。
+     */
+    template <typename T>
+    std::optional<T> cellValueAs(const CellValueView& value)
+    {
+        if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, CellError>) {
+            if (const auto* v = std::get_if<T>(&value)) return *v;
+        } else if constexpr (std::is_integral_v<T>) {
+            if (const auto* v = std::get_if<int64_t>(&value)) {
+                if (std::in_range<T>(*v)) return static_cast<T>(*v);
+            } else if (const auto* d = std::get_if<double>(&value)) {
+                // 上界 2^digits 可精确表示，避免 max() 转为 double 时向上取整
+                if (std::trunc(*d) == *d && *d >= static_cast<double>(std::numeric_limits<T>::min()) &&
+                    *d < std::ldexp(1.0, std::numeric_limits<T>::digits))
+                    return static_cast<T>(*d);
+            }
+        } else if constexpr (std::is_floating_point_v<T>) {
+            if (const auto* v = std::get_if<double>(&value)) return static_cast<T>(*v);
+            if (const auto* v = std::get_if<int64_t>(&value)) return static_cast<T>(*v);
+        } else if constexpr (std::is_same_v<T, std::string_view> || std::is_same_v<T, std::string>) {
+            if (const auto* v = std::get_if<std::string_view>(&value)) return T(*v);
+        } else {
+            static_assert(std::is_same_v<T, void>, "unsupported cell value type");
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief 读取到的单元格类型。
+     */
+    enum class CellKind {
+        String,   // 共享字符串、内联字符串、公式字符串结果与日期文本
+        Number,   // 数值，value 为原始数字文本
+        Boolean,  // 布尔值，value 为 "0" 或 "1"
+        Error,    // 错误值，如 "#DIV/0!"
+        Empty     // 不存在或没有值的单元格（仅出现在区域读取结果中）
+    };
+
+    /**
+     * @brief 流式读取时的单元格视图，value 只在读取下一行之前有效。
+     */
+    struct RowCell {
+        uint32_t column;          // 列号，从 1 开始
+        CellKind kind;
+        std::string_view value;   // 已解码的文本，共享字符串已解析
+    };
+
+    /**
+     * @brief 区域读取结果的排列顺序。
+     */
+    enum class RangeOrder {
+        RowMajor,     // 逐行排列，同一行的单元格相邻
+        ColumnMajor   // 逐列排列，同一列的单元格相邻
+    };
+
+    /**
+     * @brief 区域读取结果中的单元格。
+     */
+    struct RangeCell {
+        CellKind kind = CellKind::Empty;
+        double number = 0;     // Number 的数值；Boolean 为 0 或 1
+        uint32_t offset = 0;   // String 与 Error 的文本在 CellRange::text 中的位置
+        uint32_t length = 0;
+    };
+
+    /**
+     * @brief 矩形区域的读取结果，单元格连续存放，文本集中存放在 text 中。
+     */
+    struct CellRange {
+        uint32_t firstRow = 0;      // 左上角行号，从 1 开始
+        uint32_t firstColumn = 0;   // 左上角列号，从 1 开始
+        uint32_t rows = 0;
+        uint32_t columns = 0;
+        RangeOrder order = RangeOrder::RowMajor;
+        std::vector<RangeCell> cells;   // rows * columns 个，按 order 排列
+        std::string text;               // 所有文本值首尾相接存放
+
+        /**
+         * @brief 单元格在 cells 中的下标，行列号为工作表中的绝对位置。
+         */
+        std::size_t index(uint32_t row, uint32_t column) const
+        {
+            std::size_t r = row - firstRow;
+            std::size_t c = column - firstColumn;
+            return order == RangeOrder::RowMajor ? r * columns + c : c * rows + r;
+        }
+
+        const RangeCell& at(uint32_t row, uint32_t column) const { return cells[index(row, column)]; }
+
+        /**
+         * @brief 文本类单元格的内容，其他类型返回空视图。
+         */
+        std::string_view textOf(const RangeCell& cell) const { return std::string_view(text).substr(cell.offset, cell.length); }
+    };
+
+    /**
+     * @brief 保存时的压缩级别。
+     */
+    enum class CompressionLevel {
+        Store = 0,    // 不压缩，适合已压缩的图片等媒体
+        Fast = 1,     // 最快的 deflate
+        Default = 6,  // miniz 默认级别
+        Max = 9       // 压缩率最高，速度最慢
+    };
+
+    /**
+     * @brief 保存选项。
+     * @note 有规则（全局级别或匹配的内容类型）的条目即使未修改也按该级别重新压缩；
+     *       没有任何规则适用的未修改条目直接复制原压缩数据，修改过的条目使用 Default。
+     */
+    struct SaveOptions {
+        std::optional<CompressionLevel> level;  // 全局压缩级别，未设置时不作为规则
+        // 按内容类型（[Content_Types].xml 中的 ContentType）覆盖压缩级别，
+        // 键可以是完整类型如 "image/png"，也可以是 "image/*" 匹配整类
+        std::map<std::string, CompressionLevel> contentTypeLevels;
+    };
+
+    /**
+     * @brief 保存时按顺序接收文件内容的回调，返回 false 中止保存。
+     */
+    using SaveCallback = std::function<bool(const char* data, std::size_t size)>;
+
     enum class CellBorderStyle {
         None = 0,
         Thin,
@@ -0,0 +1,181 @@
+// XLArchive —— XLDocument 内各组件共享的 XLSX 压缩包
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <optional>
+#include <vector>
+#include <span>
+#include <cstddef>
+#include <functional>
+#include <filesystem>
+#include <iosfwd>
+#include "Types.hpp"
+
+namespace cc::neolux::utils::MiniXLSX
+{
+    /**
+     * @brief 对 .xlsx 压缩包的单一读取层。
+     *
+     * 文件只读取一次，每个条目在首次访问时解压并缓存，之后 OpenXLSX、图片读取器
+     * 与旧版 XLSheet 解析路径都从同一份数据读取。对象通过 std::shared_ptr 在各组件间共享。
+     */
+    class XLArchive
+    {
+    public:
+        XLArchive();
+        ~XLArchive();
+
+        XLArchive(const XLArchive&) = delete;
+        XLArchive& operator=(const XLArchive&) = delete;
+
+        /**
+         * @brief 打开 XLSX 文件并读取条目索引。
+         * @param path XLSX 文件路径。
+         * @return 成功返回 true，否则返回 false。
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief 从内存缓冲区打开 XLSX，不访问文件系统。
+         * @param data XLSX 文件内容，打开时复制，调用方之后可释放。
+         * @return 成功返回 true，否则返回 false。
+         * @note 此时 path() 为空，保存需通过 save(path) 指定目标路径。
+         */
+        bool open(std::span<const std::byte> data);
+
+        /**
+         * @brief 关闭压缩包并释放缓存的条目数据。
+         */
+        void close();
+
+        /**
+         * @brief 判断压缩包是否已打开。
+         * @return 已打开返回 true，否则返回 false。
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief 获取压缩包当前对应的文件路径。
+         * @return 文件路径。
+         */
+        const std::string& path() const;
+
+        /**
+         * @brief 判断是否存在指定条目（例如 "xl/workbook.xml"）。
+         * @param name 条目名称。
+         * @return 存在返回 true，否则返回 false。
+         */
+        bool hasEntry(const std::string& name) const;
+
+        /**
+         * @brief 列出所有文件条目（不含目录）。
+         * @return 条目名称列表。
+         */
+        std::vector<std::string> entryNames() const;
+
+        /**
+         * @brief 读取条目内容，首次访问时解压，之后直接使用缓存。
+         * @param name 条目名称。
+         * @return 条目内容，若不存在则返回 std::nullopt。
+         */
+        std::optional<std::string> getEntry(const std::string& name) const;
+
+        /**
+         * @brief 零拷贝读取条目内容，不解压也不缓存。
+         *
+         * 仅适用于以存储方式（未压缩）保存且未修改的条目，例如 xl/media 下的图片。
+         * 返回的视图直接指向内存映射或内存缓冲区，在压缩包关闭或保存前有效。
+         * @param name 条目名称。
+         * @return 条目内容视图；条目不存在或无法零拷贝时返回 std::nullopt，此时应改用 getEntry()。
+         */
+        std::optional<std::string_view> getEntryView(const std::string& name) const;
+
+        /**
+         * @brief 以流方式读取条目，边读边解压，不解压整个条目也不缓存。
+         *
+         * 适用于大型工作表等无法整体放入内存的条目。读取期间压缩包不能关闭或保存。
+         * @param name 条目名称。
+         * @return 读取函数：向缓冲区写入后续内容并返回写入的字节数，返回 0 表示读取完毕；
+         *         条目不存在或无法打开时返回空的 std::function。
+         */
+        std::function<size_t(char*, size_t)> openEntryStream(const std::string& name) const;
+
+        /**
+         * @brief 写入（新增或替换）条目内容，保存时生效。
+         * @param name 条目名称。
+         * @param data 条目内容。
+         */
+        void setEntry(const std::string& name, const std::string& data);
+
+        /**
+         * @brief 删除条目，保存时生效。
+         * @param name 条目名称。
+         */
+        void deleteEntry(const std::string& name);
+
+        /**
+         * @brief 将压缩包（含所有修改）写入指定路径，之后压缩包对应该路径。
+         * @param path 目标 XLSX 文件路径。
+         * @param options 压缩级别与按内容类型的压缩策略。
+         * @return 成功返回 true，否则返回 false。
+         */
+        bool save(const std::string& path, const SaveOptions& options = {});
+
+        /**
+         * @brief 将压缩包按顺序写入回调，不访问文件系统，适合直接写入网络连接。
+         * @param write 接收文件内容的回调，返回 false 时中止保存。
+         * @param options 压缩级别与按内容类型的压缩策略。
+         * @return 成功返回 true，否则返回 false。
+         * @note 压缩包仍对应原来的来源，修改保留在内存中。
+         */
+        bool save(const SaveCallback& write, const SaveOptions& options = {});
+
+        /**
+         * @brief 将压缩包写入内存缓冲区。
+         * @param out 输出缓冲区，原有内容会被替换。
+         * @param options 压缩级别与按内容类型的压缩策略。
+         * @return 成功返回 true，否则返回 false。
+         */
+        bool save(std::vector<std::byte>& out, const SaveOptions& options = {});
+
+        /**
+         * @brief 将压缩包写入输出流。
+         * @param out 输出流，应以二进制模式打开。
+         * @param options 压缩级别与按内容类型的压缩策略。
+         * @return 成功返回 true，否则返回 false。
+         */
+        bool save(std::ostream& out, const SaveOptions& options = {});
+
+        /**
+         * @brief 将所有条目解压写入指定目录（保持压缩包内的目录结构）。
+         * @param dir 目标目录。
+         * @return 成功返回 true，否则返回 false。
+         */
+        bool extractTo(const std::string& dir) const;
+
+        /**
+         * @brief 将单个条目解压写入指定目录（保持压缩包内的目录结构）。
+         * @param name 条目名称。
+         * @param dir 目标目录。
+         * @return 成功返回 true，否则返回 false。
+         */
+        bool extractEntry(const std::string& name, const std::string& dir) const;
+
+        /**
+         * @brief 计算条目解压到指定目录时的目标路径。
+         *
+         * 条目名称先规范化；含 ".." 组成部分、为绝对路径或规范化后不在 dir 之下的名称被拒绝，
+         * 防止恶意压缩包将文件写到目录之外（zip slip）。
+         * @param name 条目名称。
+         * @param dir 目标目录。
+         * @return 目标文件路径；名称不安全时返回空路径。
+         */
+        static std::filesystem::path entryPath(const std::string& name, const std::filesystem::path& dir);
+
+    private:
+        struct Impl;
+        Impl* impl_;
+    };
+
+} // namespace cc::neolux::utils::MiniXLSX
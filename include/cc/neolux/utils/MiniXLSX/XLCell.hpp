@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 namespace cc::neolux::utils::MiniXLSX
 {
@@ -11,11 +12,21 @@ public:
     XLCell(const std::string& ref) : reference(ref) {}
     virtual ~XLCell() = default;
     virtual std::string getValue() const = 0;
+    // 不复制的值视图，在单元格或文档下一次修改前有效
+    // 默认实现缓存一份 getValue() 的结果，视图在下一次调用前有效；子类可覆盖以直接指向自身存储
+    virtual std::string_view getValueView() const
+    {
+        valueCache = getValue();
+        return valueCache;
+    }
     virtual std::string getType() const = 0;
     const std::string& getReference() const { return reference; }
 
 protected:
     std::string reference;
+
+private:
+    mutable std::string valueCache; // getValueView 默认实现使用
 };
 
 } // namespace cc::neolux::utils::MiniXLSX
\ No newline at end of file
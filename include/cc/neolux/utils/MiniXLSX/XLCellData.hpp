@@ -12,6 +12,7 @@ class XLCellData : public XLCell
 public:
     XLCellData(const std::string& ref, const std::string& val, const std::string& typ, const std::vector<std::string>& sharedStrs);
     std::string getValue() const override;
+    std::string_view getValueView() const override;
     std::string getType() const override;
     void setValue(const std::string& val);
     void setType(const std::string& typ);
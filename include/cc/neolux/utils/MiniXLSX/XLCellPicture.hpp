@@ -11,6 +11,7 @@ class XLCellPicture : public XLCell
 public:
     XLCellPicture(const std::string& ref, const std::string& fileName, const std::string& relPath);
     std::string getValue() const override;
+    std::string_view getValueView() const override;
     std::string getType() const override;
     const std::string& getImageFileName() const;
     const std::string& getRelativePath() const;
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace cc::neolux::utils::MiniXLSX
+{
+
+/**
+ * @brief 紧凑的单元格存储。
+ *
+ * 单元格按 (行, 列) 打包为 64 位键，存放在按键排序的连续数组中，遍历即为行优先顺序；
+ * 值为带类型标签的联合体，文本统一存放在工作表级的字符串池中，每个单元格不再单独分配内存。
+ */
+class XLCellStore
+{
+public:
+    /**
+     * @brief 单元格值的类型标签。
+     */
+    enum class Kind : uint8_t {
+        Empty,          // 没有值的单元格（例如只带样式）
+        Number,         // 数值，t="n"
+        SharedString,   // 共享字符串索引，t="s"
+        String,         // 公式字符串结果或普通文本，t="str"
+        InlineString,   // 内联字符串，t="inlineStr"
+        Boolean,        // 布尔值，t="b"
+        Error,          // 错误值，t="e"
+        Date,           // ISO 8601 日期文本，t="d"
+        Picture         // 图片锚点，index 为图片序号
+    };
+
+    /**
+     * @brief 单个单元格，共 24 字节。
+     */
+    struct Slot {
+        uint64_t key = 0;         // (行 << 32) | 列，行列均从 1 开始
+        Kind kind = Kind::Empty;
+        uint32_t style = 0;       // 样式索引（s 属性），0 为默认样式
+        union {
+            double number;
+            uint32_t index;       // 共享字符串或图片序号
+            bool boolean;
+            struct {
+                uint32_t offset;  // 字符串池中的起始位置
+                uint32_t length;
+            } text;
+        };
+
+        Slot() : number(0) {}
+        uint32_t row() const { return static_cast<uint32_t>(key >> 32); }
+        uint32_t column() const { return static_cast<uint32_t>(key & 0xFFFFFFFFu); }
+    };
+
+    using const_iterator = std::vector<Slot>::const_iterator;
+
+    /**
+     * @brief 将行列打包为键，键的大小顺序即行优先顺序。
+     */
+    static uint64_t makeKey(uint32_t row, uint32_t column) { return (static_cast<uint64_t>(row) << 32) | column; }
+
+    /**
+     * @brief 解析单元格引用（例如 "B12"，允许 "$B$12"）。
+     * @param ref 单元格引用。
+     * @param row 输出行号，从 1 开始。
+     * @param column 输出列号，从 1 开始。
+     * @return 格式正确返回 true，否则返回 false。
+     */
+    static bool parseReference(std::string_view ref, uint32_t& row, uint32_t& column);
+
+    /**
+     * @brief 由行列生成单元格引用，例如 (12, 2) -> "B12"。
+     */
+    static std::string makeReference(uint32_t row, uint32_t column);
+
+    /**
+     * @brief 类型标签对应的 t 属性值，Empty 与 Picture 返回空串。
+     */
+    static std::string_view typeName(Kind kind);
+
+    /**
+     * @brief 写入（新增或替换）单元格。
+     * @param row 行号，从 1 开始。
+     * @param column 列号，从 1 开始。
+     * @param value 单元格 XML 中的原始值（共享字符串为索引）。
+     * @param type t 属性值，空串视为数值；无法按该类型解析的值保存为文本。
+     * @param style 样式索引。
+     * @return 写入后的单元格。
+     */
+    const Slot& set(uint32_t row, uint32_t column, std::string_view value, std::string_view type, uint32_t style = 0);
+
+    /**
+     * @brief 写入图片锚点单元格。
+     * @param index 图片序号，由调用方维护对应的图片列表。
+     */
+    const Slot& setPicture(uint32_t row, uint32_t column, uint32_t index);
+
+    /**
+     * @brief 查找单元格。
+     * @return 单元格指针，不存在时返回 nullptr；指针在下一次写入前有效。
+     */
+    const Slot* find(uint32_t row, uint32_t column) const;
+
+    /**
+     * @brief 文本类单元格在字符串池中的内容，视图在下一次写入前有效。
+     */
+    std::string_view text(const Slot& slot) const;
+
+    /**
+     * @brief 单元格 XML 中 <v> 的原始值（共享字符串为索引，布尔值为 "0"/"1"）。
+     */
+    std::string rawValue(const Slot& slot) const;
+
+    /**
+     * @brief 单元格的显示值，共享字符串按给定表解析。
+     */
+    std::string value(const Slot& slot, const std::vector<std::string>& sharedStrings) const;
+
+    size_t size() const { return slots.size() + pending.size(); }
+    bool empty() const { return size() == 0; }
+    void clear();
+
+    /**
+     * @brief 按行优先顺序遍历全部单元格。
+     */
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    Slot* findSlot(uint64_t key) const;
+    Slot& insert(uint64_t key);
+    void assignText(Slot& slot, std::string_view value);
+    void releaseText(const Slot& slot);
+    void mergePending() const;
+    void compactArena();
+
+    mutable std::vector<Slot> slots;     // 按键排序
+    mutable std::vector<Slot> pending;   // 乱序写入的单元格，累积到一定数量或遍历时再合并
+    std::string arena;                   // 所有文本值首尾相接存放
+    size_t deadBytes = 0;                // 字符串池中已被覆盖的字节数
+};
+
+} // namespace cc::neolux::utils::MiniXLSX
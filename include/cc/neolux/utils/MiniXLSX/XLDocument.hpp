@@ -3,7 +3,11 @@
 #include <string>
 #include <filesystem>
 #include <map>
+#include <memory>
+#include <span>
+#include <cstddef>
 #include <vector>
+#include <iosfwd>
 #include "XLWorkbook.hpp"
 #include "OpenXLSXWrapper.hpp"
 #include "XLPictureReader.hpp"
@@ -11,16 +15,30 @@
 namespace cc::neolux::utils::MiniXLSX
 {
 
+class XLArchive;
+
 class XLDocument
 {
 private:
-    std::filesystem::path tempDir;
+    // 临时目录按需创建；tempDirExtracted 表示已完整导出
+    mutable std::filesystem::path tempDir;
+    mutable bool tempDirExtracted;
     bool isOpen;
     bool isModified;
     std::string xlsxPath;
     XLWorkbook* workbook;
     std::unique_ptr<OpenXLSXWrapper> oxwrapper;
     std::unique_ptr<XLPictureReader> pictureReader;
+    std::shared_ptr<XLArchive> archive;
+
+    // 按需创建唯一的临时目录
+    bool ensureTempDir() const;
+
+    // 基于已打开的压缩包初始化封装、图片读取器与工作簿
+    bool loadArchive();
+
+    // 将工作簿修改写回并输出到指定路径
+    bool writeTo(const std::string& xlsxPath, const SaveOptions& options);
 
 public:
     XLDocument();
@@ -32,13 +50,24 @@ public:
     // 获取图片读取器（可选）
     XLPictureReader* getPictureReader() const;
 
+    // 获取文档共享的压缩包，各组件从中读取条目
+    XLArchive* getArchive() const;
+
     /**
-        * @brief 打开 XLSX 文件并解压到临时目录。
+        * @brief 打开 XLSX 文件，压缩包只读取一次并在各组件间共享。
         * @param xlsxPath XLSX 文件路径。
         * @return 成功返回 true，否则返回 false。
      */
     bool open(const std::string& xlsxPath);
 
+    /**
+        * @brief 从内存缓冲区打开 XLSX，全程不访问文件系统，也不创建临时目录。
+        * @param data XLSX 文件内容，打开时复制，调用方之后可释放。
+        * @return 成功返回 true，否则返回 false。
+        * @note 文档没有对应文件路径，保存需调用 saveAs()。
+     */
+    bool open(std::span<const std::byte> data);
+
     /**
         * @brief 创建一个包含基础结构的 XLSX 文件。
         * @param xlsxPath 新文件路径。
@@ -65,10 +94,20 @@ public:
 
     /**
         * @brief 获取 XLSX 解压后的临时目录路径。
-        * @return 临时目录路径。
+        *
+        * 打开文档时不再解压；首次调用本函数时才将全部条目导出到临时目录。
+        * 只需要个别文件时请使用 extractEntry()。
+        * @return 临时目录路径；从内存打开时为空。
      */
     const std::filesystem::path& getTempDir() const;
 
+    /**
+        * @brief 按需将单个条目解压到临时目录，其余条目不受影响。
+        * @param entryName 条目名称，例如 "xl/media/image1.png"。
+        * @return 解压后的文件路径；条目不存在或失败时返回空路径。
+     */
+    std::filesystem::path extractEntry(const std::string& entryName) const;
+
     /**
         * @brief 获取当前文档的工作簿。
         * @return 工作簿引用。
@@ -79,15 +118,42 @@ public:
     /**
         * @brief 另存为指定路径。
         * @param xlsxPath 目标 XLSX 文件路径。
+        * @param options 压缩级别与按内容类型的压缩策略。
+        * @return 成功返回 true，否则返回 false。
+     */
+    bool saveAs(const std::string& xlsxPath, const SaveOptions& options = {});
+
+    /**
+        * @brief 将文档按顺序写入回调，不访问文件系统，适合直接写入网络连接。
+        * @param write 接收文件内容的回调，返回 false 时中止保存。
+        * @param options 压缩级别与按内容类型的压缩策略。
+        * @return 成功返回 true，否则返回 false。
+        * @note 文档路径与修改状态保持不变。
+     */
+    bool saveAs(const SaveCallback& write, const SaveOptions& options = {});
+
+    /**
+        * @brief 将文档写入内存缓冲区。
+        * @param out 输出缓冲区，原有内容会被替换。
+        * @param options 压缩级别与按内容类型的压缩策略。
+        * @return 成功返回 true，否则返回 false。
+     */
+    bool saveAs(std::vector<std::byte>& out, const SaveOptions& options = {});
+
+    /**
+        * @brief 将文档写入输出流。
+        * @param out 输出流，应以二进制模式打开。
+        * @param options 压缩级别与按内容类型的压缩策略。
         * @return 成功返回 true，否则返回 false。
      */
-    bool saveAs(const std::string& xlsxPath);
+    bool saveAs(std::ostream& out, const SaveOptions& options = {});
 
     /**
         * @brief 若已修改则保存文档。
+        * @param options 压缩级别与按内容类型的压缩策略。
         * @return 成功返回 true，否则返回 false。
      */
-    bool save();
+    bool save(const SaveOptions& options = {});
 
     /**
         * @brief 标记文档已修改。
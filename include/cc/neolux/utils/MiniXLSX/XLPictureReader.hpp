@@ -3,11 +3,14 @@
 #include <string>
 #include <vector>
 #include <optional>
+#include <memory>
 #include <cstdint>
 #include "Types.hpp"
 
 namespace cc::neolux::utils::MiniXLSX
 {
+    class XLArchive;
+
     class XLPictureReader
     {
     public:
@@ -16,6 +19,8 @@ namespace cc::neolux::utils::MiniXLSX
 
         bool open(const std::string& xlsxPath);
         bool attach(const std::string& xlsxPath, const std::string& tempDir);
+        // 绑定到共享压缩包，drawing 与图片数据直接从中读取
+        bool attach(std::shared_ptr<XLArchive> archive);
         void close();
         bool isOpen() const;
 
@@ -33,6 +38,7 @@ namespace cc::neolux::utils::MiniXLSX
         std::vector<SheetPicture> parseDrawingXMLForSheetPictures(const std::string& drawingPath) const;
 
         std::string openedPath;
+        std::shared_ptr<XLArchive> archive;
         mutable std::string tempDir;
         bool ownsTempDir = false;
         bool attached = false;
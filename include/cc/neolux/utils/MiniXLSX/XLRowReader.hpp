@@ -0,0 +1,113 @@
+// XLRowReader —— 按行流式读取工作表，不构建 DOM
+#pragma once
+
+#include <string>
+#include <memory>
+#include <span>
+#include <cstdint>
+#include "Types.hpp"
+
+namespace cc::neolux::utils::MiniXLSX
+{
+    class XLArchive;
+
+    /**
+     * @brief 拉取式的工作表行读取器。
+     *
+     * 工作表条目边解压边解析，只识别 <row>/<c>/<v>/<is> 等元素，不构建 pugixml 树；
+     * 共享字符串表在打开时读入一次，单元格值中的共享字符串索引直接解析为文本。
+     * 内存占用为共享字符串表加上当前行，与工作表行数无关，适合读取大型上传文件。
+     *
+     * @code
+     * XLRowReader reader;
+     * if (reader.open("big.xlsx", "Sheet1")) {
+     *     while (reader.next()) {
+     *         for (const RowCell& cell : reader.cells()) { ... }
+     *     }
+     * }
+     * @endcode
+     */
+    class XLRowReader
+    {
+    public:
+        XLRowReader();
+        ~XLRowReader();
+
+        XLRowReader(const XLRowReader&) = delete;
+        XLRowReader& operator=(const XLRowReader&) = delete;
+
+        /**
+         * @brief 打开 XLSX 文件中的指定工作表。
+         * @param path XLSX 文件路径。
+         * @param sheetName 工作表名称。
+         * @return 成功返回 true，否则返回 false。
+         */
+        bool open(const std::string& path, const std::string& sheetName);
+
+        /**
+         * @brief 打开 XLSX 文件中指定序号的工作表。
+         * @param path XLSX 文件路径。
+         * @param sheetIndex 工作表序号，从 0 开始。
+         * @return 成功返回 true，否则返回 false。
+         */
+        bool open(const std::string& path, unsigned int sheetIndex);
+
+        /**
+         * @brief 基于已打开的共享压缩包打开指定工作表，读取期间压缩包不能保存或关闭。
+         * @param archive 共享压缩包。
+         * @param sheetName 工作表名称。
+         * @return 成功返回 true，否则返回 false。
+         */
+        bool open(std::shared_ptr<XLArchive> archive, const std::string& sheetName);
+
+        /**
+         * @brief 基于已打开的共享压缩包打开指定序号的工作表。
+         * @param archive 共享压缩包。
+         * @param sheetIndex 工作表序号，从 0 开始。
+         * @return 成功返回 true，否则返回 false。
+         */
+        bool open(std::shared_ptr<XLArchive> archive, unsigned int sheetIndex);
+
+        /**
+         * @brief 关闭读取器并释放共享字符串表与缓冲区。
+         */
+        void close();
+
+        /**
+         * @brief 判断是否已打开工作表。
+         * @return 已打开返回 true，否则返回 false。
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief 读取下一行（只包含有值的单元格，空行同样会返回）。
+         * @return 读到一行返回 true；到达末尾或出错返回 false，出错时 hasError() 为 true。
+         */
+        bool next();
+
+        /**
+         * @brief 当前行的行号，从 1 开始。
+         * @return 行号。
+         */
+        uint32_t rowNumber() const;
+
+        /**
+         * @brief 当前行的单元格，按列顺序排列。
+         * @return 单元格视图，在下一次调用 next() 或 close() 之前有效。
+         */
+        std::span<const RowCell> cells() const;
+
+        /**
+         * @brief 判断读取过程中是否出现错误（例如数据损坏或 XML 不完整）。
+         * @return 出现错误返回 true，否则返回 false。
+         */
+        bool hasError() const;
+
+    private:
+        bool openSheet(std::shared_ptr<XLArchive> archive, const std::string* sheetName, unsigned int sheetIndex);
+
+        struct Impl;
+        Impl* impl_;
+    };
+
+} // namespace cc::neolux::utils::MiniXLSX
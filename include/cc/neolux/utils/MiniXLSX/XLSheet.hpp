@@ -1,16 +1,24 @@
 #pragma once
 
 #include <string>
-#include <map>
+#include <string_view>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 #include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
 #include "XLCell.hpp"
+#include "XLCellStore.hpp"
 #include "OpenXLSXWrapper.hpp"
 #include "XLPictureReader.hpp"
 
 namespace cc::neolux::utils::MiniXLSX
 {
     class XLWorkbook;
+    class XLCellData;
+    class XLCellPicture;
 
     class XLSheet
     {
@@ -19,12 +27,61 @@ namespace cc::neolux::utils::MiniXLSX
         std::string name;
         std::string sheetId;
         std::string rId;
-        std::map<std::string, std::unique_ptr<XLCell>> cells;
+        XLCellStore cells;
+        std::vector<std::unique_ptr<XLCellPicture>> pictures;   // 图片单元格，cells 中保存其序号
+        // getCell() 返回的单元格对象，仅为访问过的单元格创建
+        mutable std::unordered_map<uint64_t, std::unique_ptr<XLCellData>> cellViews;
         std::vector<std::string> sharedStrings;
         OpenXLSXWrapper* oxWrapper = nullptr;
         XLPictureReader* pictureReader = nullptr;
         unsigned int oxSheetIndex = 0;
         mutable bool picturesLoaded = false;
+        bool modified = false;   // 旧版解析路径下是否有未写回的修改
+
+        // 返回存储中单元格对应的 XLCell 对象，首次访问时创建
+        const XLCell* cellView(const XLCellStore::Slot& slot) const;
+        // 登记图片单元格
+        void addPicture(const std::string& ref, const std::string& fileName, const std::string& relPath);
+
+    public:
+        /**
+         * @brief 按行优先顺序遍历工作表中有值的单元格的输入迭代器。
+         *
+         * 封装模式下沿工作表 XML 逐个节点前进，不存在的单元格被跳过而不会被创建；旧版解析路径下遍历已加载的单元格。
+         */
+        class CellIterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = SheetCell;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const SheetCell*;
+            using reference = const SheetCell&;
+
+            reference operator*() const;
+            pointer operator->() const { return &**this; }
+            CellIterator& operator++();
+            bool operator==(const CellIterator& other) const;
+
+        private:
+            friend class XLSheet;
+            void advance();
+
+            const XLSheet* sheet = nullptr;
+            std::optional<OpenXLSXWrapper::CellCursor> cursor;   // 封装模式
+            XLCellStore::const_iterator slot, slotEnd;           // 旧版解析路径
+            SheetCell current;
+            bool atEnd = true;
+        };
+
+        /**
+         * @brief scanCells() 返回的单元格序列，用于范围 for。
+         */
+        struct CellScan {
+            CellIterator first;
+            CellIterator begin() const { return first; }
+            CellIterator end() const { return CellIterator(); }
+        };
 
     public:
         XLSheet(XLWorkbook& wb, const std::string& n, const std::string& sid, const std::string& rid);
@@ -50,6 +107,14 @@ namespace cc::neolux::utils::MiniXLSX
          */
         const XLCell* getCell(const std::string& ref) const;
 
+        /**
+         * @brief 通过行列号获取单元格，不格式化也不解析单元格地址。
+         * @param row 行号，从 1 开始。
+         * @param column 列号，从 1 开始。
+         * @return 单元格指针，若不存在则返回 nullptr。
+         */
+        const XLCell* getCell(uint32_t row, uint16_t column) const;
+
         /**
          * @brief 通过单元格引用获取值（例如 "A1"）。
          * @param ref 单元格引用。
@@ -57,6 +122,68 @@ namespace cc::neolux::utils::MiniXLSX
          */
         std::string getCellValue(const std::string& ref) const;
 
+        /**
+         * @brief 通过行列号获取值。
+         * @param row 行号，从 1 开始。
+         * @param column 列号，从 1 开始。
+         * @return 单元格值，若不存在则返回空字符串。
+         */
+        std::string getCellValue(uint32_t row, uint16_t column) const;
+
+        /**
+         * @brief 不复制地获取单元格文本（例如 "A1"）。
+         * @param ref 单元格引用。
+         * @return 指向共享字符串或工作表数据的视图，在下一次修改工作表前有效；不存在时返回空视图。
+         */
+        std::string_view getCellText(const std::string& ref) const;
+
+        /**
+         * @brief 通过行列号不复制地获取单元格文本。
+         * @param row 行号，从 1 开始。
+         * @param column 列号，从 1 开始。
+         */
+        std::string_view getCellText(uint32_t row, uint16_t column) const;
+
+        /**
+         * @brief 按类型读取单元格，数值不经格式化。
+         * @param ref 单元格引用（例如 "A1"）。
+         * @return 单元格值，不存在的单元格为 std::monostate；引用无效时返回 std::nullopt。文本视图在下一次读取或修改前有效。
+         */
+        std::optional<CellValueView> getValue(const std::string& ref) const;
+
+        /**
+         * @brief 按行列号与类型读取单元格。
+         * @param row 行号，从 1 开始。
+         * @param column 列号，从 1 开始。
+         */
+        std::optional<CellValueView> getValue(uint32_t row, uint16_t column) const;
+
+        /**
+         * @brief 读取并转换为 T（规则见 cellValueAs）。
+         * @return 单元格为空、类型不符或引用无效时返回 std::nullopt。
+         */
+        template <typename T>
+        std::optional<T> get(const std::string& ref) const
+        {
+            auto value = getValue(ref);
+            return value ? cellValueAs<T>(*value) : std::nullopt;
+        }
+
+        template <typename T>
+        std::optional<T> get(uint32_t row, uint16_t column) const
+        {
+            auto value = getValue(row, column);
+            return value ? cellValueAs<T>(*value) : std::nullopt;
+        }
+
+        /**
+         * @brief 一次遍历读取矩形区域的全部单元格。
+         * @param range 区域引用（例如 "A2:Z50000"），单个单元格引用视为 1x1 区域。
+         * @param order 结果按行优先或列优先排列。
+         * @return 区域读取结果，不存在的单元格为 Empty；引用无效时返回 std::nullopt。
+         */
+        std::optional<CellRange> getRange(const std::string& range, RangeOrder order = RangeOrder::RowMajor) const;
+
         /**
          * @brief 通过单元格引用设置值（例如 "A1"）。
          * @param ref 单元格引用。
@@ -65,14 +192,43 @@ namespace cc::neolux::utils::MiniXLSX
          */
         void setCellValue(const std::string& ref, const std::string& value, const std::string& type = "str");
 
+        /**
+         * @brief 通过行列号设置值，适合在循环中批量写入。
+         * @param row 行号，从 1 开始。
+         * @param column 列号，从 1 开始。
+         * @param value 要设置的值。
+         * @param type 单元格类型（"str" 表示字符串，"n" 表示数值等）。
+         */
+        void setCellValue(uint32_t row, uint16_t column, const std::string& value, const std::string& type = "str");
+
         /**
          * @brief 将工作表数据写回 XML。
          * @return 成功返回 true，否则返回 false。
          */
         bool save();
 
-        // 迭代器
-        using iterator = std::map<std::string, std::unique_ptr<XLCell>>::const_iterator;
+        /**
+         * @brief 获取遍历得到的单元格的显示值，共享字符串已解析。
+         * @param cell 由 begin()/end() 遍历得到的单元格。
+         * @return 单元格值；图片单元格返回图片文件名。
+         */
+        std::string getCellValue(const XLCellStore::Slot& cell) const;
+
+        /**
+         * @brief 按类型获取遍历得到的单元格的值。
+         * @param cell 由 begin()/end() 遍历得到的单元格。
+         * @return 单元格值；图片单元格返回图片文件名。
+         */
+        CellValueView getValue(const XLCellStore::Slot& cell) const;
+
+        /**
+         * @brief 按行优先顺序遍历工作表中全部有值的单元格（含尚未通过 getCell() 访问过的）。
+         * @return 单元格序列，文本视图在前进到下一个单元格或修改工作表前有效。
+         */
+        CellScan scanCells() const;
+
+        // 迭代器：按行优先顺序遍历已加载的单元格
+        using iterator = XLCellStore::const_iterator;
         iterator begin() const { return cells.begin(); }
         iterator end() const { return cells.end(); }
 
@@ -0,0 +1,83 @@
+// XLStreamWriter —— 只进式流式写出 XLSX，内存占用与行数无关
+#pragma once
+
+#include <string>
+#include <vector>
+#include <span>
+#include <cstdint>
+#include "Types.hpp"
+
+namespace cc::neolux::utils::MiniXLSX
+{
+    /**
+     * @brief 按行顺序流式写出 XLSX 文件。
+     *
+     * 每行的 <row>/<c> XML 直接写入输出压缩包中工作表条目的 deflate 流，不构建 DOM；
+     * 共享字符串暂存到临时文件，其余部件（workbook、styles、关系与内容类型等）在 close() 时写出。
+     * 峰值内存只取决于缓冲区大小与有上限的字符串去重表，与行数无关。
+     *
+     * 行必须按递增顺序写入，已写出的行与工作表不能再修改。
+     * 不支持 zip64，单个条目与整个文件均需小于 4 GiB。
+     */
+    class XLStreamWriter
+    {
+    public:
+        XLStreamWriter();
+        /**
+         * @brief 析构时若仍处于打开状态，会调用 close() 完成写出。
+         */
+        ~XLStreamWriter();
+
+        XLStreamWriter(const XLStreamWriter&) = delete;
+        XLStreamWriter& operator=(const XLStreamWriter&) = delete;
+
+        /**
+         * @brief 创建输出文件（已存在则覆盖）。
+         * @param path 目标 XLSX 文件路径。
+         * @return 成功返回 true，否则返回 false。
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief 开始写一个新工作表，之前的工作表随之结束。
+         * @param name 工作表名称，不超过 31 个字符，不能包含 []:*?/\ 且不能重名（不区分大小写）。
+         * @return 成功返回 true，否则返回 false。
+         */
+        bool addSheet(const std::string& name);
+
+        /**
+         * @brief 在当前工作表末尾追加一行，从 A 列开始。
+         * @param cells 单元格值，std::monostate 表示跳过该单元格。
+         * @return 成功返回 true，否则返回 false。
+         * @note 若尚未调用 addSheet()，自动创建名为 "Sheet1" 的工作表。
+         */
+        bool appendRow(std::span<const CellValue> cells);
+        bool appendRow(const std::vector<CellValue>& cells);
+
+        /**
+         * @brief 写入指定行号（从 1 开始）的一行，中间跳过的行保持为空。
+         * @param rowNumber 行号，必须大于上一次写入的行号。
+         * @param cells 单元格值，从 A 列开始。
+         * @return 成功返回 true，否则返回 false。
+         */
+        bool writeRow(uint32_t rowNumber, std::span<const CellValue> cells);
+        bool writeRow(uint32_t rowNumber, const std::vector<CellValue>& cells);
+
+        /**
+         * @brief 结束当前工作表，写出共享字符串及其余部件并关闭文件。
+         * @return 成功返回 true，否则返回 false。
+         */
+        bool close();
+
+        /**
+         * @brief 判断是否处于打开状态。
+         * @return 已打开返回 true，否则返回 false。
+         */
+        bool isOpen() const;
+
+    private:
+        struct Impl;
+        Impl* impl_;
+    };
+
+} // namespace cc::neolux::utils::MiniXLSX
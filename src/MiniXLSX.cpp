@@ -1,6 +1,7 @@
 #include "cc/neolux/utils/MiniXLSX/MiniXLSX.hpp"
 #include "cc/neolux/utils/MiniXLSX/OpenXLSXWrapper.hpp"
 #include "cc/neolux/utils/MiniXLSX/XLPictureReader.hpp"
+#include "cc/neolux/utils/MiniXLSX/XLArchive.hpp"
 #include <memory>
 
 namespace cc::neolux::utils::MiniXLSX
@@ -20,9 +21,24 @@ namespace cc::neolux::utils::MiniXLSX
 
     bool MiniXLSX::open(const std::string& path)
     {
-        bool ok = impl_->wrapper->open(path);
+        // 封装与图片读取器共享同一个压缩包，文件只读取一次
+        auto archive = std::make_shared<XLArchive>();
+        if (!archive->open(path)) return false;
+        return openArchive(std::move(archive));
+    }
+
+    bool MiniXLSX::open(std::span<const std::byte> data)
+    {
+        auto archive = std::make_shared<XLArchive>();
+        if (!archive->open(data)) return false;
+        return openArchive(std::move(archive));
+    }
+
+    bool MiniXLSX::openArchive(std::shared_ptr<XLArchive> archive)
+    {
+        bool ok = impl_->wrapper->open(archive);
         if (ok && impl_->pictures) {
-            impl_->pictures->open(path);
+            impl_->pictures->attach(archive);
         }
         return ok;
     }
@@ -43,6 +59,26 @@ namespace cc::neolux::utils::MiniXLSX
         return impl_->wrapper->getCellValue(sheetIndex, ref);
     }
 
+    std::optional<std::string_view> MiniXLSX::getCellText(unsigned int sheetIndex, const std::string& ref) const
+    {
+        return impl_->wrapper->getCellText(sheetIndex, ref);
+    }
+
+    std::optional<std::string_view> MiniXLSX::getCellText(unsigned int sheetIndex, uint32_t row, uint16_t column) const
+    {
+        return impl_->wrapper->getCellText(sheetIndex, row, column);
+    }
+
+    std::optional<CellValueView> MiniXLSX::getValue(unsigned int sheetIndex, const std::string& ref) const
+    {
+        return impl_->wrapper->getValue(sheetIndex, ref);
+    }
+
+    std::optional<CellValueView> MiniXLSX::getValue(unsigned int sheetIndex, uint32_t row, uint16_t column) const
+    {
+        return impl_->wrapper->getValue(sheetIndex, row, column);
+    }
+
     bool MiniXLSX::setCellValue(unsigned int sheetIndex, const std::string& ref, const std::string& value)
     {
         return impl_->wrapper->setCellValue(sheetIndex, ref, value);
@@ -53,9 +89,59 @@ namespace cc::neolux::utils::MiniXLSX
         return impl_->wrapper->setCellStyle(sheetIndex, ref, style);
     }
 
-    bool MiniXLSX::save()
+    std::optional<std::string> MiniXLSX::getCellValue(unsigned int sheetIndex, uint32_t row, uint16_t column) const
+    {
+        return impl_->wrapper->getCellValue(sheetIndex, row, column);
+    }
+
+    bool MiniXLSX::setCellValue(unsigned int sheetIndex, uint32_t row, uint16_t column, const std::string& value)
+    {
+        return impl_->wrapper->setCellValue(sheetIndex, row, column, value);
+    }
+
+    bool MiniXLSX::setCellStyle(unsigned int sheetIndex, uint32_t row, uint16_t column, const CellStyle& style)
+    {
+        return impl_->wrapper->setCellStyle(sheetIndex, row, column, style);
+    }
+
+    std::optional<CellRange> MiniXLSX::getRange(unsigned int sheetIndex, const std::string& range, RangeOrder order) const
+    {
+        return impl_->wrapper->getRange(sheetIndex, range, order);
+    }
+
+    bool MiniXLSX::setRange(unsigned int sheetIndex, const std::string& topLeft, uint32_t rows, uint16_t columns, std::span<const CellValue> values)
+    {
+        return impl_->wrapper->setRange(sheetIndex, topLeft, rows, columns, values);
+    }
+
+    bool MiniXLSX::setRange(unsigned int sheetIndex, uint32_t row, uint16_t column, uint32_t rows, uint16_t columns, std::span<const CellValue> values)
+    {
+        return impl_->wrapper->setRange(sheetIndex, row, column, rows, columns, values);
+    }
+
+    bool MiniXLSX::setRangeStyle(unsigned int sheetIndex, const std::string& range, const CellStyle& style)
+    {
+        return impl_->wrapper->setRangeStyle(sheetIndex, range, style);
+    }
+
+    bool MiniXLSX::save(const SaveOptions& options)
+    {
+        return impl_->wrapper->save(options);
+    }
+
+    bool MiniXLSX::save(const SaveCallback& write, const SaveOptions& options)
+    {
+        return impl_->wrapper->saveAs(write, options);
+    }
+
+    bool MiniXLSX::save(std::vector<std::byte>& out, const SaveOptions& options)
+    {
+        return impl_->wrapper->saveAs(out, options);
+    }
+
+    bool MiniXLSX::save(std::ostream& out, const SaveOptions& options)
     {
-        return impl_->wrapper->save();
+        return impl_->wrapper->saveAs(out, options);
     }
 
     std::vector<PictureInfo> MiniXLSX::getPictures(unsigned int sheetIndex) const
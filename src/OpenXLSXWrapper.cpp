@@ -1,28 +1,517 @@
 #include "cc/neolux/utils/MiniXLSX/OpenXLSXWrapper.hpp"
+#include "cc/neolux/utils/MiniXLSX/XLArchive.hpp"
+#include "cc/neolux/utils/MiniXLSX/XLCellStore.hpp"
+#include <cctype>
+#include <map>
 #include <memory>
+#include <optional>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
 #include <iostream>
+#include <sstream>
 
 // 使用 OpenXLSX 作为底层实现
 #include "OpenXLSX.hpp"
 
 namespace cc::neolux::utils::MiniXLSX
 {
+    namespace
+    {
+        // 满足 OpenXLSX::IZipArchive 接口要求的适配器，使 OpenXLSX 读写共享的 XLArchive
+        class SharedZipArchive
+        {
+        public:
+            SharedZipArchive(std::shared_ptr<XLArchive> a, std::shared_ptr<const SaveOptions> o)
+                : archive(std::move(a)), options(std::move(o)) {}
+
+            bool isValid() const { return archive != nullptr; }
+            bool isOpen() const { return active && archive && archive->isOpen(); }
+
+            void open(const std::string& fileName)
+            {
+                // 共享压缩包已对应该文件（内存压缩包路径为空）时直接复用，不再重新读取
+                if (archive && archive->isOpen() && archive->path() == fileName) {
+                    active = true;
+                    return;
+                }
+                archive = std::make_shared<XLArchive>();
+                if (!archive->open(fileName)) throw OpenXLSX::XLInputError("failed to open archive " + fileName);
+                active = true;
+            }
+
+            // 仅断开当前文档的使用，由其他持有者决定何时真正关闭
+            void close() { active = false; }
+
+            void save(const std::string& path)
+            {
+                if (!archive->save(path, options ? *options : SaveOptions{})) throw OpenXLSX::XLInternalError("failed to save archive " + path);
+            }
+
+            void addEntry(const std::string& name, const std::string& data) { archive->setEntry(name, data); }
+            void deleteEntry(const std::string& name) { archive->deleteEntry(name); }
+            std::string getEntry(const std::string& name) { return archive->getEntry(name).value_or(std::string()); }
+            bool hasEntry(const std::string& name) const { return archive && archive->hasEntry(name); }
+
+        private:
+            std::shared_ptr<XLArchive> archive;
+            std::shared_ptr<const SaveOptions> options;   // 由封装在每次保存前设置
+            bool active = true;
+        };
+
+        // 向区域结果的字符串池追加文本并记录位置
+        void appendText(CellRange& range, RangeCell& cell, std::string_view text)
+        {
+            cell.offset = static_cast<uint32_t>(range.text.size());
+            cell.length = static_cast<uint32_t>(text.size());
+            range.text.append(text);
+        }
+
+        // 按类型解析单元格节点，数值直接从 <v> 文本解析；多段富文本内联字符串拼接到 scratch 中
+        CellValueView readCellNode(const OpenXLSX::XMLNode& cellNode, const OpenXLSX::XLSharedStrings& sharedStrings, std::string& scratch)
+        {
+            std::string_view type = cellNode.attribute("t").value();
+            if (type == "inlineStr") {
+                auto is = cellNode.child("is");
+                if (auto t = is.child("t")) return std::string_view(t.text().get());
+                scratch.clear();
+                for (auto run = is.child("r"); run; run = run.next_sibling("r")) scratch += run.child("t").text().get();
+                return std::string_view(scratch);
+            }
+
+            auto v = cellNode.child("v");
+            if (!v) return std::monostate{};   // 只有样式或公式尚未计算
+            std::string_view text = v.text().get();
+            if (type == "s") return std::string_view(sharedStrings.getString(v.text().as_int(-1)));
+            if (type == "b") return v.text().as_bool();
+            if (type == "e") return CellError{text};
+            if (type == "str" || type == "d") return text;
+
+            const char* first = text.data();
+            const char* last = first + text.size();
+            int64_t integer = 0;
+            auto result = std::from_chars(first, last, integer);
+            if (result.ec == std::errc() && result.ptr == last) return integer;
+            double number = 0;
+            result = std::from_chars(first, last, number);
+            if (result.ec == std::errc() && result.ptr == last) return number;
+            return text;
+        }
+
+        // 单元格文本视图：字符串指向共享字符串缓存或节点文本，数值、布尔值与错误值为 <v> 中的原始文本
+        std::string_view readCellText(const OpenXLSX::XMLNode& cellNode, const OpenXLSX::XLSharedStrings& sharedStrings, std::string& scratch)
+        {
+            std::string_view type = cellNode.attribute("t").value();
+            if (type == "inlineStr" || type == "s") {
+                CellValueView value = readCellNode(cellNode, sharedStrings, scratch);
+                const auto* text = std::get_if<std::string_view>(&value);
+                return text ? *text : std::string_view();
+            }
+            return cellNode.child("v").text().get();
+        }
+
+        // 解析 "A1:H5000" 或单个单元格地址，允许 "B5:A1" 这类反向书写，返回左上角与右下角
+        std::pair<OpenXLSX::XLCellReference, OpenXLSX::XLCellReference> parseRange(const std::string& range)
+        {
+            auto colon = range.find(':');
+            OpenXLSX::XLCellReference first(range.substr(0, colon));
+            OpenXLSX::XLCellReference last(colon == std::string::npos ? range : range.substr(colon + 1));
+            return {OpenXLSX::XLCellReference(std::min(first.row(), last.row()), std::min(first.column(), last.column())),
+                    OpenXLSX::XLCellReference(std::max(first.row(), last.row()), std::max(first.column(), last.column()))};
+        }
+
+        // 颜色统一为大写的 AARRGGBB：去掉前导 '#'，六位颜色补上不透明的 alpha
+        std::string argbColor(std::string color)
+        {
+            if (!color.empty() && color[0] == '#') color = color.substr(1);
+            if (color.size() == 6) color = std::string("FF") + color;
+            for (auto& ch : color) ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+            return color;
+        }
+
+        OpenXLSX::XLLineStyle lineStyle(CellBorderStyle border)
+        {
+            switch (border) {
+                case CellBorderStyle::Medium: return OpenXLSX::XLLineStyleMedium;
+                case CellBorderStyle::Thick: return OpenXLSX::XLLineStyleThick;
+                default: return OpenXLSX::XLLineStyleThin;
+            }
+        }
+
+        // 单元格格式的驻留键：基础格式加上规范化后的样式
+        struct StyleKey {
+            OpenXLSX::XLStyleIndex base;
+            std::string fillColor;     // 空串表示不设置填充
+            CellBorderStyle border;
+            std::string borderColor;   // 无边框时为空串
+
+            bool operator==(const StyleKey&) const = default;
+        };
+
+        struct StyleKeyHash {
+            size_t operator()(const StyleKey& key) const
+            {
+                size_t h = std::hash<std::string>{}(key.fillColor);
+                h = h * 31 + std::hash<std::string>{}(key.borderColor);
+                h = h * 31 + static_cast<size_t>(key.border);
+                return h * 31 + static_cast<size_t>(key.base);
+            }
+        };
+
+        // 以下按 styles.xml 中已有的节点计算驻留键。直接读取节点而不经 XLFill/XLBorder，后者读取时会补写缺失的节点与属性
+
+        // 纯色填充的颜色（与 StyleKey::fillColor 同一写法），其他填充返回空串
+        std::string solidFillColor(const OpenXLSX::XMLNode& fill)
+        {
+            auto pattern = fill.child("patternFill");
+            if (std::string_view(pattern.attribute("patternType").value()) != "solid") return {};
+            std::string color = pattern.child("fgColor").attribute("rgb").value();
+            return color.empty() ? color : argbColor(color);
+        }
+
+        // 四边线型与颜色相同且无对角线的边框键（与 internStyle 中的写法一致），其他边框返回空串
+        std::string uniformBorderKey(const OpenXLSX::XMLNode& border)
+        {
+            std::string style = border.child("left").attribute("style").value();
+            std::string color = border.child("left").child("color").attribute("rgb").value();
+            for (const char* side : {"right", "top", "bottom"}) {
+                auto line = border.child(side);
+                if (style != line.attribute("style").value() || color != line.child("color").attribute("rgb").value()) return {};
+            }
+            std::string_view diagonal = border.child("diagonal").attribute("style").value();
+            if (color.empty() || !(diagonal.empty() || diagonal == "none")) return {};
+            CellBorderStyle kind;
+            if (style == "thin") kind = CellBorderStyle::Thin;
+            else if (style == "medium") kind = CellBorderStyle::Medium;
+            else if (style == "thick") kind = CellBorderStyle::Thick;
+            else return {};
+            return std::to_string(static_cast<int>(kind)) + ":" + argbColor(color);
+        }
+
+        // 单元格格式（cellXfs 中的 xf）的内容：apply* 开关规范化为 "1"，为假时省略
+        struct XfShape {
+            std::map<std::string, std::string> attributes;
+            std::string children;
+
+            void set(const std::string& name, const std::string& value)
+            {
+                if (name.rfind("apply", 0) == 0) {
+                    if (value == "1" || value == "true") attributes[name] = "1";
+                    else attributes.erase(name);
+                } else {
+                    attributes[name] = value;
+                }
+            }
+
+            std::string signature() const
+            {
+                std::string result;
+                for (const auto& [name, value] : attributes) result += name + '=' + value + ';';
+                return result + children;
+            }
+        };
+
+        XfShape xfShape(const OpenXLSX::XMLNode& xf)
+        {
+            XfShape shape;
+            for (auto attribute : xf.attributes()) shape.set(attribute.name(), attribute.value());
+            std::ostringstream children;
+            for (auto child = xf.first_child(); !child.empty(); child = child.next_sibling()) {
+                if (child.type() == pugi::node_element) child.print(children, "", pugi::format_raw);
+            }
+            shape.children = children.str();
+            return shape;
+        }
+    } // namespace
+
     struct OpenXLSXWrapper::Impl {
         std::unique_ptr<OpenXLSX::XLDocument> doc;
+        std::shared_ptr<XLArchive> archive;
+        std::shared_ptr<SaveOptions> saveOptions = std::make_shared<SaveOptions>();
+        // 按序号缓存的工作表句柄，避免每次访问都经工作簿 XML 与关系查找；打开、关闭或工作表结构变化时清空
+        std::vector<std::optional<OpenXLSX::XLWorksheet>> worksheets;
+        std::string scratch;   // getValue 返回的拼接文本
+        // 可复用的填充、边框与单元格格式，相同样式不再向 styles.xml 追加节点。首次应用样式时由 styles.xml
+        // 中已有的记录初始化（之前的编辑会话创建的样式同样复用），之后加入新建的记录；关闭文档时清空
+        std::unordered_map<std::string, OpenXLSX::XLStyleIndex> fills;
+        std::unordered_map<std::string, OpenXLSX::XLStyleIndex> borders;
+        std::unordered_map<StyleKey, OpenXLSX::XLStyleIndex, StyleKeyHash> cellFormats;
+        std::vector<XfShape> xfShapes;                                     // 按序号排列的 cellXfs 内容
+        std::unordered_map<std::string, OpenXLSX::XLStyleIndex> xfIndices; // 内容签名 -> 序号
+        bool styleCacheSeeded = false;
+        // 工作表名称与序号的双向表，首次查询时从工作簿 XML 构建一次；打开或关闭文档时清空
+        std::vector<std::string> sheetNames;
+        std::unordered_map<std::string, unsigned int> sheetIndices;
+        bool sheetNamesLoaded = false;
+
+        OpenXLSX::XLWorksheet& worksheet(unsigned int index)
+        {
+            if (index < worksheets.size() && worksheets[index]) return *worksheets[index];
+            auto ws = doc->workbook().worksheet(static_cast<uint16_t>(index + 1));
+            if (index >= worksheets.size()) worksheets.resize(index + 1);
+            worksheets[index] = std::move(ws);
+            return *worksheets[index];
+        }
+
+        // 查找单元格节点但不创建，找到时调用 f(cellNode)
+        template <typename F>
+        void findCell(unsigned int index, uint32_t row, uint16_t column, F&& f)
+        {
+            OpenXLSX::XLCellReference cellRef(row, column);
+            worksheet(index).visitRange(cellRef, cellRef, [&f](uint32_t, uint16_t, const OpenXLSX::XMLNode& cellNode) { f(cellNode); });
+        }
+
+        const std::vector<std::string>& names()
+        {
+            if (!sheetNamesLoaded) {
+                sheetNames.clear();
+                sheetIndices.clear();
+                for (auto& name : doc->workbook().sheetNames()) {
+                    sheetIndices.try_emplace(name, static_cast<unsigned int>(sheetNames.size()));
+                    sheetNames.push_back(std::move(name));
+                }
+                sheetNamesLoaded = true;
+            }
+            return sheetNames;
+        }
+
+        void clearSheetNames()
+        {
+            sheetNames.clear();
+            sheetIndices.clear();
+            sheetNamesLoaded = false;
+        }
+
+        void clearStyleCache()
+        {
+            fills.clear();
+            borders.clear();
+            cellFormats.clear();
+            xfShapes.clear();
+            xfIndices.clear();
+            styleCacheSeeded = false;
+        }
+
+        // 遍历 styles.xml 中已有的填充、边框与单元格格式，序号较小的记录优先
+        void seedStyleCache()
+        {
+            auto root = doc->styles().rootNode();
+            OpenXLSX::XLStyleIndex index = 0;
+            for (auto fill = root.child("fills").first_child_of_type(pugi::node_element); !fill.empty();
+                 fill = fill.next_sibling_of_type(pugi::node_element), ++index) {
+                if (auto color = solidFillColor(fill); !color.empty()) fills.try_emplace(std::move(color), index);
+            }
+            index = 0;
+            for (auto border = root.child("borders").first_child_of_type(pugi::node_element); !border.empty();
+                 border = border.next_sibling_of_type(pugi::node_element), ++index) {
+                if (auto key = uniformBorderKey(border); !key.empty()) borders.try_emplace(std::move(key), index);
+            }
+            xfShapes.clear();
+            xfIndices.clear();
+            for (auto xf = root.child("cellXfs").first_child_of_type(pugi::node_element); !xf.empty();
+                 xf = xf.next_sibling_of_type(pugi::node_element)) {
+                xfShapes.push_back(xfShape(xf));
+                xfIndices.try_emplace(xfShapes.back().signature(), static_cast<OpenXLSX::XLStyleIndex>(xfShapes.size() - 1));
+            }
+            styleCacheSeeded = true;
+        }
+
+        // 返回在 base 格式上应用 style 后的单元格格式，已创建过的组合直接复用
+        OpenXLSX::XLStyleIndex internStyle(OpenXLSX::XLStyleIndex base, const CellStyle& style)
+        {
+            StyleKey key{base, style.backgroundColor.empty() ? std::string() : argbColor(style.backgroundColor), style.border, std::string()};
+            bool hasBorder = (style.border != CellBorderStyle::None);
+            if (hasBorder) key.borderColor = style.borderColor.empty() ? std::string("FF000000") : argbColor(style.borderColor);
+            if (auto it = cellFormats.find(key); it != cellFormats.end()) return it->second;
+            if (!styleCacheSeeded) seedStyleCache();
+
+            auto& styles = doc->styles();
+            OpenXLSX::XLStyleIndex fillIdx = 0;
+            if (!key.fillColor.empty()) {
+                auto [it, inserted] = fills.try_emplace(key.fillColor, 0);
+                if (inserted) {
+                    OpenXLSX::XLFills& xlFills = styles.fills();
+                    it->second = xlFills.create();
+                    xlFills[it->second].setPatternType(OpenXLSX::XLPatternSolid);
+                    xlFills[it->second].setColor(OpenXLSX::XLColor(key.fillColor));
+                }
+                fillIdx = it->second;
+            }
+
+            OpenXLSX::XLStyleIndex borderIdx = 0;
+            if (hasBorder) {
+                std::string borderKey = std::to_string(static_cast<int>(style.border)) + ":" + key.borderColor;
+                auto [it, inserted] = borders.try_emplace(borderKey, 0);
+                if (inserted) {
+                    OpenXLSX::XLBorders& xlBorders = styles.borders();
+                    it->second = xlBorders.create();
+                    OpenXLSX::XLLineStyle ls = lineStyle(style.border);
+                    OpenXLSX::XLColor color(key.borderColor);
+                    xlBorders[it->second].setLeft(ls, color);
+                    xlBorders[it->second].setRight(ls, color);
+                    xlBorders[it->second].setTop(ls, color);
+                    xlBorders[it->second].setBottom(ls, color);
+                }
+                borderIdx = it->second;
+            }
+
+            // 与已有格式内容相同时直接复用
+            const auto remember = [&](OpenXLSX::XLStyleIndex xf) {
+                cellFormats.emplace(key, xf);
+                // 对已应用该样式的单元格再次应用时得到同一格式
+                key.base = xf;
+                cellFormats.emplace(std::move(key), xf);
+                return xf;
+            };
+            if (base < xfShapes.size()) {
+                XfShape shape = xfShapes[base];
+                if (!key.fillColor.empty()) shape.set("fillId", std::to_string(fillIdx));
+                shape.set("applyFill", key.fillColor.empty() ? "0" : "1");
+                if (hasBorder) {
+                    shape.set("borderId", std::to_string(borderIdx));
+                    shape.set("applyBorder", "1");
+                }
+                shape.set("applyFont", "1");
+                if (auto it = xfIndices.find(shape.signature()); it != xfIndices.end()) return remember(it->second);
+            }
+
+            // 尽量保留基础格式中的字体等属性
+            OpenXLSX::XLCellFormats& xlFormats = styles.cellFormats();
+            OpenXLSX::XLStyleIndex xf;
+            try {
+                xf = xlFormats.create(xlFormats[base]);
+            } catch (...) {
+                xf = xlFormats.create();
+            }
+            if (!key.fillColor.empty()) xlFormats[xf].setFillIndex(fillIdx);
+            if (hasBorder) xlFormats[xf].setBorderIndex(borderIdx);
+            xlFormats[xf].setApplyFill(!key.fillColor.empty());
+            if (hasBorder) xlFormats[xf].setApplyBorder(true);
+            try {
+                xlFormats[xf].setApplyFont(true);
+            } catch (...) {}
+
+            // 记录新格式的实际内容；序号与记录不连续时（其他途径新建了格式）下次重新遍历
+            auto cellXfs = styles.rootNode().child("cellXfs");
+            auto created = cellXfs.last_child();
+            while (!created.empty() && created.type() != pugi::node_element) created = created.previous_sibling();
+            if (xf == xfShapes.size() && !created.empty()) {
+                xfShapes.push_back(xfShape(created));
+                xfIndices.try_emplace(xfShapes.back().signature(), xf);
+            } else {
+                styleCacheSeeded = false;
+            }
+            return remember(xf);
+        }
+    };
+
+    struct OpenXLSXWrapper::CellCursor::Impl {
+        const OpenXLSX::XLSharedStrings* sharedStrings = nullptr;
+        OpenXLSX::XMLNode sheetData;
+        OpenXLSX::XMLNode rowNode;    // 当前行，作为查找下一行的起点
+        OpenXLSX::XMLNode cellNode;   // 当前单元格，作为查找下一个单元格的起点
+        bool started = false;
+        SheetCell current;
+        std::string scratch;
     };
 
+    OpenXLSXWrapper::CellCursor::CellCursor() : impl_(new Impl()) {}
+    OpenXLSXWrapper::CellCursor::~CellCursor() { delete impl_; }
+    OpenXLSXWrapper::CellCursor::CellCursor(const CellCursor& other) : impl_(new Impl()) { *this = other; }
+
+    OpenXLSXWrapper::CellCursor& OpenXLSXWrapper::CellCursor::operator=(const CellCursor& other)
+    {
+        if (this == &other) return *this;
+        *impl_ = *other.impl_;
+        // 拼接文本的视图改为指向自己的缓冲区
+        if (auto* text = std::get_if<std::string_view>(&impl_->current.value); text && text->data() == other.impl_->scratch.data()) {
+            *text = impl_->scratch;
+        }
+        return *this;
+    }
+
+    bool OpenXLSXWrapper::CellCursor::next()
+    {
+        auto& s = *impl_;
+        if (!s.sharedStrings) return false;
+        if (!s.started) {
+            s.started = true;
+            s.rowNode = s.sheetData.first_child_of_type(pugi::node_element);
+            if (s.rowNode.empty()) return false;
+            s.cellNode = s.rowNode.first_child_of_type(pugi::node_element);
+        } else {
+            s.cellNode = s.cellNode.next_sibling_of_type(pugi::node_element);
+        }
+
+        while (true) {
+            // 当前行已遍历完则转到下一行
+            while (s.cellNode.empty()) {
+                if (s.rowNode.empty()) return false;
+                s.rowNode = s.rowNode.next_sibling_of_type(pugi::node_element);
+                if (s.rowNode.empty()) return false;
+                s.cellNode = s.rowNode.first_child_of_type(pugi::node_element);
+            }
+
+            uint32_t row = 0, column = 0;
+            if (XLCellStore::parseReference(s.cellNode.attribute("r").value(), row, column)) {
+                try {
+                    s.current.value = readCellNode(s.cellNode, *s.sharedStrings, s.scratch);
+                } catch (const std::exception& e) {
+                    std::cerr << "OpenXLSXWrapper::CellCursor::next error: " << e.what() << std::endl;
+                    s.current.value = std::monostate{};
+                }
+                if (!std::holds_alternative<std::monostate>(s.current.value)) {
+                    s.current.row = row;
+                    s.current.column = static_cast<uint16_t>(column);
+                    return true;
+                }
+            }
+            s.cellNode = s.cellNode.next_sibling_of_type(pugi::node_element);
+        }
+    }
+
+    const SheetCell& OpenXLSXWrapper::CellCursor::cell() const
+    {
+        return impl_->current;
+    }
+
     OpenXLSXWrapper::OpenXLSXWrapper() : impl_(new Impl()) {}
     OpenXLSXWrapper::~OpenXLSXWrapper() { close(); delete impl_; }
 
     bool OpenXLSXWrapper::open(const std::string& path)
     {
+        auto archive = std::make_shared<XLArchive>();
+        if (!archive->open(path)) return false;
+        return open(archive);
+    }
+
+    bool OpenXLSXWrapper::open(std::span<const std::byte> data)
+    {
+        auto archive = std::make_shared<XLArchive>();
+        if (!archive->open(data)) return false;
+        return open(archive);
+    }
+
+    bool OpenXLSXWrapper::open(std::shared_ptr<XLArchive> archive)
+    {
+        close();
+        if (!archive || !archive->isOpen()) return false;
         try {
-            impl_->doc = std::make_unique<OpenXLSX::XLDocument>();
+            std::string path = archive->path();
+            impl_->archive = archive;
+            impl_->doc = std::make_unique<OpenXLSX::XLDocument>(OpenXLSX::IZipArchive(SharedZipArchive(std::move(archive), impl_->saveOptions)));
             impl_->doc->open(path);
             return static_cast<bool>(impl_->doc && impl_->doc->isOpen());
         } catch (const std::exception& e) {
             std::cerr << "OpenXLSXWrapper::open error: " << e.what() << std::endl;
             impl_->doc.reset();
+            impl_->archive.reset();
+            impl_->worksheets.clear();
+            impl_->clearSheetNames();
+            impl_->clearStyleCache();
             return false;
         }
     }
@@ -33,6 +522,10 @@ namespace cc::neolux::utils::MiniXLSX
         {
             try { impl_->doc->close(); } catch (...) {}
             impl_->doc.reset();
+            impl_->archive.reset();
+            impl_->worksheets.clear();
+            impl_->clearSheetNames();
+            impl_->clearStyleCache();
         }
     }
 
@@ -45,30 +538,28 @@ namespace cc::neolux::utils::MiniXLSX
     {
         if (!impl_->doc) return 0;
         try {
-            return impl_->doc->workbook().sheetCount();
+            return static_cast<unsigned int>(impl_->names().size());
         } catch (...) { return 0; }
     }
 
-    std::string OpenXLSXWrapper::sheetName(unsigned int index) const
+    const std::string& OpenXLSXWrapper::sheetName(unsigned int index) const
     {
+        static const std::string empty;
         try {
-            if (!impl_->doc) return std::string();
-            auto names = impl_->doc->workbook().sheetNames();
-            if (index < names.size()) return std::string(names[index]);
+            if (!impl_->doc) return empty;
+            const auto& names = impl_->names();
+            if (index < names.size()) return names[index];
         } catch (...) {}
-        return std::string();
+        return empty;
     }
 
     std::optional<unsigned int> OpenXLSXWrapper::sheetIndex(const std::string& sheetName) const
     {
         if (!impl_->doc) return std::nullopt;
         try {
-            auto names = impl_->doc->workbook().sheetNames();
-            for (unsigned int i = 0; i < names.size(); ++i) {
-                if (std::string(names[i]) == sheetName) {
-                    return i;
-                }
-            }
+            impl_->names();
+            auto it = impl_->sheetIndices.find(sheetName);
+            if (it != impl_->sheetIndices.end()) return it->second;
         } catch (...) {}
         return std::nullopt;
     }
@@ -77,8 +568,20 @@ namespace cc::neolux::utils::MiniXLSX
     {
         if (!impl_->doc) return std::nullopt;
         try {
-            auto ws = impl_->doc->workbook().worksheet(static_cast<uint16_t>(sheetIndex + 1));
-            auto cell = ws.cell(ref);
+            OpenXLSX::XLCellReference cellRef(ref);
+            return getCellValue(sheetIndex, cellRef.row(), cellRef.column());
+        } catch (const std::exception& e) {
+            std::cerr << "OpenXLSXWrapper::getCellValue error: " << e.what() << std::endl;
+            return std::nullopt;
+        }
+    }
+
+    std::optional<std::string> OpenXLSXWrapper::getCellValue(unsigned int sheetIndex, uint32_t row, uint16_t column) const
+    {
+        if (!impl_->doc) return std::nullopt;
+        try {
+            auto& ws = impl_->worksheet(sheetIndex);
+            auto cell = ws.cell(row, column);
             std::string val = cell.getString();
             return std::optional<std::string>(val);
         } catch (const std::exception& e) {
@@ -87,12 +590,74 @@ namespace cc::neolux::utils::MiniXLSX
         }
     }
 
+    std::optional<CellValueView> OpenXLSXWrapper::getValue(unsigned int sheetIndex, const std::string& ref) const
+    {
+        uint32_t row = 0, column = 0;
+        if (!XLCellStore::parseReference(ref, row, column) || column > OpenXLSX::MAX_COLS) {
+            std::cerr << "OpenXLSXWrapper::getValue error: invalid cell reference " << ref << std::endl;
+            return std::nullopt;
+        }
+        return getValue(sheetIndex, row, static_cast<uint16_t>(column));
+    }
+
+    std::optional<CellValueView> OpenXLSXWrapper::getValue(unsigned int sheetIndex, uint32_t row, uint16_t column) const
+    {
+        if (!impl_->doc) return std::nullopt;
+        try {
+            CellValueView value;   // 不存在的单元格为空值
+            impl_->findCell(sheetIndex, row, column, [&](const OpenXLSX::XMLNode& cellNode) {
+                value = readCellNode(cellNode, impl_->doc->sharedStrings(), impl_->scratch);
+            });
+            return value;
+        } catch (const std::exception& e) {
+            std::cerr << "OpenXLSXWrapper::getValue error: " << e.what() << std::endl;
+            return std::nullopt;
+        }
+    }
+
+    std::optional<std::string_view> OpenXLSXWrapper::getCellText(unsigned int sheetIndex, const std::string& ref) const
+    {
+        uint32_t row = 0, column = 0;
+        if (!XLCellStore::parseReference(ref, row, column) || column > OpenXLSX::MAX_COLS) {
+            std::cerr << "OpenXLSXWrapper::getCellText error: invalid cell reference " << ref << std::endl;
+            return std::nullopt;
+        }
+        return getCellText(sheetIndex, row, static_cast<uint16_t>(column));
+    }
+
+    std::optional<std::string_view> OpenXLSXWrapper::getCellText(unsigned int sheetIndex, uint32_t row, uint16_t column) const
+    {
+        if (!impl_->doc) return std::nullopt;
+        try {
+            std::string_view text;
+            impl_->findCell(sheetIndex, row, column, [&](const OpenXLSX::XMLNode& cellNode) {
+                text = readCellText(cellNode, impl_->doc->sharedStrings(), impl_->scratch);
+            });
+            return text;
+        } catch (const std::exception& e) {
+            std::cerr << "OpenXLSXWrapper::getCellText error: " << e.what() << std::endl;
+            return std::nullopt;
+        }
+    }
+
     bool OpenXLSXWrapper::setCellValue(unsigned int sheetIndex, const std::string& ref, const std::string& value)
     {
         if (!impl_->doc) return false;
         try {
-            auto ws = impl_->doc->workbook().worksheet(static_cast<uint16_t>(sheetIndex + 1));
-            ws.cell(ref) = value;
+            OpenXLSX::XLCellReference cellRef(ref);
+            return setCellValue(sheetIndex, cellRef.row(), cellRef.column(), value);
+        } catch (const std::exception& e) {
+            std::cerr << "OpenXLSXWrapper::setCellValue error: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    bool OpenXLSXWrapper::setCellValue(unsigned int sheetIndex, uint32_t row, uint16_t column, const std::string& value)
+    {
+        if (!impl_->doc) return false;
+        try {
+            auto& ws = impl_->worksheet(sheetIndex);
+            ws.cell(row, column) = value;
             return true;
         } catch (const std::exception& e) {
             std::cerr << "OpenXLSXWrapper::setCellValue error: " << e.what() << std::endl;
@@ -104,86 +669,265 @@ namespace cc::neolux::utils::MiniXLSX
     {
         if (!impl_->doc) return false;
         try {
-            auto &styles = impl_->doc->styles();
-
-            // 创建填充
-            OpenXLSX::XLFills &fills = styles.fills();
-            OpenXLSX::XLStyleIndex fillIdx = fills.create();
-            if (!style.backgroundColor.empty()) {
-                std::string col = style.backgroundColor;
-                if (!col.empty() && col[0] == '#') col = col.substr(1);
-                if (col.size() == 6) col = std::string("FF") + col;
-                fills[fillIdx].setPatternType(OpenXLSX::XLPatternSolid);
-                fills[fillIdx].setColor(OpenXLSX::XLColor(col));
-            }
+            OpenXLSX::XLCellReference cellRef(ref);
+            return setCellStyle(sheetIndex, cellRef.row(), cellRef.column(), style);
+        } catch (const std::exception& e) {
+            std::cerr << "OpenXLSXWrapper::setCellStyle error: " << e.what() << std::endl;
+            return false;
+        }
+    }
 
-            // 创建边框
-            OpenXLSX::XLBorders &borders = styles.borders();
-            OpenXLSX::XLStyleIndex borderIdx = borders.create();
-            bool hasBorder = (style.border != CellBorderStyle::None);
-            if (hasBorder) {
-                OpenXLSX::XLLineStyle ls = OpenXLSX::XLLineStyleThin;
-                switch (style.border) {
-                    case CellBorderStyle::Thin: ls = OpenXLSX::XLLineStyleThin; break;
-                    case CellBorderStyle::Medium: ls = OpenXLSX::XLLineStyleMedium; break;
-                    case CellBorderStyle::Thick: ls = OpenXLSX::XLLineStyleThick; break;
-                    default: ls = OpenXLSX::XLLineStyleThin; break;
-                }
-                std::string bcol = style.borderColor.empty() ? std::string("FF000000") : style.borderColor;
-                if (!bcol.empty() && bcol[0] == '#') bcol = bcol.substr(1);
-                if (bcol.size() == 6) bcol = std::string("FF") + bcol;
-                OpenXLSX::XLColor bcolc(bcol);
-                borders[borderIdx].setLeft(ls, bcolc);
-                borders[borderIdx].setRight(ls, bcolc);
-                borders[borderIdx].setTop(ls, bcolc);
-                borders[borderIdx].setBottom(ls, bcolc);
-            }
-
-            // 创建单元格格式，尽量保留已有字体等属性
-            OpenXLSX::XLCellFormats &cellFormats = styles.cellFormats();
-            auto ws = impl_->doc->workbook().worksheet(static_cast<uint16_t>(sheetIndex + 1));
+    bool OpenXLSXWrapper::setCellStyle(unsigned int sheetIndex, uint32_t row, uint16_t column, const CellStyle& style)
+    {
+        if (!impl_->doc) return false;
+        try {
+            auto& ws = impl_->worksheet(sheetIndex);
+            auto cell = ws.cell(row, column);
             OpenXLSX::XLStyleIndex baseFmt = 0;
             try {
-                baseFmt = ws.cell(ref).cellFormat();
-            } catch(...) { baseFmt = 0; }
+                baseFmt = cell.cellFormat();
+            } catch (...) { baseFmt = 0; }
 
-            OpenXLSX::XLStyleIndex xf;
-            try {
-                if (baseFmt > 0) {
-                    xf = cellFormats.create(cellFormats[baseFmt]);
-                } else {
-                    xf = cellFormats.create();
+            OpenXLSX::XLStyleIndex xf = impl_->internStyle(baseFmt, style);
+            if (xf != baseFmt) cell.setCellFormat(xf);
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "OpenXLSXWrapper::setCellStyle error: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    OpenXLSXWrapper::CellCursor OpenXLSXWrapper::cellCursor(unsigned int sheetIndex) const
+    {
+        CellCursor cursor;
+        if (!impl_->doc) return cursor;
+        try {
+            cursor.impl_->sheetData = impl_->worksheet(sheetIndex).sheetData();
+            cursor.impl_->sharedStrings = &impl_->doc->sharedStrings();
+        } catch (const std::exception& e) {
+            std::cerr << "OpenXLSXWrapper::cellCursor error: " << e.what() << std::endl;
+        }
+        return cursor;
+    }
+
+    std::optional<CellRange> OpenXLSXWrapper::getRange(unsigned int sheetIndex, const std::string& range, RangeOrder order) const
+    {
+        if (!impl_->doc) return std::nullopt;
+        try {
+            auto [topLeft, bottomRight] = parseRange(range);
+
+            CellRange result;
+            result.firstRow = topLeft.row();
+            result.firstColumn = topLeft.column();
+            result.rows = bottomRight.row() - topLeft.row() + 1;
+            result.columns = bottomRight.column() - topLeft.column() + 1u;
+            result.order = order;
+            result.cells.resize(static_cast<size_t>(result.rows) * result.columns);
+
+            auto& ws = impl_->worksheet(sheetIndex);
+            const auto& sharedStrings = impl_->doc->sharedStrings();
+            // 同一共享字符串只写入字符串池一次
+            std::unordered_map<const char*, std::pair<uint32_t, uint32_t>> sharedOffsets;
+
+            ws.visitRange(topLeft, bottomRight, [&](uint32_t row, uint16_t column, const OpenXLSX::XMLNode& cellNode) {
+                RangeCell& cell = result.cells[result.index(row, column)];
+                CellValueView value = readCellNode(cellNode, sharedStrings, impl_->scratch);
+                if (const auto* text = std::get_if<std::string_view>(&value)) {
+                    cell.kind = CellKind::String;
+                    if (std::string_view(cellNode.attribute("t").value()) != "s") {
+                        appendText(result, cell, *text);
+                        return;
+                    }
+                    // 同一共享字符串的视图指向同一缓存，按地址去重
+                    auto [it, inserted] = sharedOffsets.try_emplace(text->data());
+                    if (inserted) {
+                        appendText(result, cell, *text);
+                        it->second = {cell.offset, cell.length};
+                    }
+                    cell.offset = it->second.first;
+                    cell.length = it->second.second;
+                } else if (const auto* error = std::get_if<CellError>(&value)) {
+                    cell.kind = CellKind::Error;
+                    appendText(result, cell, error->code);
+                } else if (const auto* integer = std::get_if<int64_t>(&value)) {
+                    cell.kind = CellKind::Number;
+                    cell.number = static_cast<double>(*integer);
+                } else if (const auto* number = std::get_if<double>(&value)) {
+                    cell.kind = CellKind::Number;
+                    cell.number = *number;
+                } else if (const auto* boolean = std::get_if<bool>(&value)) {
+                    cell.kind = CellKind::Boolean;
+                    cell.number = *boolean ? 1 : 0;
                 }
-            } catch(...) {
-                xf = cellFormats.create();
-            }
+            });
+            return result;
+        } catch (const std::exception& e) {
+            std::cerr << "OpenXLSXWrapper::getRange error: " << e.what() << std::endl;
+            return std::nullopt;
+        }
+    }
 
-            if (!style.backgroundColor.empty()) cellFormats[xf].setFillIndex(fillIdx);
-            if (hasBorder) cellFormats[xf].setBorderIndex(borderIdx);
-            cellFormats[xf].setApplyFill(!style.backgroundColor.empty());
-            if (hasBorder) cellFormats[xf].setApplyBorder(true);
+    bool OpenXLSXWrapper::setRange(unsigned int sheetIndex, const std::string& topLeft, uint32_t rows, uint16_t columns, std::span<const CellValue> values)
+    {
+        if (!impl_->doc) return false;
+        try {
+            OpenXLSX::XLCellReference cellRef(topLeft);
+            return setRange(sheetIndex, cellRef.row(), cellRef.column(), rows, columns, values);
+        } catch (const std::exception& e) {
+            std::cerr << "OpenXLSXWrapper::setRange error: " << e.what() << std::endl;
+            return false;
+        }
+    }
 
-            try {
-                cellFormats[xf].setApplyFont(true);
-            } catch(...) {}
+    bool OpenXLSXWrapper::setRange(unsigned int sheetIndex, uint32_t row, uint16_t column, uint32_t rows, uint16_t columns, std::span<const CellValue> values)
+    {
+        if (!impl_->doc) return false;
+        if (values.size() != static_cast<size_t>(rows) * columns) {
+            std::cerr << "OpenXLSXWrapper::setRange error: expected " << static_cast<size_t>(rows) * columns << " values, got " << values.size() << std::endl;
+            return false;
+        }
+        if (values.empty()) return true;
+        try {
+            if (static_cast<uint32_t>(column) + columns - 1 > OpenXLSX::MAX_COLS) throw OpenXLSX::XLCellAddressError("range exceeds the last column");
+            OpenXLSX::XLCellReference topLeft(row, column);
+            OpenXLSX::XLCellReference bottomRight(row + rows - 1, static_cast<uint16_t>(column + columns - 1));
+            auto& ws = impl_->worksheet(sheetIndex);
+            const auto& sharedStrings = impl_->doc->sharedStrings();
+            // 本次写入内的共享字符串只查找或追加一次
+            std::unordered_map<std::string_view, int32_t> sharedIndices;
+
+            ws.writeRange(topLeft, bottomRight, [&](uint32_t r, uint16_t c, OpenXLSX::XMLNode& cellNode) {
+                const CellValue& value = values[static_cast<size_t>(r - row) * columns + (c - column)];
+                cellNode.remove_child("is");
+                if (std::holds_alternative<std::monostate>(value)) {
+                    cellNode.remove_attribute("t");
+                    cellNode.remove_child("v");
+                    return;
+                }
 
-            ws.cell(ref).setCellFormat(xf);
+                auto v = cellNode.child("v");
+                if (!v) v = cellNode.append_child("v");
+                v.remove_attribute("xml:space");
+                auto type = cellNode.attribute("t");
+                auto setType = [&](const char* t) {
+                    if (!type) type = cellNode.append_attribute("t");
+                    type.set_value(t);
+                };
+
+                if (const auto* text = std::get_if<std::string>(&value)) {
+                    auto [it, inserted] = sharedIndices.try_emplace(*text, 0);
+                    if (inserted) {
+                        int32_t index = sharedStrings.getStringIndex(*text);
+                        it->second = index >= 0 ? index : sharedStrings.appendString(*text);
+                    }
+                    setType("s");
+                    v.text().set(it->second);
+                } else if (const auto* integer = std::get_if<int64_t>(&value)) {
+                    cellNode.remove_attribute("t");
+                    v.text().set(static_cast<long long>(*integer));
+                } else if (const auto* number = std::get_if<double>(&value)) {
+                    if (std::isfinite(*number)) {
+                        cellNode.remove_attribute("t");
+                        v.text().set(*number);
+                    } else {
+                        setType("e");
+                        v.text().set("#NUM!");
+                    }
+                } else {
+                    setType("b");
+                    v.text().set(std::get<bool>(value) ? 1 : 0);
+                }
+            });
             return true;
         } catch (const std::exception& e) {
-            std::cerr << "OpenXLSXWrapper::setCellStyle error: " << e.what() << std::endl;
+            std::cerr << "OpenXLSXWrapper::setRange error: " << e.what() << std::endl;
             return false;
         }
     }
 
-    bool OpenXLSXWrapper::save()
+    bool OpenXLSXWrapper::setRangeStyle(unsigned int sheetIndex, const std::string& range, const CellStyle& style)
     {
         if (!impl_->doc) return false;
         try {
+            auto [topLeft, bottomRight] = parseRange(range);
+            auto& ws = impl_->worksheet(sheetIndex);
+            // 区域内的单元格通常只有少数几种基础格式，每种只驻留一次
+            std::unordered_map<OpenXLSX::XLStyleIndex, OpenXLSX::XLStyleIndex> formats;
+
+            ws.writeRange(topLeft, bottomRight, [&](uint32_t, uint16_t, OpenXLSX::XMLNode& cellNode) {
+                auto s = cellNode.attribute("s");
+                OpenXLSX::XLStyleIndex base = s ? s.as_uint(0) : 0;
+                auto [it, inserted] = formats.try_emplace(base, 0);
+                if (inserted) it->second = impl_->internStyle(base, style);
+                if (it->second == base) return;
+                if (!s) s = cellNode.append_attribute("s");
+                s.set_value(it->second);
+            });
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "OpenXLSXWrapper::setRangeStyle error: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    bool OpenXLSXWrapper::save(const SaveOptions& options)
+    {
+        if (!impl_->doc) return false;
+        try {
+            *impl_->saveOptions = options;
             impl_->doc->save();
+            *impl_->saveOptions = SaveOptions{};
             return true;
         } catch (const std::exception& e) {
             std::cerr << "OpenXLSXWrapper::save error: " << e.what() << std::endl;
+            *impl_->saveOptions = SaveOptions{};
             return false;
         }
     }
+
+    bool OpenXLSXWrapper::saveAs(const std::string& path, const SaveOptions& options)
+    {
+        if (!impl_->doc) return false;
+        try {
+            *impl_->saveOptions = options;
+            impl_->doc->saveAs(path, OpenXLSX::XLForceOverwrite);
+            *impl_->saveOptions = SaveOptions{};
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "OpenXLSXWrapper::saveAs error: " << e.what() << std::endl;
+            *impl_->saveOptions = SaveOptions{};
+            return false;
+        }
+    }
+
+    bool OpenXLSXWrapper::saveAs(const SaveCallback& write, const SaveOptions& options)
+    {
+        if (!impl_->doc || !impl_->archive) return false;
+        try {
+            // 先把已加载的 XML 写回共享压缩包，再由压缩包直接输出
+            impl_->doc->commit();
+        } catch (const std::exception& e) {
+            std::cerr << "OpenXLSXWrapper::saveAs error: " << e.what() << std::endl;
+            return false;
+        }
+        return impl_->archive->save(write, options);
+    }
+
+    bool OpenXLSXWrapper::saveAs(std::vector<std::byte>& out, const SaveOptions& options)
+    {
+        out.clear();
+        return saveAs([&out](const char* data, size_t size) {
+            auto bytes = reinterpret_cast<const std::byte*>(data);
+            out.insert(out.end(), bytes, bytes + size);
+            return true;
+        }, options);
+    }
+
+    bool OpenXLSXWrapper::saveAs(std::ostream& out, const SaveOptions& options)
+    {
+        return saveAs([&out](const char* data, size_t size) {
+            out.write(data, static_cast<std::streamsize>(size));
+            return static_cast<bool>(out);
+        }, options);
+    }
 } // namespace cc::neolux::utils::MiniXLSX
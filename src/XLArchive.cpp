@@ -0,0 +1,292 @@
+#include "cc/neolux/utils/MiniXLSX/XLArchive.hpp"
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <pugixml.hpp>
+
+// 使用 OpenXLSX 自带的 zip 实现（zippy），条目按需解压并缓存
+#include "OpenXLSX.hpp"
+
+namespace cc::neolux::utils::MiniXLSX
+{
+    namespace
+    {
+        // 根据 [Content_Types].xml 将保存选项转换为按条目名称决定的压缩级别，-1 表示没有规则适用
+        std::function<int(const std::string&)> makeCompressionPolicy(const XLArchive& archive, const SaveOptions& options)
+        {
+            int fallback = options.level ? static_cast<int>(*options.level) : -1;
+            if (options.contentTypeLevels.empty()) {
+                if (fallback < 0) return {};
+                return [fallback](const std::string&) { return fallback; };
+            }
+
+            std::map<std::string, std::string> byExtension;
+            std::map<std::string, std::string> byPart;
+            pugi::xml_document doc;
+            auto xml = archive.getEntry("[Content_Types].xml");
+            if (xml && doc.load_buffer(xml->data(), xml->size())) {
+                for (auto node : doc.document_element().children()) {
+                    std::string name = node.name();
+                    std::string type = node.attribute("ContentType").value();
+                    if (name == "Default") {
+                        std::string ext = node.attribute("Extension").value();
+                        for (auto& ch : ext) ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+                        byExtension[ext] = type;
+                    } else if (name == "Override") {
+                        std::string part = node.attribute("PartName").value();
+                        if (!part.empty() && part.front() == '/') part.erase(0, 1);
+                        byPart[part] = type;
+                    }
+                }
+            }
+
+            return [levels = options.contentTypeLevels, byExtension = std::move(byExtension), byPart = std::move(byPart),
+                    fallback](const std::string& entry) {
+                std::string type;
+                if (auto it = byPart.find(entry); it != byPart.end()) {
+                    type = it->second;
+                } else if (auto dot = entry.rfind('.'); dot != std::string::npos) {
+                    std::string ext = entry.substr(dot + 1);
+                    for (auto& ch : ext) ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+                    if (auto e = byExtension.find(ext); e != byExtension.end()) type = e->second;
+                }
+                if (type.empty()) return fallback;
+                if (auto it = levels.find(type); it != levels.end()) return static_cast<int>(it->second);
+                // "image/*" 形式的通配键匹配整类内容类型
+                if (auto slash = type.find('/'); slash != std::string::npos) {
+                    if (auto it = levels.find(type.substr(0, slash) + "/*"); it != levels.end()) return static_cast<int>(it->second);
+                }
+                return fallback;
+            };
+        }
+    } // namespace
+
+    struct XLArchive::Impl {
+        OpenXLSX::XLZipArchive zip;
+        std::string path;
+    };
+
+    XLArchive::XLArchive() : impl_(new Impl()) {}
+    XLArchive::~XLArchive() { close(); delete impl_; }
+
+    bool XLArchive::open(const std::string& path)
+    {
+        close();
+        try {
+            impl_->zip.open(path);
+            impl_->path = path;
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "XLArchive::open error: " << e.what() << std::endl;
+            impl_->zip = OpenXLSX::XLZipArchive();
+            return false;
+        }
+    }
+
+    bool XLArchive::open(std::span<const std::byte> data)
+    {
+        close();
+        try {
+            impl_->zip.open(data.data(), data.size());
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "XLArchive::open error: " << e.what() << std::endl;
+            impl_->zip = OpenXLSX::XLZipArchive();
+            return false;
+        }
+    }
+
+    void XLArchive::close()
+    {
+        if (impl_->zip.isOpen()) {
+            try { impl_->zip.close(); } catch (...) {}
+        }
+        impl_->zip = OpenXLSX::XLZipArchive();
+        impl_->path.clear();
+    }
+
+    bool XLArchive::isOpen() const
+    {
+        return impl_->zip.isOpen();
+    }
+
+    const std::string& XLArchive::path() const
+    {
+        return impl_->path;
+    }
+
+    bool XLArchive::hasEntry(const std::string& name) const
+    {
+        if (!isOpen()) return false;
+        try {
+            return impl_->zip.hasEntry(name);
+        } catch (...) { return false; }
+    }
+
+    std::vector<std::string> XLArchive::entryNames() const
+    {
+        if (!isOpen()) return {};
+        try {
+            return impl_->zip.entryNames();
+        } catch (...) { return {}; }
+    }
+
+    std::optional<std::string> XLArchive::getEntry(const std::string& name) const
+    {
+        if (!hasEntry(name)) return std::nullopt;
+        try {
+            return impl_->zip.getEntry(name);
+        } catch (const std::exception& e) {
+            std::cerr << "XLArchive::getEntry error: " << e.what() << std::endl;
+            return std::nullopt;
+        }
+    }
+
+    std::optional<std::string_view> XLArchive::getEntryView(const std::string& name) const
+    {
+        if (!isOpen()) return std::nullopt;
+        try {
+            std::string_view view = impl_->zip.getEntryView(name);
+            if (view.data() == nullptr) return std::nullopt;
+            return view;
+        } catch (...) { return std::nullopt; }
+    }
+
+    std::function<size_t(char*, size_t)> XLArchive::openEntryStream(const std::string& name) const
+    {
+        if (!isOpen()) return {};
+        try {
+            return impl_->zip.openEntryStream(name);
+        } catch (const std::exception& e) {
+            std::cerr << "XLArchive::openEntryStream error: " << e.what() << std::endl;
+            return {};
+        }
+    }
+
+    void XLArchive::setEntry(const std::string& name, const std::string& data)
+    {
+        if (!isOpen()) return;
+        impl_->zip.addEntry(name, data);
+    }
+
+    void XLArchive::deleteEntry(const std::string& name)
+    {
+        if (!isOpen()) return;
+        impl_->zip.deleteEntry(name);
+    }
+
+    bool XLArchive::save(const std::string& path, const SaveOptions& options)
+    {
+        if (!isOpen()) return false;
+        if (path.empty() && impl_->path.empty()) {
+            std::cerr << "XLArchive::save error: no target path for in-memory archive" << std::endl;
+            return false;
+        }
+        try {
+            // 压缩策略只对本次保存生效
+            impl_->zip.setCompressionLevel(makeCompressionPolicy(*this, options));
+            impl_->zip.save(path);
+            impl_->zip.setCompressionLevel({});
+            impl_->path = path;
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "XLArchive::save error: " << e.what() << std::endl;
+            impl_->zip.setCompressionLevel({});
+            return false;
+        }
+    }
+
+    bool XLArchive::save(const SaveCallback& write, const SaveOptions& options)
+    {
+        if (!isOpen() || !write) return false;
+        try {
+            impl_->zip.setCompressionLevel(makeCompressionPolicy(*this, options));
+            impl_->zip.save([&write](const char* data, size_t size) {
+                if (!write(data, size)) throw std::runtime_error("write callback aborted");
+            });
+            impl_->zip.setCompressionLevel({});
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "XLArchive::save error: " << e.what() << std::endl;
+            impl_->zip.setCompressionLevel({});
+            return false;
+        }
+    }
+
+    bool XLArchive::save(std::vector<std::byte>& out, const SaveOptions& options)
+    {
+        out.clear();
+        return save([&out](const char* data, size_t size) {
+            auto bytes = reinterpret_cast<const std::byte*>(data);
+            out.insert(out.end(), bytes, bytes + size);
+            return true;
+        }, options);
+    }
+
+    bool XLArchive::save(std::ostream& out, const SaveOptions& options)
+    {
+        return save([&out](const char* data, size_t size) {
+            out.write(data, static_cast<std::streamsize>(size));
+            return static_cast<bool>(out);
+        }, options);
+    }
+
+    bool XLArchive::extractTo(const std::string& dir) const
+    {
+        if (!isOpen()) return false;
+        for (const auto& name : entryNames()) {
+            if (!extractEntry(name, dir)) return false;
+        }
+        return true;
+    }
+
+    std::filesystem::path XLArchive::entryPath(const std::string& name, const std::filesystem::path& dir)
+    {
+        namespace fs = std::filesystem;
+        fs::path entry(name);
+        if (name.empty() || entry.has_root_name() || entry.has_root_directory()) return {};
+        // 原始名称中的 ".." 一律拒绝，即使规范化后仍落在目录内
+        for (const auto& part : entry) {
+            if (part == "..") return {};
+        }
+        const fs::path base = fs::path(dir).lexically_normal();
+        fs::path target = (base / entry.lexically_normal()).lexically_normal();
+        const fs::path relative = target.lexically_relative(base);
+        if (relative.empty() || relative == "." || *relative.begin() == "..") return {};
+        return target;
+    }
+
+    bool XLArchive::extractEntry(const std::string& name, const std::string& dir) const
+    {
+        namespace fs = std::filesystem;
+        try {
+            // 未压缩条目直接从映射写出，避免缓存
+            std::optional<std::string> data;
+            std::string_view bytes;
+            if (auto view = getEntryView(name)) {
+                bytes = *view;
+            } else {
+                data = getEntry(name);
+                if (!data) return false;
+                bytes = *data;
+            }
+            fs::path target = entryPath(name, dir);
+            if (target.empty()) {
+                std::cerr << "XLArchive::extractEntry rejected unsafe entry name: " << name << std::endl;
+                return false;
+            }
+            fs::create_directories(target.parent_path());
+            std::ofstream out(target, std::ios::binary);
+            if (!out.is_open()) return false;
+            out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "XLArchive::extractEntry error: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+} // namespace cc::neolux::utils::MiniXLSX
@@ -1,5 +1,6 @@
 #include "cc/neolux/utils/MiniXLSX/XLCellData.hpp"
-#include <stdexcept>
+#include <charconv>
+#include <system_error>
 
 namespace cc::neolux::utils::MiniXLSX
 {
@@ -10,27 +11,24 @@ XLCellData::XLCellData(const std::string& ref, const std::string& val, const std
 }
 
 std::string XLCellData::getValue() const
+{
+    return std::string(getValueView());
+}
+
+std::string_view XLCellData::getValueView() const
 {
     if (type == "s")
     {
-        try
+        size_t index = 0;
+        auto result = std::from_chars(value.data(), value.data() + value.size(), index);
+        if (result.ec == std::errc() && index < sharedStrings.size())
         {
-            size_t index = std::stoul(value);
-            if (index < sharedStrings.size())
-            {
-                return sharedStrings[index];
-            }
+            return sharedStrings[index];
         }
-        catch (const std::exception&)
-        {
-            // 索引无效
-        }
-        return "";
-    }
-    else
-    {
-        return value;
+        // 索引无效
+        return {};
     }
+    return value;
 }
 
 std::string XLCellData::getType() const
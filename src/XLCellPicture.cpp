@@ -14,6 +14,11 @@ std::string XLCellPicture::getValue() const
     return imageFileName;
 }
 
+std::string_view XLCellPicture::getValueView() const
+{
+    return imageFileName;
+}
+
 std::string XLCellPicture::getType() const
 {
     return "picture";
@@ -0,0 +1,258 @@
+#include "cc/neolux/utils/MiniXLSX/XLCellStore.hpp"
+#include <algorithm>
+#include <charconv>
+#include <system_error>
+
+namespace cc::neolux::utils::MiniXLSX
+{
+    namespace
+    {
+        // 乱序写入的单元格累积到该数量后合并进有序数组，查找时最多线性扫描这么多个
+        constexpr size_t PendingMergeThreshold = 256;
+
+        // 被覆盖的文本超过该大小且超过字符串池一半时整理字符串池
+        constexpr size_t ArenaCompactThreshold = 1 << 20;
+
+        bool hasText(XLCellStore::Kind kind)
+        {
+            using Kind = XLCellStore::Kind;
+            return kind == Kind::String || kind == Kind::InlineString || kind == Kind::Error || kind == Kind::Date;
+        }
+
+        std::string formatNumber(double number)
+        {
+            char buffer[32];
+            auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+            return std::string(buffer, result.ptr);
+        }
+    } // namespace
+
+    bool XLCellStore::parseReference(std::string_view ref, uint32_t& row, uint32_t& column)
+    {
+        size_t pos = 0;
+        if (pos < ref.size() && ref[pos] == '$') ++pos;
+        uint64_t col = 0;
+        size_t letters = 0;
+        for (; pos < ref.size(); ++pos, ++letters) {
+            char ch = ref[pos];
+            if (ch >= 'a' && ch <= 'z') ch = static_cast<char>(ch - 'a' + 'A');
+            if (ch < 'A' || ch > 'Z') break;
+            col = col * 26 + static_cast<uint64_t>(ch - 'A' + 1);
+            if (col > 0xFFFFFFFFu) return false;
+        }
+        if (letters == 0) return false;
+        if (pos < ref.size() && ref[pos] == '$') ++pos;
+
+        uint32_t r = 0;
+        auto result = std::from_chars(ref.data() + pos, ref.data() + ref.size(), r);
+        if (result.ec != std::errc() || result.ptr != ref.data() + ref.size() || r == 0) return false;
+
+        row = r;
+        column = static_cast<uint32_t>(col);
+        return true;
+    }
+
+    std::string XLCellStore::makeReference(uint32_t row, uint32_t column)
+    {
+        std::string letters;
+        for (uint32_t col = column; col > 0; col = (col - 1) / 26) {
+            letters.insert(letters.begin(), static_cast<char>('A' + (col - 1) % 26));
+        }
+        return letters + std::to_string(row);
+    }
+
+    std::string_view XLCellStore::typeName(Kind kind)
+    {
+        switch (kind) {
+            case Kind::Number: return "n";
+            case Kind::SharedString: return "s";
+            case Kind::String: return "str";
+            case Kind::InlineString: return "inlineStr";
+            case Kind::Boolean: return "b";
+            case Kind::Error: return "e";
+            case Kind::Date: return "d";
+            default: return "";
+        }
+    }
+
+    const XLCellStore::Slot& XLCellStore::set(uint32_t row, uint32_t column, std::string_view value, std::string_view type, uint32_t style)
+    {
+        Slot& slot = insert(makeKey(row, column));
+        releaseText(slot);
+        slot.style = style;
+
+        const char* first = value.data();
+        const char* last = value.data() + value.size();
+        if (value.empty()) {
+            slot.kind = Kind::Empty;
+            slot.number = 0;
+        } else if (type.empty() || type == "n") {
+            double number = 0;
+            auto result = std::from_chars(first, last, number);
+            if (result.ec == std::errc() && result.ptr == last) {
+                slot.kind = Kind::Number;
+                slot.number = number;
+            } else {
+                slot.kind = Kind::String;
+                assignText(slot, value);
+            }
+        } else if (type == "s") {
+            uint32_t index = 0;
+            auto result = std::from_chars(first, last, index);
+            if (result.ec == std::errc() && result.ptr == last) {
+                slot.kind = Kind::SharedString;
+                slot.index = index;
+            } else {
+                slot.kind = Kind::String;
+                assignText(slot, value);
+            }
+        } else if (type == "b") {
+            slot.kind = Kind::Boolean;
+            slot.boolean = (value == "1" || value == "true" || value == "TRUE");
+        } else {
+            if (type == "inlineStr") slot.kind = Kind::InlineString;
+            else if (type == "e") slot.kind = Kind::Error;
+            else if (type == "d") slot.kind = Kind::Date;
+            else slot.kind = Kind::String;
+            assignText(slot, value);
+        }
+        return slot;
+    }
+
+    const XLCellStore::Slot& XLCellStore::setPicture(uint32_t row, uint32_t column, uint32_t index)
+    {
+        Slot& slot = insert(makeKey(row, column));
+        releaseText(slot);
+        slot.kind = Kind::Picture;
+        slot.style = 0;
+        slot.index = index;
+        return slot;
+    }
+
+    const XLCellStore::Slot* XLCellStore::find(uint32_t row, uint32_t column) const
+    {
+        return findSlot(makeKey(row, column));
+    }
+
+    std::string_view XLCellStore::text(const Slot& slot) const
+    {
+        if (!hasText(slot.kind)) return {};
+        return std::string_view(arena).substr(slot.text.offset, slot.text.length);
+    }
+
+    std::string XLCellStore::rawValue(const Slot& slot) const
+    {
+        switch (slot.kind) {
+            case Kind::Number: return formatNumber(slot.number);
+            case Kind::SharedString: return std::to_string(slot.index);
+            case Kind::Boolean: return slot.boolean ? "1" : "0";
+            case Kind::Empty:
+            case Kind::Picture: return std::string();
+            default: return std::string(text(slot));
+        }
+    }
+
+    std::string XLCellStore::value(const Slot& slot, const std::vector<std::string>& sharedStrings) const
+    {
+        if (slot.kind == Kind::SharedString) {
+            return slot.index < sharedStrings.size() ? sharedStrings[slot.index] : std::string();
+        }
+        return rawValue(slot);
+    }
+
+    void XLCellStore::clear()
+    {
+        slots.clear();
+        pending.clear();
+        arena.clear();
+        deadBytes = 0;
+    }
+
+    XLCellStore::const_iterator XLCellStore::begin() const
+    {
+        mergePending();
+        return slots.begin();
+    }
+
+    XLCellStore::const_iterator XLCellStore::end() const
+    {
+        mergePending();
+        return slots.end();
+    }
+
+    XLCellStore::Slot* XLCellStore::findSlot(uint64_t key) const
+    {
+        auto it = std::lower_bound(slots.begin(), slots.end(), key, [](const Slot& s, uint64_t k) { return s.key < k; });
+        if (it != slots.end() && it->key == key) return &*it;
+        for (auto& slot : pending) {
+            if (slot.key == key) return &slot;
+        }
+        return nullptr;
+    }
+
+    XLCellStore::Slot& XLCellStore::insert(uint64_t key)
+    {
+        if (Slot* existing = findSlot(key)) return *existing;
+
+        Slot slot;
+        slot.key = key;
+        // 按顺序写入（加载工作表时的常见情况）直接追加
+        if (pending.empty() && (slots.empty() || slots.back().key < key)) {
+            return slots.emplace_back(slot);
+        }
+        if (pending.size() >= PendingMergeThreshold) {
+            mergePending();
+            return insert(key);
+        }
+        return pending.emplace_back(slot);
+    }
+
+    void XLCellStore::assignText(Slot& slot, std::string_view value)
+    {
+        if (deadBytes > ArenaCompactThreshold && deadBytes > arena.size() / 2) {
+            // 先把当前单元格标记为空，避免整理时复制其旧文本
+            Kind kind = slot.kind;
+            slot.kind = Kind::Empty;
+            compactArena();
+            slot.kind = kind;
+        }
+        slot.text.offset = static_cast<uint32_t>(arena.size());
+        slot.text.length = static_cast<uint32_t>(value.size());
+        arena.append(value);
+    }
+
+    void XLCellStore::releaseText(const Slot& slot)
+    {
+        if (hasText(slot.kind)) deadBytes += slot.text.length;
+    }
+
+    void XLCellStore::mergePending() const
+    {
+        if (pending.empty()) return;
+        auto less = [](const Slot& a, const Slot& b) { return a.key < b.key; };
+        std::sort(pending.begin(), pending.end(), less);
+        size_t middle = slots.size();
+        slots.insert(slots.end(), pending.begin(), pending.end());
+        std::inplace_merge(slots.begin(), slots.begin() + static_cast<std::ptrdiff_t>(middle), slots.end(), less);
+        pending.clear();
+    }
+
+    void XLCellStore::compactArena()
+    {
+        std::string compacted;
+        compacted.reserve(arena.size() - deadBytes);
+        auto move = [&](std::vector<Slot>& list) {
+            for (auto& slot : list) {
+                if (!hasText(slot.kind)) continue;
+                uint32_t offset = static_cast<uint32_t>(compacted.size());
+                compacted.append(arena, slot.text.offset, slot.text.length);
+                slot.text.offset = offset;
+            }
+        };
+        move(slots);
+        move(pending);
+        arena.swap(compacted);
+        deadBytes = 0;
+    }
+
+} // namespace cc::neolux::utils::MiniXLSX
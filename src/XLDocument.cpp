@@ -1,5 +1,5 @@
 #include "cc/neolux/utils/MiniXLSX/XLDocument.hpp"
-#include "cc/neolux/utils/KFZippa/kfzippa.hpp"
+#include "cc/neolux/utils/MiniXLSX/XLArchive.hpp"
 #include "cc/neolux/utils/MiniXLSX/XLTemplate.hpp"
 #include "cc/neolux/utils/MiniXLSX/OpenXLSXWrapper.hpp"
 #include "cc/neolux/utils/MiniXLSX/XLPictureReader.hpp"
@@ -12,7 +12,7 @@
 namespace cc::neolux::utils::MiniXLSX
 {
 
-    XLDocument::XLDocument() : isOpen(false), workbook(nullptr) {}
+    XLDocument::XLDocument() : tempDirExtracted(false), isOpen(false), isModified(false), workbook(nullptr) {}
 
     XLDocument::~XLDocument()
     {
@@ -29,6 +29,11 @@ namespace cc::neolux::utils::MiniXLSX
         return pictureReader ? pictureReader.get() : nullptr;
     }
 
+    XLArchive* XLDocument::getArchive() const
+    {
+        return archive ? archive.get() : nullptr;
+    }
+
     bool XLDocument::open(const std::string &xlsxPath)
     {
         if (isOpen)
@@ -36,42 +41,60 @@ namespace cc::neolux::utils::MiniXLSX
             close();
         }
 
-        // 创建唯一的临时目录
-        auto now = std::chrono::system_clock::now();
-        auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
-        std::string tempDirName = "MiniXLSX_" + std::to_string(timestamp);
-        tempDir = std::filesystem::temp_directory_path() / tempDirName;
-
-        // 创建临时目录
-        if (!std::filesystem::create_directory(tempDir))
+        // 只读取一次压缩包，OpenXLSX、图片读取器与旧版解析路径共享同一份条目数据
+        archive = std::make_shared<XLArchive>();
+        if (!archive->open(xlsxPath))
         {
-            std::cerr << "Failed to create temporary directory: " << tempDir << std::endl;
+            std::cerr << "Failed to open XLSX file: " << xlsxPath << std::endl;
+            archive.reset();
             return false;
         }
 
-        // 解压 XLSX 文件
-        if (!KFZippa::unzip(xlsxPath, tempDir.string()))
+        // 打开时仅建立条目索引，各部件在首次使用时才解压；临时目录在需要时才创建
+
+        this->xlsxPath = xlsxPath;
+        return loadArchive();
+    }
+
+    bool XLDocument::open(std::span<const std::byte> data)
+    {
+        if (isOpen)
+        {
+            close();
+        }
+
+        // 直接从内存读取，不创建临时目录，也不访问文件系统
+        archive = std::make_shared<XLArchive>();
+        if (!archive->open(data))
         {
-            std::cerr << "Failed to unzip XLSX file: " << xlsxPath << std::endl;
-            std::filesystem::remove_all(tempDir); // 失败时清理
+            std::cerr << "Failed to open XLSX data from memory." << std::endl;
+            archive.reset();
             return false;
         }
 
+        tempDir.clear();
+        xlsxPath.clear();
+        return loadArchive();
+    }
+
+    bool XLDocument::loadArchive()
+    {
         // 同时打开 OpenXLSX 封装，便于调用其接口
         try {
             oxwrapper = std::make_unique<OpenXLSXWrapper>();
-            if (!oxwrapper->open(xlsxPath)) {
+            if (!oxwrapper->open(archive)) {
                 // 非致命错误，封装可选
                 oxwrapper.reset();
             }
         } catch (...) { oxwrapper.reset(); }
 
-        // 绑定图片读取器到已解压的临时目录
+        // 绑定图片读取器到共享压缩包
         try {
             pictureReader = std::make_unique<XLPictureReader>();
-            pictureReader->attach(xlsxPath, tempDir.string());
+            pictureReader->attach(archive);
         } catch (...) { pictureReader.reset(); }
 
+        isModified = false;
         isOpen = true;
         workbook = new XLWorkbook(*this);
         if (!workbook->load())
@@ -108,7 +131,16 @@ namespace cc::neolux::utils::MiniXLSX
             }
             delete workbook;
             workbook = nullptr;
-            std::filesystem::remove_all(tempDir);
+            if (archive) {
+                archive->close();
+                archive.reset();
+            }
+            if (!tempDir.empty())
+            {
+                std::filesystem::remove_all(tempDir);
+                tempDir.clear();
+            }
+            tempDirExtracted = false;
             isOpen = false;
         }
     }
@@ -127,12 +159,69 @@ namespace cc::neolux::utils::MiniXLSX
         return isOpen;
     }
 
+    bool XLDocument::ensureTempDir() const
+    {
+        if (!tempDir.empty())
+        {
+            return true;
+        }
+
+        // 创建唯一的临时目录
+        auto now = std::chrono::system_clock::now();
+        auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+        std::string tempDirName = "MiniXLSX_" + std::to_string(timestamp);
+        std::filesystem::path dir = std::filesystem::temp_directory_path() / tempDirName;
+
+        std::error_code ec;
+        if (!std::filesystem::create_directory(dir, ec))
+        {
+            std::cerr << "Failed to create temporary directory: " << dir << std::endl;
+            return false;
+        }
+        tempDir = dir;
+        return true;
+    }
+
     const std::filesystem::path &XLDocument::getTempDir() const
     {
+        // 首次调用时才将压缩包内容导出到临时目录；从内存打开的文档不访问文件系统
+        if (isOpen && archive && !xlsxPath.empty() && !tempDirExtracted && ensureTempDir())
+        {
+            tempDirExtracted = archive->extractTo(tempDir.string());
+            if (!tempDirExtracted)
+            {
+                std::cerr << "Failed to unzip XLSX file: " << xlsxPath << std::endl;
+            }
+        }
         return tempDir;
     }
 
-    bool XLDocument::saveAs(const std::string &xlsxPath)
+    std::filesystem::path XLDocument::extractEntry(const std::string& entryName) const
+    {
+        if (!isOpen || !archive || !archive->hasEntry(entryName))
+        {
+            return {};
+        }
+        if (!ensureTempDir())
+        {
+            return {};
+        }
+
+        std::filesystem::path target = XLArchive::entryPath(entryName, tempDir);
+        if (target.empty())
+        {
+            std::cerr << "Unsafe entry name: " << entryName << std::endl;
+            return {};
+        }
+        if (!tempDirExtracted && !std::filesystem::exists(target) && !archive->extractEntry(entryName, tempDir.string()))
+        {
+            std::cerr << "Failed to extract entry: " << entryName << std::endl;
+            return {};
+        }
+        return target;
+    }
+
+    bool XLDocument::saveAs(const std::string &xlsxPath, const SaveOptions& options)
     {
         // 另存为新的 XLSX 文件
         if (!isOpen)
@@ -141,26 +230,57 @@ namespace cc::neolux::utils::MiniXLSX
             return false;
         }
 
-        // 将修改写回到 XML
+        if (!writeTo(xlsxPath, options))
+        {
+            return false;
+        }
+
+        this->xlsxPath = xlsxPath;
+        isModified = false;
+        return true;
+    }
+
+    bool XLDocument::saveAs(const SaveCallback& write, const SaveOptions& options)
+    {
+        if (!isOpen)
+        {
+            std::cerr << "Document is not open. Cannot save." << std::endl;
+            return false;
+        }
+
         if (!workbook->save())
         {
             std::cerr << "Failed to save workbook changes." << std::endl;
             return false;
         }
 
-        // 使用 KFZippa 重新打包
-        if (!KFZippa::zip(tempDir.string(), xlsxPath))
+        bool ok = (oxwrapper && oxwrapper->isOpen()) ? oxwrapper->saveAs(write, options) : archive->save(write, options);
+        if (!ok)
         {
-            std::cerr << "Failed to zip contents to XLSX file: " << xlsxPath << std::endl;
-            return false;
+            std::cerr << "Failed to write XLSX contents." << std::endl;
         }
+        return ok;
+    }
 
-        this->xlsxPath = xlsxPath;
-        isModified = false;
-        return true;
+    bool XLDocument::saveAs(std::vector<std::byte>& out, const SaveOptions& options)
+    {
+        out.clear();
+        return saveAs([&out](const char* data, size_t size) {
+            auto bytes = reinterpret_cast<const std::byte*>(data);
+            out.insert(out.end(), bytes, bytes + size);
+            return true;
+        }, options);
     }
 
-    bool XLDocument::save()
+    bool XLDocument::saveAs(std::ostream& out, const SaveOptions& options)
+    {
+        return saveAs([&out](const char* data, size_t size) {
+            out.write(data, static_cast<std::streamsize>(size));
+            return static_cast<bool>(out);
+        }, options);
+    }
+
+    bool XLDocument::save(const SaveOptions& options)
     {
         if (!isOpen)
         {
@@ -174,6 +294,24 @@ namespace cc::neolux::utils::MiniXLSX
             return true;
         }
 
+        if (xlsxPath.empty())
+        {
+            // 从内存打开的文档没有对应文件，需使用 saveAs
+            std::cerr << "Document has no file path. Use saveAs." << std::endl;
+            return false;
+        }
+
+        if (!writeTo(xlsxPath, options))
+        {
+            return false;
+        }
+
+        isModified = false;
+        return true;
+    }
+
+    bool XLDocument::writeTo(const std::string& xlsxPath, const SaveOptions& options)
+    {
         // 将修改写回到 XML
         if (!workbook->save())
         {
@@ -181,14 +319,13 @@ namespace cc::neolux::utils::MiniXLSX
             return false;
         }
 
-        // 使用 KFZippa 重新打包
-        if (!KFZippa::zip(tempDir.string(), xlsxPath))
+        // 封装模式由 OpenXLSX 写出全部部件，否则直接保存共享压缩包
+        bool ok = (oxwrapper && oxwrapper->isOpen()) ? oxwrapper->saveAs(xlsxPath, options) : archive->save(xlsxPath, options);
+        if (!ok)
         {
             std::cerr << "Failed to zip contents to XLSX file: " << xlsxPath << std::endl;
             return false;
         }
-
-        isModified = false;
         return true;
     }
 
@@ -1,21 +1,44 @@
 #include "cc/neolux/utils/MiniXLSX/XLPictureReader.hpp"
-#include "cc/neolux/utils/KFZippa/kfzippa.hpp"
+#include "cc/neolux/utils/MiniXLSX/XLArchive.hpp"
 #include "cc/neolux/utils/MiniXLSX/XLSheet.hpp"
-#include "OpenXLSX.hpp"
 #include <filesystem>
 #include <chrono>
-#include <fstream>
 #include <unordered_map>
 #include <pugixml.hpp>
 
 namespace cc::neolux::utils::MiniXLSX
 {
+    namespace
+    {
+        // 读取 drawing 的关系条目，建立 rId -> 图片目标 的映射
+        std::unordered_map<std::string, std::string> readImageMap(const XLArchive& archive, const std::string& relsEntry)
+        {
+            std::unordered_map<std::string, std::string> imageMap;
+            auto rels = archive.getEntry(relsEntry);
+            if (!rels) return imageMap;
+            pugi::xml_document drelDoc;
+            if (drelDoc.load_buffer(rels->data(), rels->size())) {
+                pugi::xml_node droot = drelDoc.child("Relationships");
+                for (pugi::xml_node rel : droot.children("Relationship")) {
+                    std::string type = rel.attribute("Type").as_string();
+                    if (type.find("image") != std::string::npos) {
+                        imageMap[rel.attribute("Id").as_string()] = rel.attribute("Target").as_string();
+                    }
+                }
+            }
+            return imageMap;
+        }
+    } // namespace
+
     XLPictureReader::XLPictureReader() = default;
     XLPictureReader::~XLPictureReader() { close(); }
 
     bool XLPictureReader::open(const std::string& xlsxPath)
     {
         close();
+        auto own = std::make_shared<XLArchive>();
+        if (!own->open(xlsxPath)) return false;
+        archive = own;
         openedPath = xlsxPath;
         attached = false;
         ownsTempDir = true;
@@ -25,6 +48,9 @@ namespace cc::neolux::utils::MiniXLSX
     bool XLPictureReader::attach(const std::string& xlsxPath, const std::string& temp)
     {
         close();
+        auto own = std::make_shared<XLArchive>();
+        if (!own->open(xlsxPath)) return false;
+        archive = own;
         openedPath = xlsxPath;
         tempDir = temp;
         attached = true;
@@ -32,9 +58,21 @@ namespace cc::neolux::utils::MiniXLSX
         return true;
     }
 
+    bool XLPictureReader::attach(std::shared_ptr<XLArchive> shared)
+    {
+        close();
+        if (!shared || !shared->isOpen()) return false;
+        archive = std::move(shared);
+        openedPath = archive->path();
+        attached = true;
+        ownsTempDir = true;
+        return true;
+    }
+
     void XLPictureReader::close()
     {
         if (ownsTempDir) cleanupTempDir();
+        archive.reset();
         openedPath.clear();
         attached = false;
         ownsTempDir = false;
@@ -42,22 +80,23 @@ namespace cc::neolux::utils::MiniXLSX
 
     bool XLPictureReader::isOpen() const
     {
-        return !openedPath.empty();
+        return archive && archive->isOpen();
     }
 
     bool XLPictureReader::ensureTempDir() const
     {
         if (!tempDir.empty()) return true;
-        if (openedPath.empty()) return false;
+        if (!isOpen()) return false;
         if (!ownsTempDir) return false;
         try {
             namespace fs = std::filesystem;
             fs::path tmp = fs::temp_directory_path() / ("minixlsx_unzip_" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count()));
             fs::create_directories(tmp);
-            if (cc::neolux::utils::KFZippa::unzip(openedPath, tmp.string())) {
+            if (archive->extractTo(tmp.string())) {
                 tempDir = tmp.string();
                 return true;
             }
+            fs::remove_all(tmp);
         } catch (...) {}
         return false;
     }
@@ -117,15 +156,17 @@ namespace cc::neolux::utils::MiniXLSX
                     }
                     if (rel.empty()) rel = "media";
                     std::string entry = std::string("xl/") + rel + "/" + pi.fileName;
-                    OpenXLSX::XLZipArchive za;
-                    za.open(openedPath);
-                    std::string data = za.getEntry(entry);
-                    if (data.empty()) {
-                        entry = std::string("xl/media/") + pi.fileName;
-                        data = za.getEntry(entry);
+                    if (!archive->hasEntry(entry)) entry = std::string("xl/media/") + pi.fileName;
+
+                    // 未压缩的图片直接从映射中复制，避免在压缩包中再缓存一份
+                    if (auto view = archive->getEntryView(entry)) {
+                        if (view->empty()) return std::nullopt;
+                        return std::vector<uint8_t>(view->begin(), view->end());
                     }
-                    if (!data.empty()) {
-                        std::vector<uint8_t> out(data.begin(), data.end());
+
+                    auto data = archive->getEntry(entry);
+                    if (data && !data->empty()) {
+                        std::vector<uint8_t> out(data->begin(), data->end());
                         return out;
                     }
                     return std::nullopt;
@@ -137,54 +178,31 @@ namespace cc::neolux::utils::MiniXLSX
 
     std::string XLPictureReader::findDrawingPathForSheet(unsigned int sheetIndex) const
     {
-        if (!ensureTempDir()) return "";
+        if (!isOpen()) return "";
 
-        namespace fs = std::filesystem;
-        fs::path tmp(tempDir);
-
-        std::string drawingFile = "drawings/drawing" + std::to_string(sheetIndex + 1) + ".xml";
-        fs::path drawingPath = tmp / "xl" / drawingFile;
-        if (!fs::exists(drawingPath)) {
-            if (sheetIndex == 0) {
-                fs::path alt = tmp / "xl" / "drawings" / "drawing1.xml";
-                if (fs::exists(alt)) drawingPath = alt;
-            }
+        std::string drawingPath = "xl/drawings/drawing" + std::to_string(sheetIndex + 1) + ".xml";
+        if (!archive->hasEntry(drawingPath)) {
+            if (sheetIndex == 0 && archive->hasEntry("xl/drawings/drawing1.xml")) drawingPath = "xl/drawings/drawing1.xml";
+            else return "";
         }
-
-        if (!fs::exists(drawingPath)) return "";
-        return drawingPath.string().substr(tmp.string().size() + 1);
+        return drawingPath;
     }
 
     std::vector<PictureInfo> XLPictureReader::parseDrawingXML(const std::string& drawingPath) const
     {
         std::vector<PictureInfo> out;
-        if (!ensureTempDir()) return out;
+        if (!isOpen()) return out;
 
         namespace fs = std::filesystem;
-        fs::path tmp(tempDir);
-        fs::path drawingFullPath = tmp / drawingPath;
-
-        if (!fs::exists(drawingFullPath)) return out;
+        fs::path drawingEntry(drawingPath);
+        auto drawing = archive->getEntry(drawingPath);
+        if (!drawing) return out;
 
         // 读取 drawing 关系，建立图片映射
-        fs::path drawingRelsPath = drawingFullPath.parent_path() / "_rels" / (drawingFullPath.filename().string() + ".rels");
-        std::unordered_map<std::string, std::string> imageMap;
-        if (fs::exists(drawingRelsPath)) {
-            pugi::xml_document drelDoc;
-            if (drelDoc.load_file(drawingRelsPath.c_str())) {
-                pugi::xml_node droot = drelDoc.child("Relationships");
-                for (pugi::xml_node rel : droot.children("Relationship")) {
-                    std::string type = rel.attribute("Type").as_string();
-                    if (type.find("image") != std::string::npos) {
-                        imageMap[rel.attribute("Id").as_string()] = rel.attribute("Target").as_string();
-                    }
-                }
-            }
-        }
+        std::string drawingRelsPath = (drawingEntry.parent_path() / "_rels" / (drawingEntry.filename().string() + ".rels")).generic_string();
+        std::unordered_map<std::string, std::string> imageMap = readImageMap(*archive, drawingRelsPath);
 
-        std::ifstream drawingFile(drawingFullPath);
-        std::string drawingContent((std::istreambuf_iterator<char>(drawingFile)), std::istreambuf_iterator<char>());
-        drawingFile.close();
+        const std::string& drawingContent = *drawing;
 
         size_t anchorPos = 0;
         while ((anchorPos = drawingContent.find("<xdr:twoCellAnchor", anchorPos)) != std::string::npos) {
@@ -228,21 +246,13 @@ namespace cc::neolux::utils::MiniXLSX
                     std::string imageTarget = it->second;
                     fs::path absImagePath;
                     try {
-                        absImagePath = (drawingFullPath.parent_path() / imageTarget).lexically_normal();
+                        absImagePath = (drawingEntry.parent_path() / imageTarget).lexically_normal();
                     } catch(...) {
                         absImagePath = fs::path("xl") / imageTarget;
                     }
                     std::string imageFileName = absImagePath.filename().string();
-                    std::string relPath;
-                    try {
-                        fs::path base = tmp / "xl";
-                        fs::path parent = absImagePath.parent_path();
-                        relPath = fs::relative(parent, base).string();
-                    } catch(...) {
-                        relPath = absImagePath.parent_path().string();
-                        if (relPath == "../media") relPath = "media";
-                    }
-                    if (relPath == "../media") relPath = "media";
+                    std::string relPath = absImagePath.parent_path().lexically_relative("xl").generic_string();
+                    if (relPath.empty() || relPath == "../media") relPath = "media";
                     PictureInfo pi;
                     pi.ref = ref;
                     pi.fileName = imageFileName;
@@ -260,33 +270,18 @@ namespace cc::neolux::utils::MiniXLSX
     std::vector<SheetPicture> XLPictureReader::parseDrawingXMLForSheetPictures(const std::string& drawingPath) const
     {
         std::vector<SheetPicture> out;
-        if (!ensureTempDir()) return out;
+        if (!isOpen()) return out;
 
         namespace fs = std::filesystem;
-        fs::path tmp(tempDir);
-        fs::path drawingFullPath = tmp / drawingPath;
-
-        if (!fs::exists(drawingFullPath)) return out;
+        fs::path drawingEntry(drawingPath);
+        auto drawing = archive->getEntry(drawingPath);
+        if (!drawing) return out;
 
         // 读取 drawing 关系，建立图片映射
-        fs::path drawingRelsPath = drawingFullPath.parent_path() / "_rels" / (drawingFullPath.filename().string() + ".rels");
-        std::unordered_map<std::string, std::string> imageMap;
-        if (fs::exists(drawingRelsPath)) {
-            pugi::xml_document drelDoc;
-            if (drelDoc.load_file(drawingRelsPath.c_str())) {
-                pugi::xml_node droot = drelDoc.child("Relationships");
-                for (pugi::xml_node rel : droot.children("Relationship")) {
-                    std::string type = rel.attribute("Type").as_string();
-                    if (type.find("image") != std::string::npos) {
-                        imageMap[rel.attribute("Id").as_string()] = rel.attribute("Target").as_string();
-                    }
-                }
-            }
-        }
+        std::string drawingRelsPath = (drawingEntry.parent_path() / "_rels" / (drawingEntry.filename().string() + ".rels")).generic_string();
+        std::unordered_map<std::string, std::string> imageMap = readImageMap(*archive, drawingRelsPath);
 
-        std::ifstream drawingFile(drawingFullPath);
-        std::string drawingContent((std::istreambuf_iterator<char>(drawingFile)), std::istreambuf_iterator<char>());
-        drawingFile.close();
+        const std::string& drawingContent = *drawing;
 
         size_t anchorPos = 0;
         while ((anchorPos = drawingContent.find("<xdr:twoCellAnchor", anchorPos)) != std::string::npos) {
@@ -329,21 +324,13 @@ namespace cc::neolux::utils::MiniXLSX
                     std::string imageTarget = it->second;
                     fs::path absImagePath;
                     try {
-                        absImagePath = (drawingFullPath.parent_path() / imageTarget).lexically_normal();
+                        absImagePath = (drawingEntry.parent_path() / imageTarget).lexically_normal();
                     } catch(...) {
                         absImagePath = fs::path("xl") / imageTarget;
                     }
                     std::string imageFileName = absImagePath.filename().string();
-                    std::string relPath;
-                    try {
-                        fs::path base = tmp / "xl";
-                        fs::path parent = absImagePath.parent_path();
-                        relPath = fs::relative(parent, base).string();
-                    } catch(...) {
-                        relPath = absImagePath.parent_path().string();
-                        if (relPath == "../media") relPath = "media";
-                    }
-                    if (relPath == "../media") relPath = "media";
+                    std::string relPath = absImagePath.parent_path().lexically_relative("xl").generic_string();
+                    if (relPath.empty() || relPath == "../media") relPath = "media";
                     SheetPicture sp;
                     sp.row = std::to_string(fromRow + 1);
                     sp.col = XLSheet::columnNumberToLetter(fromCol);
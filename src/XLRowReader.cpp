@@ -0,0 +1,592 @@
+#include "cc/neolux/utils/MiniXLSX/XLRowReader.hpp"
+#include "cc/neolux/utils/MiniXLSX/XLArchive.hpp"
+#include <charconv>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <pugixml.hpp>
+
+namespace cc::neolux::utils::MiniXLSX
+{
+    namespace
+    {
+        constexpr size_t ChunkSize = 64 * 1024;   // 每次从解压流读取的字节数
+
+        using ByteSource = std::function<size_t(char*, size_t)>;
+
+        /**
+         * @brief 最小的拉取式 XML 分词器，只保留当前未处理的数据。
+         *
+         * 不做完整的 XML 校验；返回的名称、属性与文本视图在下一次调用 next() 前有效。
+         * 自闭合元素在 StartElement 之后会补发一个 EndElement。
+         */
+        class XmlPullParser
+        {
+        public:
+            enum class Event { StartElement, EndElement, Text, End };
+
+            explicit XmlPullParser(ByteSource src) : source(std::move(src)) {}
+
+            Event next()
+            {
+                if (pendingEnd) {
+                    pendingEnd = false;
+                    return Event::EndElement;
+                }
+                if (pos >= buf.size() && !fill()) return Event::End;
+
+                if (buf[pos] != '<') {
+                    size_t end = find("<", 0);
+                    size_t len = (end == std::string::npos) ? buf.size() - pos : end;
+                    textView = std::string_view(buf).substr(pos, len);
+                    cdata = false;
+                    pos += len;
+                    return Event::Text;
+                }
+
+                if (startsWith("<?")) {
+                    skipPast("?>");
+                    return next();
+                }
+                if (startsWith("<!--")) {
+                    skipPast("-->");
+                    return next();
+                }
+                if (startsWith("<![CDATA[")) {
+                    size_t end = find("]]>", 9);
+                    if (end == std::string::npos) throw std::runtime_error("unterminated CDATA section");
+                    textView = std::string_view(buf).substr(pos + 9, end - 9);
+                    cdata = true;
+                    pos += end + 3;
+                    return Event::Text;
+                }
+                if (startsWith("<!")) {
+                    skipPast(">");
+                    return next();
+                }
+
+                size_t end = findTagEnd();
+                std::string_view tag = std::string_view(buf).substr(pos + 1, end - 1);
+                pos += end + 1;
+
+                bool closing = !tag.empty() && tag.front() == '/';
+                if (closing) tag.remove_prefix(1);
+                bool selfClosing = !closing && !tag.empty() && tag.back() == '/';
+                if (selfClosing) tag.remove_suffix(1);
+
+                size_t nameEnd = tag.find_first_of(" \t\r\n");
+                std::string_view qname = tag.substr(0, nameEnd);
+                attrView = nameEnd == std::string_view::npos ? std::string_view() : tag.substr(nameEnd);
+                size_t colon = qname.find(':');
+                nameView = colon == std::string_view::npos ? qname : qname.substr(colon + 1);
+
+                if (closing) return Event::EndElement;
+                pendingEnd = selfClosing;
+                return Event::StartElement;
+            }
+
+            // 当前元素的本地名称（去掉命名空间前缀）
+            std::string_view name() const { return nameView; }
+
+            // 当前文本，未做实体解码；CDATA 内容无需解码
+            std::string_view text() const { return textView; }
+            bool isCData() const { return cdata; }
+
+            // 查找当前开始元素的属性值（按完整属性名匹配）
+            std::string_view attribute(std::string_view attrName) const
+            {
+                std::string_view rest = attrView;
+                while (!rest.empty()) {
+                    size_t start = rest.find_first_not_of(" \t\r\n");
+                    if (start == std::string_view::npos) break;
+                    rest.remove_prefix(start);
+                    size_t eq = rest.find('=');
+                    if (eq == std::string_view::npos) break;
+                    std::string_view key = rest.substr(0, eq);
+                    while (!key.empty() && (key.back() == ' ' || key.back() == '\t' || key.back() == '\r' || key.back() == '\n')) key.remove_suffix(1);
+                    size_t quote = rest.find_first_of("\"'", eq);
+                    if (quote == std::string_view::npos) break;
+                    size_t close = rest.find(rest[quote], quote + 1);
+                    if (close == std::string_view::npos) break;
+                    if (key == attrName) return rest.substr(quote + 1, close - quote - 1);
+                    rest.remove_prefix(close + 1);
+                }
+                return {};
+            }
+
+        private:
+            // 丢弃已处理的数据并读取下一块，没有更多数据时返回 false
+            bool fill()
+            {
+                if (eof) return false;
+                if (pos > 0) {
+                    buf.erase(0, pos);
+                    pos = 0;
+                }
+                size_t old = buf.size();
+                buf.resize(old + ChunkSize);
+                size_t n = source(buf.data() + old, ChunkSize);
+                buf.resize(old + n);
+                if (n == 0) eof = true;
+                return n > 0;
+            }
+
+            bool ensure(size_t n)
+            {
+                while (buf.size() - pos < n) {
+                    if (!fill()) return false;
+                }
+                return true;
+            }
+
+            bool startsWith(std::string_view prefix)
+            {
+                ensure(prefix.size());
+                return std::string_view(buf).substr(pos).substr(0, prefix.size()) == prefix;
+            }
+
+            // 从 pos + from 开始查找，返回相对 pos 的偏移
+            size_t find(std::string_view pattern, size_t from)
+            {
+                for (;;) {
+                    size_t hit = buf.find(pattern, pos + from);
+                    if (hit != std::string::npos) return hit - pos;
+                    size_t avail = buf.size() - pos;
+                    from = avail >= pattern.size() ? avail - pattern.size() + 1 : 0;
+                    if (!fill()) return std::string::npos;
+                }
+            }
+
+            void skipPast(std::string_view pattern)
+            {
+                size_t end = find(pattern, 1);
+                if (end == std::string::npos) throw std::runtime_error("unterminated XML markup");
+                pos += end + pattern.size();
+            }
+
+            // 查找标签结束的 '>'，跳过引号内的内容
+            size_t findTagEnd()
+            {
+                size_t i = 1;
+                char quote = 0;
+                for (;;) {
+                    for (; pos + i < buf.size(); ++i) {
+                        char ch = buf[pos + i];
+                        if (quote) {
+                            if (ch == quote) quote = 0;
+                        } else if (ch == '"' || ch == '\'') {
+                            quote = ch;
+                        } else if (ch == '>') {
+                            return i;
+                        }
+                    }
+                    if (!fill()) throw std::runtime_error("unterminated XML tag");
+                }
+            }
+
+            ByteSource source;
+            std::string buf;
+            size_t pos = 0;
+            bool eof = false;
+            bool pendingEnd = false;
+            bool cdata = false;
+            std::string_view nameView;
+            std::string_view attrView;
+            std::string_view textView;
+        };
+
+        void appendUtf8(std::string& out, uint32_t cp)
+        {
+            // 代理项与超出 Unicode 范围的码点不是合法字符，视为数据损坏
+            if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+                throw std::runtime_error("invalid character reference");
+            }
+            if (cp < 0x80) {
+                out.push_back(static_cast<char>(cp));
+            } else if (cp < 0x800) {
+                out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+                out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+            } else if (cp < 0x10000) {
+                out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+                out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+            } else {
+                out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+                out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+            }
+        }
+
+        // 追加文本并解码 XML 实体（预定义实体与数字字符引用）
+        void appendDecoded(std::string& out, std::string_view raw)
+        {
+            size_t amp;
+            while ((amp = raw.find('&')) != std::string_view::npos) {
+                out.append(raw.substr(0, amp));
+                raw.remove_prefix(amp);
+                size_t semi = raw.find(';');
+                if (semi == std::string_view::npos) break;
+                std::string_view ent = raw.substr(1, semi - 1);
+                if (ent == "amp") out.push_back('&');
+                else if (ent == "lt") out.push_back('<');
+                else if (ent == "gt") out.push_back('>');
+                else if (ent == "quot") out.push_back('"');
+                else if (ent == "apos") out.push_back('\'');
+                else if (ent.size() > 1 && ent[0] == '#') {
+                    bool hex = ent[1] == 'x' || ent[1] == 'X';
+                    std::string_view digits = ent.substr(hex ? 2 : 1);
+                    uint32_t cp = 0;
+                    auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), cp, hex ? 16 : 10);
+                    if (digits.empty() || ec != std::errc() || end != digits.data() + digits.size()) {
+                        throw std::runtime_error("invalid character reference");
+                    }
+                    appendUtf8(out, cp);
+                } else {
+                    out.append(raw.substr(0, semi + 1));
+                }
+                raw.remove_prefix(semi + 1);
+            }
+            out.append(raw);
+        }
+
+        // 解析单元格引用中的列号（"AB12" -> 28），无效时返回 0
+        uint32_t parseColumn(std::string_view ref)
+        {
+            uint32_t col = 0;
+            for (char ch : ref) {
+                if (ch >= 'A' && ch <= 'Z') col = col * 26 + static_cast<uint32_t>(ch - 'A' + 1);
+                else if (ch >= 'a' && ch <= 'z') col = col * 26 + static_cast<uint32_t>(ch - 'a' + 1);
+                else break;
+            }
+            return col;
+        }
+
+        uint32_t parseNumber(std::string_view text)
+        {
+            uint32_t n = 0;
+            for (char ch : text) {
+                if (ch < '0' || ch > '9') break;
+                n = n * 10 + static_cast<uint32_t>(ch - '0');
+            }
+            return n;
+        }
+
+        // 将关系 Target 解析为压缩包内的条目名（base 为关系所属目录）
+        std::string resolveEntry(const std::string& base, const std::string& target)
+        {
+            if (!target.empty() && target[0] == '/') return target.substr(1);
+            return (std::filesystem::path(base) / target).lexically_normal().generic_string();
+        }
+
+        bool endsWith(std::string_view s, std::string_view suffix)
+        {
+            return s.size() >= suffix.size() && s.substr(s.size() - suffix.size()) == suffix;
+        }
+
+        // 当前行中一个单元格的值位置：共享字符串索引或行缓冲中的偏移
+        struct PendingCell {
+            uint32_t column;
+            CellKind kind;
+            bool shared;
+            size_t offset;
+            size_t length;
+        };
+    } // namespace
+
+    struct XLRowReader::Impl {
+        std::shared_ptr<XLArchive> archive;
+        std::unique_ptr<XmlPullParser> parser;
+
+        // 共享字符串表：所有文本连续存放，按偏移取出
+        std::string sstText;
+        std::vector<size_t> sstOffsets;
+
+        bool inSheetData = false;
+        bool finished = false;
+        bool error = false;
+        uint32_t currentRow = 0;
+        std::string rowText;
+        std::vector<PendingCell> pending;
+        std::vector<RowCell> rowCells;
+
+        std::string_view sharedString(size_t index) const
+        {
+            if (index + 1 >= sstOffsets.size()) return {};
+            return std::string_view(sstText).substr(sstOffsets[index], sstOffsets[index + 1] - sstOffsets[index]);
+        }
+
+        void loadSharedStrings(const std::string& entry)
+        {
+            sstText.clear();
+            sstOffsets.assign(1, 0);
+            auto source = archive->openEntryStream(entry);
+            if (!source) return;
+
+            XmlPullParser sst(std::move(source));
+            bool inPhonetic = false;
+            bool inText = false;
+            for (auto ev = sst.next(); ev != XmlPullParser::Event::End; ev = sst.next()) {
+                std::string_view name = sst.name();
+                if (ev == XmlPullParser::Event::StartElement) {
+                    if (name == "rPh") inPhonetic = true;
+                    else if (name == "t") inText = !inPhonetic;
+                } else if (ev == XmlPullParser::Event::EndElement) {
+                    if (name == "rPh") inPhonetic = false;
+                    else if (name == "t") inText = false;
+                    else if (name == "si") sstOffsets.push_back(sstText.size());
+                } else if (inText) {
+                    if (sst.isCData()) sstText.append(sst.text());
+                    else appendDecoded(sstText, sst.text());
+                }
+            }
+        }
+
+        // 读取到下一个 </row> 为止，返回 false 表示工作表结束
+        bool readRow()
+        {
+            rowText.clear();
+            pending.clear();
+            rowCells.clear();
+
+            bool inRow = false;
+            bool inCell = false;
+            bool inValue = false;
+            bool inInline = false;
+            bool inPhonetic = false;
+            bool inText = false;
+            bool hasValue = false;
+            uint32_t column = 0;
+            char cellType = 'n';
+            size_t valueStart = 0;
+
+            for (;;) {
+                auto ev = parser->next();
+                if (ev == XmlPullParser::Event::End) {
+                    if (inSheetData) throw std::runtime_error("unexpected end of worksheet");
+                    return false;
+                }
+                std::string_view name = parser->name();
+                if (!inSheetData) {
+                    if (ev == XmlPullParser::Event::StartElement && name == "sheetData") inSheetData = true;
+                    continue;
+                }
+
+                if (ev == XmlPullParser::Event::StartElement) {
+                    if (name == "row") {
+                        std::string_view r = parser->attribute("r");
+                        currentRow = r.empty() ? currentRow + 1 : parseNumber(r);
+                        column = 0;
+                        inRow = true;
+                    } else if (inRow && name == "c") {
+                        std::string_view r = parser->attribute("r");
+                        uint32_t parsed = r.empty() ? 0 : parseColumn(r);
+                        column = parsed ? parsed : column + 1;
+                        std::string_view t = parser->attribute("t");
+                        if (t == "s") cellType = 's';
+                        else if (t == "inlineStr") cellType = 'i';
+                        else if (t == "b") cellType = 'b';
+                        else if (t == "e") cellType = 'e';
+                        else if (t == "str" || t == "d") cellType = 't';
+                        else cellType = 'n';
+                        inCell = true;
+                        hasValue = false;
+                        valueStart = rowText.size();
+                    } else if (inCell && name == "v") {
+                        inValue = true;
+                        hasValue = true;
+                    } else if (inCell && name == "is") {
+                        inInline = true;
+                        hasValue = true;
+                    } else if (inInline && name == "rPh") {
+                        inPhonetic = true;
+                    } else if (inInline && name == "t") {
+                        inText = !inPhonetic;
+                    }
+                } else if (ev == XmlPullParser::Event::EndElement) {
+                    if (name == "v") {
+                        inValue = false;
+                    } else if (name == "t") {
+                        inText = false;
+                    } else if (name == "rPh") {
+                        inPhonetic = false;
+                    } else if (name == "is") {
+                        inInline = false;
+                    } else if (name == "c" && inCell) {
+                        inCell = false;
+                        if (!hasValue) continue;
+                        size_t length = rowText.size() - valueStart;
+                        if (cellType == 's') {
+                            std::string_view text = std::string_view(rowText).substr(valueStart, length);
+                            // 空的 <v/> 没有引用任何共享字符串，按空单元格跳过
+                            if (text.empty()) continue;
+                            if (text.find_first_not_of("0123456789") != std::string_view::npos) {
+                                throw std::runtime_error("invalid shared string index");
+                            }
+                            size_t index = parseNumber(text);
+                            rowText.resize(valueStart);
+                            pending.push_back({column, CellKind::String, true, index, 0});
+                        } else {
+                            CellKind kind = cellType == 'b' ? CellKind::Boolean
+                                          : cellType == 'e' ? CellKind::Error
+                                          : cellType == 'n' ? CellKind::Number
+                                                            : CellKind::String;
+                            pending.push_back({column, kind, false, valueStart, length});
+                        }
+                    } else if (name == "row" && inRow) {
+                        for (const auto& cell : pending) {
+                            std::string_view value = cell.shared ? sharedString(cell.offset)
+                                                                 : std::string_view(rowText).substr(cell.offset, cell.length);
+                            rowCells.push_back({cell.column, cell.kind, value});
+                        }
+                        return true;
+                    } else if (name == "sheetData") {
+                        inSheetData = false;
+                        return false;
+                    }
+                } else if (inCell && (inValue || inText)) {
+                    if (parser->isCData()) rowText.append(parser->text());
+                    else appendDecoded(rowText, parser->text());
+                }
+            }
+        }
+    };
+
+    XLRowReader::XLRowReader() : impl_(new Impl()) {}
+    XLRowReader::~XLRowReader() { close(); delete impl_; }
+
+    bool XLRowReader::open(const std::string& path, const std::string& sheetName)
+    {
+        auto archive = std::make_shared<XLArchive>();
+        if (!archive->open(path)) return false;
+        return openSheet(std::move(archive), &sheetName, 0);
+    }
+
+    bool XLRowReader::open(const std::string& path, unsigned int sheetIndex)
+    {
+        auto archive = std::make_shared<XLArchive>();
+        if (!archive->open(path)) return false;
+        return openSheet(std::move(archive), nullptr, sheetIndex);
+    }
+
+    bool XLRowReader::open(std::shared_ptr<XLArchive> archive, const std::string& sheetName)
+    {
+        return openSheet(std::move(archive), &sheetName, 0);
+    }
+
+    bool XLRowReader::open(std::shared_ptr<XLArchive> archive, unsigned int sheetIndex)
+    {
+        return openSheet(std::move(archive), nullptr, sheetIndex);
+    }
+
+    bool XLRowReader::openSheet(std::shared_ptr<XLArchive> archive, const std::string* sheetName, unsigned int sheetIndex)
+    {
+        close();
+        if (!archive || !archive->isOpen()) return false;
+        try {
+            // workbook.xml 与其关系文件很小，直接用 pugixml 解析
+            auto workbookXml = archive->getEntry("xl/workbook.xml");
+            auto relsXml = archive->getEntry("xl/_rels/workbook.xml.rels");
+            pugi::xml_document workbookDoc;
+            pugi::xml_document relsDoc;
+            if (!workbookXml || !workbookDoc.load_buffer(workbookXml->data(), workbookXml->size()) ||
+                !relsXml || !relsDoc.load_buffer(relsXml->data(), relsXml->size())) {
+                std::cerr << "XLRowReader::open error: failed to read workbook" << std::endl;
+                return false;
+            }
+
+            std::string rId;
+            unsigned int index = 0;
+            for (pugi::xml_node sheet : workbookDoc.child("workbook").child("sheets").children("sheet")) {
+                if (sheetName ? *sheetName == sheet.attribute("name").as_string() : index == sheetIndex) {
+                    rId = sheet.attribute("r:id").as_string();
+                    break;
+                }
+                ++index;
+            }
+            if (rId.empty()) {
+                std::cerr << "XLRowReader::open error: sheet not found" << std::endl;
+                return false;
+            }
+
+            std::string sheetEntry;
+            std::string sharedStringsEntry = "xl/sharedStrings.xml";
+            for (pugi::xml_node rel : relsDoc.child("Relationships").children("Relationship")) {
+                std::string type = rel.attribute("Type").as_string();
+                if (rId == rel.attribute("Id").as_string()) sheetEntry = resolveEntry("xl", rel.attribute("Target").as_string());
+                else if (endsWith(type, "/sharedStrings")) sharedStringsEntry = resolveEntry("xl", rel.attribute("Target").as_string());
+            }
+
+            impl_->archive = std::move(archive);
+            auto source = sheetEntry.empty() ? nullptr : impl_->archive->openEntryStream(sheetEntry);
+            if (!source) {
+                std::cerr << "XLRowReader::open error: worksheet entry not found: " << sheetEntry << std::endl;
+                close();
+                return false;
+            }
+            impl_->loadSharedStrings(sharedStringsEntry);
+            impl_->parser = std::make_unique<XmlPullParser>(std::move(source));
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "XLRowReader::open error: " << e.what() << std::endl;
+            close();
+            return false;
+        }
+    }
+
+    void XLRowReader::close()
+    {
+        impl_->parser.reset();
+        impl_->archive.reset();
+        impl_->sstText.clear();
+        impl_->sstText.shrink_to_fit();
+        impl_->sstOffsets.clear();
+        impl_->sstOffsets.shrink_to_fit();
+        impl_->inSheetData = false;
+        impl_->finished = false;
+        impl_->error = false;
+        impl_->currentRow = 0;
+        impl_->rowText.clear();
+        impl_->pending.clear();
+        impl_->rowCells.clear();
+    }
+
+    bool XLRowReader::isOpen() const
+    {
+        return impl_->parser != nullptr;
+    }
+
+    bool XLRowReader::next()
+    {
+        if (!impl_->parser || impl_->finished) return false;
+        try {
+            if (impl_->readRow()) return true;
+        } catch (const std::exception& e) {
+            std::cerr << "XLRowReader::next error: " << e.what() << std::endl;
+            impl_->error = true;
+        }
+        impl_->finished = true;
+        impl_->rowCells.clear();
+        return false;
+    }
+
+    uint32_t XLRowReader::rowNumber() const
+    {
+        return impl_->currentRow;
+    }
+
+    std::span<const RowCell> XLRowReader::cells() const
+    {
+        return impl_->rowCells;
+    }
+
+    bool XLRowReader::hasError() const
+    {
+        return impl_->error;
+    }
+
+} // namespace cc::neolux::utils::MiniXLSX
@@ -3,19 +3,78 @@
 #include "cc/neolux/utils/MiniXLSX/XLDocument.hpp"
 #include "cc/neolux/utils/MiniXLSX/XLCellData.hpp"
 #include "cc/neolux/utils/MiniXLSX/XLCellPicture.hpp"
+#include "cc/neolux/utils/MiniXLSX/XLArchive.hpp"
 #include <filesystem>
-#include <fstream>
 #include <iostream>
 #include <string>
 #include <memory>
-#include <map>
 #include <unordered_map>
 #include <algorithm>
+#include <charconv>
+#include <cmath>
 #include <pugixml.hpp>
 #include "cc/neolux/utils/MiniXLSX/Types.hpp"
 
 namespace cc::neolux::utils::MiniXLSX
 {
+    namespace
+    {
+        // 从文档共享的压缩包中读取条目
+        std::optional<std::string> readEntry(XLWorkbook* wb, const std::string& name)
+        {
+            XLArchive* archive = wb->getDocument().getArchive();
+            if (!archive) return std::nullopt;
+            return archive->getEntry(name);
+        }
+
+        // 将关系 Target 解析为压缩包内的条目名（base 为关系所属目录）
+        std::string resolveEntry(const std::string& base, const std::string& target)
+        {
+            if (!target.empty() && target[0] == '/') return target.substr(1);
+            return (std::filesystem::path(base) / target).lexically_normal().generic_string();
+        }
+
+        // 追加转义后的 XML 文本
+        void appendEscaped(std::string& out, std::string_view text)
+        {
+            for (char ch : text) {
+                switch (ch) {
+                    case '&': out += "&amp;"; break;
+                    case '<': out += "&lt;"; break;
+                    case '>': out += "&gt;"; break;
+                    case '"': out += "&quot;"; break;
+                    default: out += ch; break;
+                }
+            }
+        }
+
+        // 按类型读取的值写入存储时对应的原始文本与 t 属性
+        const XLCellStore::Slot& storeValue(XLCellStore& cells, uint32_t row, uint16_t column, const CellValueView& value)
+        {
+            char buffer[32];
+            if (const auto* integer = std::get_if<int64_t>(&value)) {
+                auto result = std::to_chars(buffer, buffer + sizeof(buffer), *integer);
+                return cells.set(row, column, std::string_view(buffer, static_cast<size_t>(result.ptr - buffer)), "n");
+            }
+            if (const auto* number = std::get_if<double>(&value)) {
+                auto result = std::to_chars(buffer, buffer + sizeof(buffer), *number);
+                return cells.set(row, column, std::string_view(buffer, static_cast<size_t>(result.ptr - buffer)), "n");
+            }
+            if (const auto* boolean = std::get_if<bool>(&value)) return cells.set(row, column, *boolean ? "1" : "0", "b");
+            if (const auto* error = std::get_if<CellError>(&value)) return cells.set(row, column, error->code, "e");
+            if (const auto* text = std::get_if<std::string_view>(&value)) return cells.set(row, column, *text, "str");
+            return cells.set(row, column, std::string_view(), "str");
+        }
+
+        // 解析单元格引用为行列号，列号超出 uint16_t 时视为无效
+        bool parseCellReference(const std::string& ref, uint32_t& row, uint16_t& column)
+        {
+            uint32_t col = 0;
+            if (!XLCellStore::parseReference(ref, row, col) || col > UINT16_MAX) return false;
+            column = static_cast<uint16_t>(col);
+            return true;
+        }
+    } // namespace
 
     std::string XLSheet::columnNumberToLetter(int col)
     {
@@ -49,14 +108,13 @@ namespace cc::neolux::utils::MiniXLSX
             return true;
         }
         namespace fs = std::filesystem;
-        fs::path temp = workbook->getDocument().getTempDir();
 
         // 使用 pugixml 加载共享字符串
-        fs::path sharedStringsPath = temp / "xl" / "sharedStrings.xml";
-        if (fs::exists(sharedStringsPath))
+        auto sharedStringsXml = readEntry(workbook, "xl/sharedStrings.xml");
+        if (sharedStringsXml)
         {
             pugi::xml_document sdoc;
-            pugi::xml_parse_result sres = sdoc.load_file(sharedStringsPath.c_str());
+            pugi::xml_parse_result sres = sdoc.load_buffer(sharedStringsXml->data(), sharedStringsXml->size());
             if (sres)
             {
                 pugi::xml_node sst = sdoc.child("sst");
@@ -82,9 +140,9 @@ namespace cc::neolux::utils::MiniXLSX
         }
 
         // 通过 rId 在 workbook 关系中定位工作表路径
-        fs::path relsPath = temp / "xl" / "_rels" / "workbook.xml.rels";
+        auto relsXml = readEntry(workbook, "xl/_rels/workbook.xml.rels");
         pugi::xml_document relsDoc;
-        if (!fs::exists(relsPath) || !relsDoc.load_file(relsPath.c_str()))
+        if (!relsXml || !relsDoc.load_buffer(relsXml->data(), relsXml->size()))
         {
             std::cerr << "Failed to open workbook.xml.rels" << std::endl;
             return false;
@@ -108,9 +166,10 @@ namespace cc::neolux::utils::MiniXLSX
             return false;
         }
 
-        fs::path sheetPath = temp / "xl" / target;
+        std::string sheetPath = resolveEntry("xl", target);
+        auto sheetXml = readEntry(workbook, sheetPath);
         pugi::xml_document sheetDoc;
-        if (!fs::exists(sheetPath) || !sheetDoc.load_file(sheetPath.c_str()))
+        if (!sheetXml || !sheetDoc.load_buffer(sheetXml->data(), sheetXml->size()))
         {
             std::cerr << "Failed to open sheet: " << sheetPath << std::endl;
             return false;
@@ -129,9 +188,10 @@ namespace cc::neolux::utils::MiniXLSX
         {
             for (pugi::xml_node c : row.children("c"))
             {
-                std::string ref = c.attribute("r").as_string();
-                std::string type = c.attribute("t").as_string();
-                std::string value;
+                uint32_t rowNumber = 0, column = 0;
+                if (!XLCellStore::parseReference(c.attribute("r").as_string(), rowNumber, column)) continue;
+                std::string_view type = c.attribute("t").as_string();
+                std::string_view value;
 
                 pugi::xml_node v = c.child("v");
                 if (v)
@@ -148,10 +208,7 @@ namespace cc::neolux::utils::MiniXLSX
                     }
                 }
 
-                if (!ref.empty())
-                {
-                    cells[ref] = std::make_unique<XLCellData>(ref, value, type.empty() ? "n" : type, sharedStrings);
-                }
+                cells.set(rowNumber, column, value, type, c.attribute("s").as_uint());
             }
         }
 
@@ -164,9 +221,11 @@ namespace cc::neolux::utils::MiniXLSX
             {
                 std::string drawingRId = ridAttr.value();
 
-                fs::path sheetRelsPath = temp / "xl" / "worksheets" / "_rels" / (fs::path(target).filename().string() + ".rels");
+                fs::path sheetEntry(sheetPath);
+                std::string sheetRelsPath = (sheetEntry.parent_path() / "_rels" / (sheetEntry.filename().string() + ".rels")).generic_string();
+                auto sheetRelsXml = readEntry(workbook, sheetRelsPath);
                 pugi::xml_document sheetRelsDoc;
-                if (fs::exists(sheetRelsPath) && sheetRelsDoc.load_file(sheetRelsPath.c_str()))
+                if (sheetRelsXml && sheetRelsDoc.load_buffer(sheetRelsXml->data(), sheetRelsXml->size()))
                 {
                     std::string drawingTarget;
                     pugi::xml_node sroot = sheetRelsDoc.child("Relationships");
@@ -181,14 +240,14 @@ namespace cc::neolux::utils::MiniXLSX
 
                     if (!drawingTarget.empty())
                     {
-                        fs::path drawingPath = (temp / "xl" / "worksheets" / drawingTarget).lexically_normal();
-                        fs::path drawingRelsPath = drawingPath.parent_path() / "_rels" / (drawingPath.filename().string() + ".rels");
+                        fs::path drawingPath = resolveEntry(sheetEntry.parent_path().generic_string(), drawingTarget);
+                        std::string drawingRelsPath = (drawingPath.parent_path() / "_rels" / (drawingPath.filename().string() + ".rels")).generic_string();
 
                         // 读取 drawing 的关系文件，构建图片映射
                         std::unordered_map<std::string, std::string> imageMap;
-                        if (fs::exists(drawingRelsPath)) {
+                        if (auto drawingRelsXml = readEntry(workbook, drawingRelsPath)) {
                             pugi::xml_document drelDoc;
-                            if (drelDoc.load_file(drawingRelsPath.c_str())) {
+                            if (drelDoc.load_buffer(drawingRelsXml->data(), drawingRelsXml->size())) {
                                 pugi::xml_node droot = drelDoc.child("Relationships");
                                 for (pugi::xml_node rel : droot.children("Relationship")) {
                                     std::string type = rel.attribute("Type").as_string();
@@ -200,10 +259,8 @@ namespace cc::neolux::utils::MiniXLSX
                         }
 
                         // 读取 drawing XML，查找 <xdr:twoCellAnchor>
-                        if (fs::exists(drawingPath)) {
-                            std::ifstream drawingFile(drawingPath);
-                            std::string drawingContent((std::istreambuf_iterator<char>(drawingFile)), std::istreambuf_iterator<char>());
-                            drawingFile.close();
+                        if (auto drawingXml = readEntry(workbook, drawingPath.generic_string())) {
+                            const std::string& drawingContent = *drawingXml;
 
                             size_t anchorPos = 0;
                             while ((anchorPos = drawingContent.find("<xdr:twoCellAnchor", anchorPos)) != std::string::npos)
@@ -268,7 +325,7 @@ namespace cc::neolux::utils::MiniXLSX
                                         pi.ref = ref;
                                         pi.fileName = imageFileName;
                                         pi.relativePath = relPath;
-                                        cells[ref] = std::make_unique<XLCellPicture>(pi.ref, pi.fileName, pi.relativePath);
+                                        addPicture(pi.ref, pi.fileName, pi.relativePath);
                                     }
                                 }
 
@@ -289,183 +346,318 @@ namespace cc::neolux::utils::MiniXLSX
     }
 
     const XLCell* XLSheet::getCell(const std::string& ref) const
+    {
+        uint32_t row = 0;
+        uint16_t column = 0;
+        if (!parseCellReference(ref, row, column)) return nullptr;
+        return getCell(row, column);
+    }
+
+    const XLCell* XLSheet::getCell(uint32_t row, uint16_t column) const
     {
         // 若由封装提供数据，则按需获取并缓存
         if (oxWrapper && oxWrapper->isOpen()) {
+            auto nonConstThis = const_cast<XLSheet*>(this);
             // 仅在首次访问时加载图片缓存
             if (!picturesLoaded) {
                 try {
                     if (pictureReader) {
-                        auto pics = pictureReader->getPictures(oxSheetIndex);
-                        auto nonConstThis = const_cast<XLSheet*>(this);
-                        for (const auto &pi : pics) {
-                            nonConstThis->cells[pi.ref] = std::make_unique<XLCellPicture>(pi.ref, pi.fileName, pi.relativePath);
+                        for (const auto &pi : pictureReader->getPictures(oxSheetIndex)) {
+                            nonConstThis->addPicture(pi.ref, pi.fileName, pi.relativePath);
                         }
                     }
                 } catch (...) {}
                 picturesLoaded = true;
             }
 
-            auto it = cells.find(ref);
-            if (it != cells.end()) return it->second.get();
-            auto v = oxWrapper->getCellValue(oxSheetIndex, ref);
-            if (v.has_value()) {
-                // 在 const 方法中创建可变缓存
-                auto nonConstThis = const_cast<XLSheet*>(this);
-                nonConstThis->cells[ref] = std::make_unique<XLCellData>(ref, v.value(), std::string("str"), std::vector<std::string>());
-                return nonConstThis->cells[ref].get();
-            }
-            return nullptr;
-        }
-
-        // 兜底：若封装未提供图片信息，尝试从解压目录解析
-        try {
-            namespace fs = std::filesystem;
-            fs::path temp = workbook->getDocument().getTempDir();
-            fs::path sheetPath = temp / "xl" / "worksheets" / (std::string("sheet") + std::to_string(oxSheetIndex + 1) + ".xml");
-            if (fs::exists(sheetPath)) {
-                pugi::xml_document sheetDoc;
-                if (sheetDoc.load_file(sheetPath.c_str())) {
-                    pugi::xml_node worksheet = sheetDoc.child("worksheet");
-                    pugi::xml_node drawingNode = worksheet.child("drawing");
-                    if (drawingNode) {
-                        std::string drawingRId = drawingNode.attribute("r:id").as_string();
-                        fs::path sheetRelsPath = sheetPath.parent_path() / "_rels" / (sheetPath.filename().string() + ".rels");
-                        std::string drawingTarget;
-                        if (fs::exists(sheetRelsPath)) {
-                            pugi::xml_document sheetRelsDoc;
-                            if (sheetRelsDoc.load_file(sheetRelsPath.c_str())) {
-                                pugi::xml_node sroot = sheetRelsDoc.child("Relationships");
-                                for (pugi::xml_node rel : sroot.children("Relationship")) {
-                                    if (std::string(rel.attribute("Id").as_string()) == drawingRId) {
-                                        drawingTarget = rel.attribute("Target").as_string();
-                                        break;
-                                    }
-                                }
-                            }
-                        }
-
-                        if (!drawingTarget.empty()) {
-                            fs::path drawingPath = (temp / "xl" / drawingTarget).lexically_normal();
-                            fs::path drawingRelsPath = drawingPath.parent_path() / "_rels" / (drawingPath.filename().string() + ".rels");
-                            std::unordered_map<std::string, std::string> imageMap;
-                            if (fs::exists(drawingRelsPath)) {
-                                pugi::xml_document drelDoc;
-                                if (drelDoc.load_file(drawingRelsPath.c_str())) {
-                                    pugi::xml_node droot = drelDoc.child("Relationships");
-                                    for (pugi::xml_node rel : droot.children("Relationship")) {
-                                        std::string type = rel.attribute("Type").as_string();
-                                        if (type.find("image") != std::string::npos) {
-                                            imageMap[rel.attribute("Id").as_string()] = rel.attribute("Target").as_string();
-                                        }
-                                    }
-                                }
-                            }
+            if (const auto* slot = cells.find(row, column)) return cellView(*slot);
+            auto v = oxWrapper->getValue(oxSheetIndex, row, column);
+            if (!v.has_value() || std::holds_alternative<std::monostate>(*v)) return nullptr;
+            // 在 const 方法中创建可变缓存，按读取到的类型保存
+            return cellView(storeValue(nonConstThis->cells, row, column, *v));
+        }
 
-                            if (fs::exists(drawingPath)) {
-                                std::ifstream drawingFile(drawingPath);
-                                std::string drawingContent((std::istreambuf_iterator<char>(drawingFile)), std::istreambuf_iterator<char>());
-                                drawingFile.close();
-                                size_t anchorPos = 0;
-                                auto nonConstThis = const_cast<XLSheet*>(this);
-                                while ((anchorPos = drawingContent.find("<xdr:twoCellAnchor", anchorPos)) != std::string::npos) {
-                                    size_t anchorEnd = drawingContent.find("</xdr:twoCellAnchor>", anchorPos);
-                                    if (anchorEnd == std::string::npos) break;
-                                    std::string anchorTag = drawingContent.substr(anchorPos, anchorEnd - anchorPos + 20);
-                                    size_t fromPos = anchorTag.find("<xdr:from>");
-                                    int fromCol = -1, fromRow = -1;
-                                    if (fromPos != std::string::npos) {
-                                        size_t colPos = anchorTag.find("<xdr:col>", fromPos);
-                                        if (colPos != std::string::npos) {
-                                            colPos += 9;
-                                            size_t colEnd = anchorTag.find("</xdr:col>", colPos);
-                                            if (colEnd != std::string::npos) fromCol = std::stoi(anchorTag.substr(colPos, colEnd - colPos));
-                                        }
-                                        size_t rowPos = anchorTag.find("<xdr:row>", fromPos);
-                                        if (rowPos != std::string::npos) {
-                                            rowPos += 9;
-                                            size_t rowEnd = anchorTag.find("</xdr:row>", rowPos);
-                                            if (rowEnd != std::string::npos) fromRow = std::stoi(anchorTag.substr(rowPos, rowEnd - rowPos));
-                                        }
-                                    }
-                                    size_t embedPos = anchorTag.find("r:embed=\"");
-                                    std::string embedId;
-                                    if (embedPos != std::string::npos) {
-                                        embedPos += 9;
-                                        size_t embedEnd = anchorTag.find("\"", embedPos);
-                                        if (embedEnd != std::string::npos) embedId = anchorTag.substr(embedPos, embedEnd - embedPos);
-                                    }
-                                    if (fromCol >= 0 && fromRow >= 0 && !embedId.empty()) {
-                                        std::string cellRef = XLSheet::columnNumberToLetter(fromCol) + std::to_string(fromRow + 1);
-                                        auto itImg = imageMap.find(embedId);
-                                        if (itImg != imageMap.end()) {
-                                            std::filesystem::path imagePath(itImg->second);
-                                            std::string imageFileName = imagePath.filename().string();
-                                            std::string relPath = imagePath.parent_path().string();
-                                            if (relPath == "../media") relPath = "media";
-                                            nonConstThis->cells[cellRef] = std::make_unique<XLCellPicture>(cellRef, imageFileName, relPath);
-                                        }
-                                    }
-                                    anchorPos = anchorEnd + 20;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        } catch(...) {}
+        // 旧版解析路径下 load() 已加载全部单元格与图片
+        const auto* slot = cells.find(row, column);
+        return slot ? cellView(*slot) : nullptr;
+    }
 
-        return nullptr;
+    const XLCell* XLSheet::cellView(const XLCellStore::Slot& slot) const
+    {
+        if (slot.kind == XLCellStore::Kind::Picture) {
+            return slot.index < pictures.size() ? pictures[slot.index].get() : nullptr;
+        }
 
-        auto it = cells.find(ref);
-        if (it != cells.end())
-        {
-            return it->second.get();
+        auto& view = cellViews[slot.key];
+        if (!view) {
+            std::string_view type = XLCellStore::typeName(slot.kind);
+            view = std::make_unique<XLCellData>(XLCellStore::makeReference(slot.row(), slot.column()), cells.rawValue(slot),
+                                                type.empty() ? std::string("n") : std::string(type), sharedStrings);
         }
-        return nullptr;
+        return view.get();
+    }
+
+    void XLSheet::addPicture(const std::string& ref, const std::string& fileName, const std::string& relPath)
+    {
+        uint32_t row = 0, column = 0;
+        if (!XLCellStore::parseReference(ref, row, column)) return;
+        cells.setPicture(row, column, static_cast<uint32_t>(pictures.size()));
+        pictures.push_back(std::make_unique<XLCellPicture>(ref, fileName, relPath));
+        cellViews.erase(XLCellStore::makeKey(row, column));
     }
 
     std::string XLSheet::getCellValue(const std::string& ref) const
+    {
+        uint32_t row = 0;
+        uint16_t column = 0;
+        if (!parseCellReference(ref, row, column)) return "";
+        return getCellValue(row, column);
+    }
+
+    std::string XLSheet::getCellValue(uint32_t row, uint16_t column) const
     {
         if (oxWrapper && oxWrapper->isOpen()) {
-            auto v = oxWrapper->getCellValue(oxSheetIndex, ref);
+            auto v = oxWrapper->getCellValue(oxSheetIndex, row, column);
             if (v.has_value()) return v.value();
             return std::string();
         }
 
-        const XLCell* cell = getCell(ref);
-        if (cell)
-        {
-            return cell->getValue();
+        const auto* slot = cells.find(row, column);
+        return slot ? getCellValue(*slot) : "";
+    }
+
+    std::string_view XLSheet::getCellText(const std::string& ref) const
+    {
+        uint32_t row = 0;
+        uint16_t column = 0;
+        if (!parseCellReference(ref, row, column)) return {};
+        return getCellText(row, column);
+    }
+
+    std::string_view XLSheet::getCellText(uint32_t row, uint16_t column) const
+    {
+        if (oxWrapper && oxWrapper->isOpen()) return oxWrapper->getCellText(oxSheetIndex, row, column).value_or(std::string_view());
+
+        const auto* slot = cells.find(row, column);
+        if (!slot) return {};
+        switch (slot->kind) {
+            case XLCellStore::Kind::Empty:
+                return {};
+            case XLCellStore::Kind::Boolean:
+                return slot->boolean ? "1" : "0";
+            case XLCellStore::Kind::SharedString:
+                return slot->index < sharedStrings.size() ? std::string_view(sharedStrings[slot->index]) : std::string_view();
+            case XLCellStore::Kind::Number:
+            case XLCellStore::Kind::Picture: {
+                // 数值只以 double 保存，由缓存的单元格对象持有格式化后的文本
+                const XLCell* cell = cellView(*slot);
+                return cell ? cell->getValueView() : std::string_view();
+            }
+            default:
+                return cells.text(*slot);
+        }
+    }
+
+    std::optional<CellValueView> XLSheet::getValue(const std::string& ref) const
+    {
+        uint32_t row = 0;
+        uint16_t column = 0;
+        if (!parseCellReference(ref, row, column)) return std::nullopt;
+        return getValue(row, column);
+    }
+
+    std::optional<CellValueView> XLSheet::getValue(uint32_t row, uint16_t column) const
+    {
+        if (oxWrapper && oxWrapper->isOpen()) return oxWrapper->getValue(oxSheetIndex, row, column);
+
+        const auto* slot = cells.find(row, column);
+        return slot ? getValue(*slot) : CellValueView{};
+    }
+
+    CellValueView XLSheet::getValue(const XLCellStore::Slot& cell) const
+    {
+        switch (cell.kind) {
+            case XLCellStore::Kind::Empty:
+                return std::monostate{};
+            case XLCellStore::Kind::Number:
+                // 加载时数值统一按 double 保存，整数值仍以 int64_t 返回
+                if (std::trunc(cell.number) == cell.number && std::abs(cell.number) < 0x1p63) return static_cast<int64_t>(cell.number);
+                return cell.number;
+            case XLCellStore::Kind::Boolean:
+                return cell.boolean;
+            case XLCellStore::Kind::SharedString:
+                return cell.index < sharedStrings.size() ? std::string_view(sharedStrings[cell.index]) : std::string_view();
+            case XLCellStore::Kind::Error:
+                return CellError{cells.text(cell)};
+            case XLCellStore::Kind::Picture:
+                return cell.index < pictures.size() ? std::string_view(pictures[cell.index]->getImageFileName()) : std::string_view();
+            default:
+                return cells.text(cell);
         }
-        return "";
+    }
+
+    XLSheet::CellScan XLSheet::scanCells() const
+    {
+        CellScan scan;
+        scan.first.sheet = this;
+        if (oxWrapper && oxWrapper->isOpen()) {
+            scan.first.cursor = oxWrapper->cellCursor(oxSheetIndex);
+        } else {
+            scan.first.slot = cells.begin();
+            scan.first.slotEnd = cells.end();
+        }
+        scan.first.advance();
+        return scan;
+    }
+
+    XLSheet::CellIterator::reference XLSheet::CellIterator::operator*() const
+    {
+        // 封装模式下直接返回游标中的单元格，文本视图可能指向游标自己的缓冲区
+        return cursor ? cursor->cell() : current;
+    }
+
+    XLSheet::CellIterator& XLSheet::CellIterator::operator++()
+    {
+        advance();
+        return *this;
+    }
+
+    bool XLSheet::CellIterator::operator==(const CellIterator& other) const
+    {
+        if (atEnd || other.atEnd) return atEnd == other.atEnd;
+        return (**this).row == (*other).row && (**this).column == (*other).column;
+    }
+
+    void XLSheet::CellIterator::advance()
+    {
+        if (cursor) {
+            atEnd = !cursor->next();
+            return;
+        }
+        while (slot != slotEnd) {
+            const auto& cell = *slot++;
+            CellValueView value = sheet->getValue(cell);
+            if (std::holds_alternative<std::monostate>(value)) continue;
+            current = {cell.row(), static_cast<uint16_t>(cell.column()), value};
+            atEnd = false;
+            return;
+        }
+        atEnd = true;
+    }
+
+    std::string XLSheet::getCellValue(const XLCellStore::Slot& cell) const
+    {
+        if (cell.kind == XLCellStore::Kind::Picture) {
+            return cell.index < pictures.size() ? pictures[cell.index]->getValue() : std::string();
+        }
+        return cells.value(cell, sharedStrings);
+    }
+
+    std::optional<CellRange> XLSheet::getRange(const std::string& range, RangeOrder order) const
+    {
+        if (oxWrapper && oxWrapper->isOpen()) return oxWrapper->getRange(oxSheetIndex, range, order);
+
+        auto colon = range.find(':');
+        uint32_t row1 = 0, row2 = 0;
+        uint16_t col1 = 0, col2 = 0;
+        if (!parseCellReference(range.substr(0, colon), row1, col1)) return std::nullopt;
+        if (!parseCellReference(colon == std::string::npos ? range : range.substr(colon + 1), row2, col2)) return std::nullopt;
+
+        CellRange result;
+        result.firstRow = std::min(row1, row2);
+        result.firstColumn = std::min(col1, col2);
+        result.rows = std::max(row1, row2) - result.firstRow + 1;
+        result.columns = std::max(col1, col2) - result.firstColumn + 1;
+        result.order = order;
+        result.cells.resize(static_cast<size_t>(result.rows) * result.columns);
+        const uint32_t lastRow = result.firstRow + result.rows - 1;
+        const uint32_t lastColumn = result.firstColumn + result.columns - 1;
+
+        auto appendText = [&result](RangeCell& cell, std::string_view text) {
+            cell.offset = static_cast<uint32_t>(result.text.size());
+            cell.length = static_cast<uint32_t>(text.size());
+            result.text.append(text);
+        };
+        auto keyLess = [](const XLCellStore::Slot& slot, uint64_t key) { return slot.key < key; };
+
+        // 存储按行优先排序：每行从区域左边界二分定位，越过右边界后跳到下一行的左边界
+        auto it = std::lower_bound(cells.begin(), cells.end(), XLCellStore::makeKey(result.firstRow, result.firstColumn), keyLess);
+        while (it != cells.end() && it->row() <= lastRow) {
+            if (it->column() < result.firstColumn) {
+                it = std::lower_bound(it, cells.end(), XLCellStore::makeKey(it->row(), result.firstColumn), keyLess);
+                continue;
+            }
+            if (it->column() > lastColumn) {
+                it = std::lower_bound(it, cells.end(), XLCellStore::makeKey(it->row() + 1, result.firstColumn), keyLess);
+                continue;
+            }
+            RangeCell& cell = result.cells[result.index(it->row(), it->column())];
+            switch (it->kind) {
+                case XLCellStore::Kind::Empty:
+                    break;
+                case XLCellStore::Kind::Number:
+                    cell.kind = CellKind::Number;
+                    cell.number = it->number;
+                    break;
+                case XLCellStore::Kind::Boolean:
+                    cell.kind = CellKind::Boolean;
+                    cell.number = it->boolean ? 1 : 0;
+                    break;
+                case XLCellStore::Kind::Error:
+                    cell.kind = CellKind::Error;
+                    appendText(cell, cells.text(*it));
+                    break;
+                case XLCellStore::Kind::SharedString:
+                case XLCellStore::Kind::Picture:
+                    cell.kind = CellKind::String;
+                    appendText(cell, getCellValue(*it));
+                    break;
+                default:
+                    cell.kind = CellKind::String;
+                    appendText(cell, cells.text(*it));
+                    break;
+            }
+            ++it;
+        }
+        return result;
     }
 
     void XLSheet::setCellValue(const std::string& ref, const std::string& value, const std::string& type)
+    {
+        uint32_t row = 0;
+        uint16_t column = 0;
+        if (!parseCellReference(ref, row, column)) {
+            std::cerr << "XLSheet::setCellValue error: invalid cell reference " << ref << std::endl;
+            return;
+        }
+        setCellValue(row, column, value, type);
+    }
+
+    void XLSheet::setCellValue(uint32_t row, uint16_t column, const std::string& value, const std::string& type)
     {
         if (oxWrapper && oxWrapper->isOpen()) {
             // 委托给封装处理
-            oxWrapper->setCellValue(oxSheetIndex, ref, value);
+            oxWrapper->setCellValue(oxSheetIndex, row, column, value);
             workbook->getDocument().markModified();
+            // 已缓存的单元格同步更新，避免 getCell() 返回旧值
+            if (const auto* slot = cells.find(row, column); slot && slot->kind != XLCellStore::Kind::Picture) {
+                cells.set(row, column, value, "str");
+                if (auto it = cellViews.find(slot->key); it != cellViews.end()) {
+                    it->second->setValue(value);
+                    it->second->setType("str");
+                }
+            }
             return;
         }
 
-        auto it = cells.find(ref);
-        if (it != cells.end())
-        {
-            // 单元格存在则更新
-            XLCellData* dataCell = dynamic_cast<XLCellData*>(it->second.get());
-            if (dataCell)
-            {
-                dataCell->setValue(value);
-                dataCell->setType(type);
-            }
-        }
-        else
-        {
-            // 单元格不存在则创建
-            cells[ref] = std::make_unique<XLCellData>(ref, value, type, sharedStrings);
+        // 单元格存在则更新，不存在则创建
+        const auto& slot = cells.set(row, column, value, type);
+        if (auto it = cellViews.find(slot.key); it != cellViews.end()) {
+            it->second->setValue(cells.rawValue(slot));
+            std::string_view storedType = XLCellStore::typeName(slot.kind);
+            it->second->setType(storedType.empty() ? std::string("n") : std::string(storedType));
         }
+        modified = true;
         
         // 标记文档已修改
         workbook->getDocument().markModified();
@@ -473,18 +665,25 @@ namespace cc::neolux::utils::MiniXLSX
 
     bool XLSheet::save()
     {
+        // 封装模式下单元格修改已直接写入 OpenXLSX 文档
+        if (oxWrapper && oxWrapper->isOpen()) {
+            return true;
+        }
+
+        // 未修改的工作表保持压缩包中的原始条目，保存时直接复制压缩数据
+        if (!modified) {
+            return true;
+        }
+
         // 通过 rId 定位工作表文件路径
-        std::filesystem::path relsPath = workbook->getDocument().getTempDir() / "xl" / "_rels" / "workbook.xml.rels";
-        
-        std::ifstream relsFile(relsPath);
-        if (!relsFile.is_open())
+        auto relsXml = readEntry(workbook, "xl/_rels/workbook.xml.rels");
+        if (!relsXml)
         {
             std::cerr << "Failed to open workbook.xml.rels" << std::endl;
             return false;
         }
 
-        std::string relsContent((std::istreambuf_iterator<char>(relsFile)), std::istreambuf_iterator<char>());
-        relsFile.close();
+        const std::string& relsContent = *relsXml;
 
         std::string target;
         size_t relPos = 0;
@@ -529,18 +728,17 @@ namespace cc::neolux::utils::MiniXLSX
             return false;
         }
 
-        std::filesystem::path sheetPath = workbook->getDocument().getTempDir() / "xl" / target;
+        std::string sheetPath = resolveEntry("xl", target);
 
         // 读取当前工作表内容
-        std::ifstream sheetFile(sheetPath);
-        if (!sheetFile.is_open())
+        auto sheetXml = readEntry(workbook, sheetPath);
+        if (!sheetXml)
         {
             std::cerr << "Failed to open sheet: " << sheetPath << std::endl;
             return false;
         }
 
-        std::string sheetContent((std::istreambuf_iterator<char>(sheetFile)), std::istreambuf_iterator<char>());
-        sheetFile.close();
+        const std::string& sheetContent = *sheetXml;
 
         // 查找 sheetData 段
         size_t dataPos = sheetContent.find("<sheetData>");
@@ -557,110 +755,66 @@ namespace cc::neolux::utils::MiniXLSX
             return false;
         }
 
-        // 构建新的 sheetData 内容
-        std::string newSheetData = "<sheetData>\n";
+        // 按行优先顺序由单元格存储生成新的 sheetData（图片单元格不写入）
+        std::string newSheetData = "<sheetData>";
+        uint32_t currentRow = 0;
+        for (const auto& cell : cells)
+        {
+            if (cell.kind == XLCellStore::Kind::Picture) continue;
 
-        // 处理已有单元格并合并更新
-        std::map<std::string, std::string> cellXmlMap;
+            if (cell.row() != currentRow)
+            {
+                if (currentRow != 0) newSheetData += "</row>";
+                currentRow = cell.row();
+                newSheetData += "<row r=\"" + std::to_string(currentRow) + "\">";
+            }
 
-        // 解析已有单元格
-        std::string dataSection = sheetContent.substr(dataPos, dataEnd - dataPos + 13);
-        size_t cellPos = 0;
-        while ((cellPos = dataSection.find("<c ", cellPos)) != std::string::npos)
-        {
-            size_t tagEnd = dataSection.find("/>", cellPos);
-            bool isSelfClosing = (tagEnd != std::string::npos);
-            if (!isSelfClosing)
+            newSheetData += "<c r=\"" + XLCellStore::makeReference(cell.row(), cell.column()) + "\"";
+            if (cell.style != 0)
             {
-                tagEnd = dataSection.find("</c>", cellPos);
-                if (tagEnd == std::string::npos) break;
-                tagEnd += 3;
+                newSheetData += " s=\"" + std::to_string(cell.style) + "\"";
             }
-            else
+            std::string_view type = XLCellStore::typeName(cell.kind);
+            if (!type.empty())
             {
-                tagEnd += 1;
+                newSheetData += " t=\"";
+                newSheetData += type;
+                newSheetData += "\"";
             }
 
-            std::string cellTag = dataSection.substr(cellPos, tagEnd - cellPos + 1);
-
-            // 提取 r
-            size_t rStart = cellTag.find("r=\"");
-            std::string ref;
-            if (rStart != std::string::npos)
+            std::string value = cells.rawValue(cell);
+            if (value.empty())
             {
-                rStart += 3;
-                size_t rEnd = cellTag.find("\"", rStart);
-                if (rEnd != std::string::npos)
-                {
-                    ref = cellTag.substr(rStart, rEnd - rStart);
-                }
+                newSheetData += "/>";
             }
-
-            if (!ref.empty())
+            else if (cell.kind == XLCellStore::Kind::InlineString)
             {
-                cellXmlMap[ref] = cellTag;
+                newSheetData += "><is><t>";
+                appendEscaped(newSheetData, value);
+                newSheetData += "</t></is></c>";
             }
-
-            cellPos = tagEnd + 1;
-        }
-
-        // 合并当前内存中的单元格数据
-        for (const auto& cellPair : cells)
-        {
-            const std::string& ref = cellPair.first;
-            const XLCell* cell = cellPair.second.get();
-            
-            // 仅保存 XLCellData（不保存图片单元格）
-            const XLCellData* dataCell = dynamic_cast<const XLCellData*>(cell);
-            if (dataCell)
+            else
             {
-                std::string type = dataCell->getType();
-                std::string value = dataCell->getValue();
-                
-                // 生成单元格 XML
-                std::string cellXml = "<c r=\"" + ref + "\"";
-                if (!type.empty())
-                {
-                    cellXml += " t=\"" + type + "\"";
-                }
-                cellXml += ">";
-                
-                if (!value.empty())
-                {
-                    cellXml += "<v>" + value + "</v>";
-                }
-                
-                cellXml += "</c>\n";
-                
-                cellXmlMap[ref] = cellXml;
+                newSheetData += "><v>";
+                appendEscaped(newSheetData, value);
+                newSheetData += "</v></c>";
             }
         }
-
-        // 按引用排序
-        std::vector<std::pair<std::string, std::string>> sortedCells(cellXmlMap.begin(), cellXmlMap.end());
-        std::sort(sortedCells.begin(), sortedCells.end());
-
-        // 拼接新的 sheetData
-        for (const auto& cellPair : sortedCells)
-        {
-            newSheetData += cellPair.second;
-        }
-
+        if (currentRow != 0) newSheetData += "</row>";
         newSheetData += "</sheetData>";
 
         // 替换 sheetData 段
         std::string newSheetContent = sheetContent.substr(0, dataPos) + newSheetData + sheetContent.substr(dataEnd + 13);
 
-        // 写回文件
-        std::ofstream outSheetFile(sheetPath);
-        if (!outSheetFile.is_open())
+        // 写回压缩包，保存文档时生效
+        XLArchive* archive = workbook->getDocument().getArchive();
+        if (!archive)
         {
             std::cerr << "Failed to write sheet: " << sheetPath << std::endl;
             return false;
         }
-
-        outSheetFile << newSheetContent;
-        outSheetFile.close();
+        archive->setEntry(sheetPath, newSheetContent);
+        modified = false;
 
         return true;
     }
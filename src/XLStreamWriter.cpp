@@ -0,0 +1,452 @@
+#include "cc/neolux/utils/MiniXLSX/XLStreamWriter.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+
+// 压缩流写出使用 OpenXLSX 自带的 zip 实现（miniz）
+#include "OpenXLSX.hpp"
+
+namespace cc::neolux::utils::MiniXLSX
+{
+    namespace
+    {
+        constexpr size_t FlushThreshold = 64 * 1024;          // 行缓冲达到该大小后写入压缩流
+        constexpr size_t MaxDedupEntries = 65536;             // 共享字符串去重表的条目上限
+        constexpr size_t MaxDedupBytes = 8 * 1024 * 1024;     // 去重表中字符串的总字节上限
+        constexpr uint32_t MaxRows = 1048576;
+        constexpr size_t MaxColumns = 16384;
+
+        constexpr const char* XmlHeader = "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n";
+        constexpr const char* MainNs = "http://schemas.openxmlformats.org/spreadsheetml/2006/main";
+        constexpr const char* RelNs = "http://schemas.openxmlformats.org/officeDocument/2006/relationships";
+
+        struct FileCloser {
+            void operator()(std::FILE* f) const { if (f) std::fclose(f); }
+        };
+
+        // 追加 XML 转义后的文本，去掉 XML 1.0 不允许的控制字符
+        void appendEscaped(std::string& out, std::string_view text)
+        {
+            for (char ch : text) {
+                switch (ch) {
+                    case '&': out += "&amp;"; break;
+                    case '<': out += "&lt;"; break;
+                    case '>': out += "&gt;"; break;
+                    case '"': out += "&quot;"; break;
+                    default:
+                        if (static_cast<unsigned char>(ch) < 0x20 && ch != '\t' && ch != '\n' && ch != '\r') break;
+                        out.push_back(ch);
+                }
+            }
+        }
+
+        template <typename T>
+        void appendNumber(std::string& out, T value)
+        {
+            char buf[32];
+            auto res = std::to_chars(buf, buf + sizeof(buf), value);
+            out.append(buf, res.ptr);
+        }
+
+        // 列序号（从 0 开始）转列字母，如 0 -> "A"，27 -> "AB"
+        void appendColumn(std::string& out, size_t index)
+        {
+            char buf[4];
+            int len = 0;
+            size_t n = index + 1;
+            while (n > 0) {
+                buf[len++] = static_cast<char>('A' + (n - 1) % 26);
+                n = (n - 1) / 26;
+            }
+            while (len > 0) out.push_back(buf[--len]);
+        }
+
+        bool isValidSheetName(const std::string& name)
+        {
+            if (name.empty() || name.size() > 31 || name.front() == '\'' || name.back() == '\'') return false;
+            return name.find_first_of("[]:*?/\\") == std::string::npos;
+        }
+
+        // Excel 比较工作表名称时不区分大小写（此处按 ASCII 折叠）
+        bool sameSheetName(const std::string& a, const std::string& b)
+        {
+            if (a.size() != b.size()) return false;
+            for (size_t i = 0; i < a.size(); ++i) {
+                unsigned char x = static_cast<unsigned char>(a[i]);
+                unsigned char y = static_cast<unsigned char>(b[i]);
+                if (x >= 'A' && x <= 'Z') x = static_cast<unsigned char>(x - 'A' + 'a');
+                if (y >= 'A' && y <= 'Z') y = static_cast<unsigned char>(y - 'A' + 'a');
+                if (x != y) return false;
+            }
+            return true;
+        }
+    } // namespace
+
+    struct XLStreamWriter::Impl {
+        OpenXLSX::XLZipStreamWriter zip;
+        bool open = false;
+        std::vector<std::string> sheetNames;
+        bool inSheet = false;
+        uint32_t lastRow = 0;
+        std::string buffer;
+        std::string rowBuffer; // 正在构建的一行，整行成功后才追加到 buffer
+
+        // 共享字符串：正文写入临时文件，内存中只保留有上限的去重表
+        std::unique_ptr<std::FILE, FileCloser> spool;
+        std::unordered_map<std::string, uint32_t> dedup;
+        size_t dedupBytes = 0;
+        uint32_t uniqueCount = 0;
+        uint64_t totalCount = 0;
+        std::string scratch;
+
+        void flush()
+        {
+            zip.write(buffer);
+            buffer.clear();
+        }
+
+        // 自动创建工作表时使用第一个未被占用的 SheetN
+        std::string nextSheetName() const
+        {
+            for (size_t n = 1;; ++n) {
+                std::string name = "Sheet" + std::to_string(n);
+                bool taken = false;
+                for (const auto& existing : sheetNames) {
+                    if (sameSheetName(existing, name)) { taken = true; break; }
+                }
+                if (!taken) return name;
+            }
+        }
+
+        void beginSheet(const std::string& name)
+        {
+            endSheet();
+            sheetNames.push_back(name);
+            zip.beginEntry("xl/worksheets/sheet" + std::to_string(sheetNames.size()) + ".xml");
+            buffer = XmlHeader;
+            buffer += "<worksheet xmlns=\"";
+            buffer += MainNs;
+            buffer += "\" xmlns:r=\"";
+            buffer += RelNs;
+            buffer += "\"><sheetData>";
+            lastRow = 0;
+            inSheet = true;
+        }
+
+        void endSheet()
+        {
+            if (!inSheet) return;
+            buffer += "</sheetData></worksheet>";
+            flush();
+            zip.endEntry();
+            inSheet = false;
+        }
+
+        uint32_t sharedStringIndex(const std::string& text)
+        {
+            ++totalCount;
+            auto it = dedup.find(text);
+            if (it != dedup.end()) return it->second;
+
+            scratch = "<si><t xml:space=\"preserve\">";
+            appendEscaped(scratch, text);
+            scratch += "</t></si>";
+            if (std::fwrite(scratch.data(), 1, scratch.size(), spool.get()) != scratch.size()) {
+                throw std::runtime_error("failed to spool shared string");
+            }
+
+            uint32_t index = uniqueCount++;
+            // 去重表满后新字符串不再登记，重复出现时会作为新条目写入，以保证内存有上限
+            if (dedup.size() < MaxDedupEntries && dedupBytes + text.size() <= MaxDedupBytes) {
+                dedup.emplace(text, index);
+                dedupBytes += text.size();
+            }
+            return index;
+        }
+
+        void appendCell(std::string& out, uint32_t row, size_t col, const CellValue& value)
+        {
+            if (std::holds_alternative<std::monostate>(value)) return;
+
+            out += "<c r=\"";
+            appendColumn(out, col);
+            appendNumber(out, row);
+            out.push_back('"');
+            if (auto s = std::get_if<std::string>(&value)) {
+                out += " t=\"s\"><v>";
+                appendNumber(out, sharedStringIndex(*s));
+            } else if (auto i = std::get_if<int64_t>(&value)) {
+                out += "><v>";
+                appendNumber(out, *i);
+            } else if (auto d = std::get_if<double>(&value)) {
+                if (std::isfinite(*d)) {
+                    out += "><v>";
+                    appendNumber(out, *d);
+                } else {
+                    out += " t=\"e\"><v>#NUM!";
+                }
+            } else if (auto b = std::get_if<bool>(&value)) {
+                out += " t=\"b\"><v>";
+                out.push_back(*b ? '1' : '0');
+            }
+            out += "</v></c>";
+        }
+
+        void writeSharedStrings()
+        {
+            zip.beginEntry("xl/sharedStrings.xml");
+            std::string head = XmlHeader;
+            head += "<sst xmlns=\"";
+            head += MainNs;
+            head += "\" count=\"";
+            appendNumber(head, totalCount);
+            head += "\" uniqueCount=\"";
+            appendNumber(head, uniqueCount);
+            head += "\">";
+            zip.write(head);
+
+            std::FILE* f = spool.get();
+            if (std::fflush(f) != 0 || std::fseek(f, 0, SEEK_SET) != 0) {
+                throw std::runtime_error("failed to rewind shared string spool");
+            }
+            std::vector<char> chunk(FlushThreshold);
+            size_t n = 0;
+            while ((n = std::fread(chunk.data(), 1, chunk.size(), f)) > 0) {
+                zip.write(chunk.data(), n);
+            }
+            if (std::ferror(f)) throw std::runtime_error("failed to read shared string spool");
+
+            zip.write("</sst>");
+            zip.endEntry();
+        }
+
+        void writePackageParts()
+        {
+            std::string workbook = XmlHeader;
+            workbook += "<workbook xmlns=\"";
+            workbook += MainNs;
+            workbook += "\" xmlns:r=\"";
+            workbook += RelNs;
+            workbook += "\"><sheets>";
+            for (size_t i = 0; i < sheetNames.size(); ++i) {
+                workbook += "<sheet name=\"";
+                appendEscaped(workbook, sheetNames[i]);
+                workbook += "\" sheetId=\"" + std::to_string(i + 1) + "\" r:id=\"rId" + std::to_string(i + 1) + "\"/>";
+            }
+            workbook += "</sheets></workbook>";
+            zip.addEntry("xl/workbook.xml", workbook);
+
+            std::string rels = XmlHeader;
+            rels += "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">";
+            for (size_t i = 0; i < sheetNames.size(); ++i) {
+                rels += "<Relationship Id=\"rId" + std::to_string(i + 1) +
+                        "\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/worksheet\""
+                        " Target=\"worksheets/sheet" + std::to_string(i + 1) + ".xml\"/>";
+            }
+            size_t next = sheetNames.size() + 1;
+            rels += "<Relationship Id=\"rId" + std::to_string(next) +
+                    "\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/styles\" Target=\"styles.xml\"/>";
+            rels += "<Relationship Id=\"rId" + std::to_string(next + 1) +
+                    "\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/sharedStrings\" Target=\"sharedStrings.xml\"/>";
+            rels += "</Relationships>";
+            zip.addEntry("xl/_rels/workbook.xml.rels", rels);
+
+            std::string styles = XmlHeader;
+            styles += "<styleSheet xmlns=\"";
+            styles += MainNs;
+            styles += "\"><fonts count=\"1\"><font><sz val=\"11\"/><name val=\"Calibri\"/><family val=\"2\"/></font></fonts>"
+                      "<fills count=\"2\"><fill><patternFill patternType=\"none\"/></fill><fill><patternFill patternType=\"gray125\"/></fill></fills>"
+                      "<borders count=\"1\"><border><left/><right/><top/><bottom/><diagonal/></border></borders>"
+                      "<cellStyleXfs count=\"1\"><xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\"/></cellStyleXfs>"
+                      "<cellXfs count=\"1\"><xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\" xfId=\"0\"/></cellXfs>"
+                      "<cellStyles count=\"1\"><cellStyle name=\"Normal\" xfId=\"0\" builtinId=\"0\"/></cellStyles></styleSheet>";
+            zip.addEntry("xl/styles.xml", styles);
+
+            std::string types = XmlHeader;
+            types += "<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">"
+                     "<Default Extension=\"rels\" ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>"
+                     "<Default Extension=\"xml\" ContentType=\"application/xml\"/>"
+                     "<Override PartName=\"/xl/workbook.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.sheet.main+xml\"/>";
+            for (size_t i = 0; i < sheetNames.size(); ++i) {
+                types += "<Override PartName=\"/xl/worksheets/sheet" + std::to_string(i + 1) +
+                         ".xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.worksheet+xml\"/>";
+            }
+            types += "<Override PartName=\"/xl/styles.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.styles+xml\"/>"
+                     "<Override PartName=\"/xl/sharedStrings.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.sharedStrings+xml\"/>"
+                     "<Override PartName=\"/docProps/core.xml\" ContentType=\"application/vnd.openxmlformats-package.core-properties+xml\"/>"
+                     "<Override PartName=\"/docProps/app.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.extended-properties+xml\"/>"
+                     "</Types>";
+            zip.addEntry("[Content_Types].xml", types);
+
+            std::string rootRels = XmlHeader;
+            rootRels += "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+                        "<Relationship Id=\"rId1\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/officeDocument\" Target=\"xl/workbook.xml\"/>"
+                        "<Relationship Id=\"rId2\" Type=\"http://schemas.openxmlformats.org/package/2006/relationships/metadata/core-properties\" Target=\"docProps/core.xml\"/>"
+                        "<Relationship Id=\"rId3\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/extended-properties\" Target=\"docProps/app.xml\"/>"
+                        "</Relationships>";
+            zip.addEntry("_rels/.rels", rootRels);
+
+            std::string app = XmlHeader;
+            app += "<Properties xmlns=\"http://schemas.openxmlformats.org/officeDocument/2006/extended-properties\""
+                   " xmlns:vt=\"http://schemas.openxmlformats.org/officeDocument/2006/docPropsVTypes\">"
+                   "<Application>MiniXLSX</Application>"
+                   "<HeadingPairs><vt:vector size=\"2\" baseType=\"variant\"><vt:variant><vt:lpstr>Worksheets</vt:lpstr></vt:variant>"
+                   "<vt:variant><vt:i4>" + std::to_string(sheetNames.size()) + "</vt:i4></vt:variant></vt:vector></HeadingPairs>"
+                   "<TitlesOfParts><vt:vector size=\"" + std::to_string(sheetNames.size()) + "\" baseType=\"lpstr\">";
+            for (const auto& name : sheetNames) {
+                app += "<vt:lpstr>";
+                appendEscaped(app, name);
+                app += "</vt:lpstr>";
+            }
+            app += "</vt:vector></TitlesOfParts></Properties>";
+            zip.addEntry("docProps/app.xml", app);
+
+            std::string core = XmlHeader;
+            core += "<cp:coreProperties xmlns:cp=\"http://schemas.openxmlformats.org/package/2006/metadata/core-properties\""
+                    " xmlns:dc=\"http://purl.org/dc/elements/1.1/\" xmlns:dcterms=\"http://purl.org/dc/terms/\""
+                    " xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\"><dc:creator>MiniXLSX</dc:creator></cp:coreProperties>";
+            zip.addEntry("docProps/core.xml", core);
+        }
+
+        void reset()
+        {
+            open = false;
+            inSheet = false;
+            lastRow = 0;
+            sheetNames.clear();
+            buffer.clear();
+            buffer.shrink_to_fit();
+            rowBuffer.clear();
+            rowBuffer.shrink_to_fit();
+            spool.reset();
+            dedup.clear();
+            dedupBytes = 0;
+            uniqueCount = 0;
+            totalCount = 0;
+        }
+    };
+
+    XLStreamWriter::XLStreamWriter() : impl_(new Impl()) {}
+    XLStreamWriter::~XLStreamWriter() { close(); delete impl_; }
+
+    bool XLStreamWriter::open(const std::string& path)
+    {
+        close();
+        try {
+            impl_->spool.reset(std::tmpfile());
+            if (!impl_->spool) {
+                std::cerr << "XLStreamWriter::open error: failed to create shared string spool" << std::endl;
+                return false;
+            }
+            impl_->zip.open(path);
+            impl_->buffer.reserve(FlushThreshold + 4096);
+            impl_->open = true;
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "XLStreamWriter::open error: " << e.what() << std::endl;
+            impl_->reset();
+            return false;
+        }
+    }
+
+    bool XLStreamWriter::isOpen() const
+    {
+        return impl_->open;
+    }
+
+    bool XLStreamWriter::addSheet(const std::string& name)
+    {
+        if (!impl_->open) return false;
+        if (!isValidSheetName(name)) {
+            std::cerr << "XLStreamWriter::addSheet error: invalid sheet name: " << name << std::endl;
+            return false;
+        }
+        for (const auto& existing : impl_->sheetNames) {
+            if (sameSheetName(existing, name)) {
+                std::cerr << "XLStreamWriter::addSheet error: duplicate sheet name: " << name << std::endl;
+                return false;
+            }
+        }
+        try {
+            impl_->beginSheet(name);
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "XLStreamWriter::addSheet error: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    bool XLStreamWriter::appendRow(std::span<const CellValue> cells)
+    {
+        return writeRow(impl_->lastRow + 1, cells);
+    }
+
+    bool XLStreamWriter::appendRow(const std::vector<CellValue>& cells)
+    {
+        return appendRow(std::span<const CellValue>(cells));
+    }
+
+    bool XLStreamWriter::writeRow(uint32_t rowNumber, std::span<const CellValue> cells)
+    {
+        if (!impl_->open) return false;
+        if (!impl_->inSheet && !addSheet(impl_->nextSheetName())) return false;
+        if (rowNumber <= impl_->lastRow || rowNumber > MaxRows) {
+            std::cerr << "XLStreamWriter::writeRow error: row " << rowNumber << " is out of order or out of range" << std::endl;
+            return false;
+        }
+        if (cells.size() > MaxColumns) {
+            std::cerr << "XLStreamWriter::writeRow error: too many columns: " << cells.size() << std::endl;
+            return false;
+        }
+        try {
+            // 先在行缓冲区中构建整行，中途出错时不会把半行留在输出中
+            auto& row = impl_->rowBuffer;
+            row.clear();
+            row += "<row r=\"";
+            appendNumber(row, rowNumber);
+            row += "\">";
+            for (size_t col = 0; col < cells.size(); ++col) {
+                impl_->appendCell(row, rowNumber, col, cells[col]);
+            }
+            row += "</row>";
+            auto& buffer = impl_->buffer;
+            buffer += row;
+            impl_->lastRow = rowNumber;
+            if (buffer.size() >= FlushThreshold) impl_->flush();
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "XLStreamWriter::writeRow error: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    bool XLStreamWriter::writeRow(uint32_t rowNumber, const std::vector<CellValue>& cells)
+    {
+        return writeRow(rowNumber, std::span<const CellValue>(cells));
+    }
+
+    bool XLStreamWriter::close()
+    {
+        if (!impl_->open) return false;
+        bool ok = true;
+        try {
+            // 工作簿至少需要一个工作表
+            if (impl_->sheetNames.empty()) impl_->beginSheet("Sheet1");
+            impl_->endSheet();
+            impl_->writeSharedStrings();
+            impl_->writePackageParts();
+            impl_->zip.close();
+        } catch (const std::exception& e) {
+            std::cerr << "XLStreamWriter::close error: " << e.what() << std::endl;
+            impl_->zip = OpenXLSX::XLZipStreamWriter();
+            ok = false;
+        }
+        impl_->reset();
+        return ok;
+    }
+
+} // namespace cc::neolux::utils::MiniXLSX
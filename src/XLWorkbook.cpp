@@ -1,7 +1,7 @@
 #include "cc/neolux/utils/MiniXLSX/XLWorkbook.hpp"
 #include "cc/neolux/utils/MiniXLSX/XLDocument.hpp"
+#include "cc/neolux/utils/MiniXLSX/XLArchive.hpp"
 #include <filesystem>
-#include <fstream>
 #include <iostream>
 #include <string>
 
@@ -35,27 +35,27 @@ namespace cc::neolux::utils::MiniXLSX
             XLPictureReader* pr = document->getPictureReader();
             if (w && w->isOpen()) {
                 unsigned int cnt = w->sheetCount();
+                sheets.reserve(cnt);
+                sheetNames.reserve(cnt);
                 for (unsigned int i = 0; i < cnt; ++i) {
-                    std::string name = w->sheetName(i);
                     XLSheet* xlSheet = new XLSheet(*this, w, pr, i);
                     // 不调用 load()，由封装提供单元格访问
                     sheets.push_back(xlSheet);
-                    sheetNames.push_back(name);
+                    sheetNames.push_back(w->sheetName(i));
                 }
                 return true;
             }
         } catch(...) {}
 
-        std::filesystem::path workbookPath = document->getTempDir() / "xl" / "workbook.xml";
-        std::ifstream file(workbookPath);
-        if (!file.is_open())
+        XLArchive* archive = document->getArchive();
+        auto workbookXml = archive ? archive->getEntry("xl/workbook.xml") : std::nullopt;
+        if (!workbookXml)
         {
             std::cerr << "Failed to open workbook.xml" << std::endl;
             return false;
         }
 
-        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-        file.close();
+        const std::string& content = *workbookXml;
 
         // Simple parsing for <sheet name="..." sheetId="..." r:id="..."/>
         size_t pos = 0;
@@ -154,13 +154,8 @@ namespace cc::neolux::utils::MiniXLSX
     {
         try {
             OpenXLSXWrapper* w = document->getWrapper();
-            if (w && w->isOpen()) {
-                std::string name = w->sheetName(static_cast<unsigned int>(index));
-                // return as static copy to satisfy reference return — small hack for compatibility
-                static thread_local std::string tmp;
-                tmp = name;
-                return tmp;
-            }
+            // 封装内部缓存名称表，直接返回其稳定引用
+            if (w && w->isOpen()) return w->sheetName(static_cast<unsigned int>(index));
         } catch(...) {}
         if (index >= sheetNames.size())
         {
@@ -1,10 +1,41 @@
 #include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <span>
 #include "cc/neolux/utils/MiniXLSX/XLDocument.hpp"
 #include "cc/neolux/utils/MiniXLSX/XLCellPicture.hpp"
 #include "cc/neolux/utils/MiniXLSX/OpenXLSXWrapper.hpp"
+#include "cc/neolux/utils/MiniXLSX/XLArchive.hpp"
+#include "cc/neolux/utils/MiniXLSX/XLStreamWriter.hpp"
+#include "cc/neolux/utils/MiniXLSX/XLRowReader.hpp"
+#include "cc/neolux/utils/MiniXLSX/MiniXLSX.hpp"
+#include "cc/neolux/utils/MiniXLSX/XLCellStore.hpp"
+#include <OpenXLSX.hpp>
 
 using namespace cc::neolux::utils::MiniXLSX;
 
+// 构建测试夹具：Data 表 A1:D1 为 "hello"/42/3.5/true，A2:B2 为 "world"/"hello"，合并区域 E1:F2；
+// Second 表 A1 为 "s2"。返回临时目录中的文件路径，由调用方删除
+static std::string makeFixture(const std::string& name) {
+    auto path = (std::filesystem::temp_directory_path() / name).string();
+    OpenXLSX::XLDocument doc;
+    doc.create(path, true);
+    auto data = doc.workbook().worksheet(1);
+    data.setName("Data");
+    data.cell("A1").value() = "hello";
+    data.cell("B1").value() = int64_t{42};
+    data.cell("C1").value() = 3.5;
+    data.cell("D1").value() = true;
+    data.cell("A2").value() = "world";
+    data.cell("B2").value() = "hello";
+    data.mergeCells("E1:F2");
+    doc.workbook().addWorksheet("Second");
+    doc.workbook().worksheet("Second").cell("A1").value() = "s2";
+    doc.save();
+    doc.close();
+    return path;
+}
+
 TEST(MiniXLSX_Open, OpensValidFile) {
     XLDocument doc;
     const char* candidates[] = {"test.xlsx", "build/test.xlsx", "tests/../test.xlsx"};
@@ -112,3 +143,1093 @@ TEST(MiniXLSX_Wrapper, SheetIndexLookup) {
 
     wrapper.close();
 }
+
+TEST(MiniXLSX_Archive, SharedArchiveSaveRoundTrip) {
+    const auto path = makeFixture("minixlsx_shared_archive_fixture.xlsx");
+    XLDocument doc;
+    ASSERT_TRUE(doc.open(path));
+
+    // 封装、图片读取器与文档共享同一个压缩包
+    ASSERT_NE(doc.getArchive(), nullptr);
+    EXPECT_TRUE(doc.getArchive()->hasEntry("xl/workbook.xml"));
+
+    auto& sheet = doc.getWorkbook().getSheet(0);
+    sheet.setCellValue("A1", "round-trip");
+    auto out = std::filesystem::temp_directory_path() / "minixlsx_shared_archive.xlsx";
+    ASSERT_TRUE(doc.saveAs(out.string()));
+    doc.close();
+
+    OpenXLSXWrapper wrapper;
+    ASSERT_TRUE(wrapper.open(out.string()));
+    auto v = wrapper.getCellValue(0, "A1");
+    ASSERT_TRUE(v.has_value());
+    EXPECT_EQ(v.value(), "round-trip");
+    EXPECT_EQ(wrapper.getCellValue(0, "B2").value_or(""), "hello");
+    EXPECT_EQ(wrapper.getCellValue(1, "A1").value_or(""), "s2");
+    wrapper.close();
+    std::filesystem::remove(out);
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_Archive, ExtractRejectsEntriesOutsideTargetDir) {
+    namespace fs = std::filesystem;
+    const auto path = makeFixture("minixlsx_zip_slip_fixture.xlsx");
+    const auto crafted = fs::temp_directory_path() / "minixlsx_zip_slip.xlsx";
+    const auto dir = fs::temp_directory_path() / "minixlsx_zip_slip" / "out";
+    fs::remove_all(dir.parent_path());
+    {
+        XLArchive archive;
+        ASSERT_TRUE(archive.open(path));
+        archive.setEntry("../escaped.txt", "x");
+        archive.setEntry("xl/../../escaped2.txt", "x");
+        archive.setEntry("xl/media/../safe.txt", "x");
+        ASSERT_TRUE(archive.save(crafted.string()));
+        archive.close();
+    }
+
+    // 含 ".." 的条目名称一律拒绝，不会写到目标目录之外
+    XLArchive archive;
+    ASSERT_TRUE(archive.open(crafted.string()));
+    ASSERT_TRUE(archive.hasEntry("../escaped.txt"));
+    EXPECT_FALSE(archive.extractEntry("../escaped.txt", dir.string()));
+    EXPECT_FALSE(archive.extractEntry("xl/../../escaped2.txt", dir.string()));
+    EXPECT_FALSE(archive.extractEntry("xl/media/../safe.txt", dir.string()));
+    EXPECT_FALSE(archive.extractTo(dir.string()));
+    EXPECT_FALSE(fs::exists(dir.parent_path() / "escaped.txt"));
+    EXPECT_FALSE(fs::exists(dir.parent_path() / "escaped2.txt"));
+    EXPECT_TRUE(archive.extractEntry("xl/workbook.xml", dir.string()));
+    EXPECT_TRUE(fs::exists(dir / "xl" / "workbook.xml"));
+    archive.close();
+
+    // 文档按需解压走同一校验
+    XLDocument doc;
+    ASSERT_TRUE(doc.open(crafted.string()));
+    EXPECT_TRUE(doc.extractEntry("../escaped.txt").empty());
+    EXPECT_TRUE(doc.extractEntry("xl/../../escaped2.txt").empty());
+    EXPECT_FALSE(doc.extractEntry("xl/workbook.xml").empty());
+    EXPECT_FALSE(fs::exists(doc.getTempDir().parent_path() / "escaped.txt"));
+    doc.close();
+
+    EXPECT_TRUE(XLArchive::entryPath("/etc/passwd", dir).empty());
+    EXPECT_TRUE(XLArchive::entryPath("", dir).empty());
+    EXPECT_TRUE(XLArchive::entryPath(".", dir).empty());
+    EXPECT_EQ(XLArchive::entryPath("xl/./workbook.xml", dir), (dir / "xl" / "workbook.xml").lexically_normal());
+    fs::remove_all(dir.parent_path());
+    fs::remove(crafted);
+    fs::remove(path);
+}
+
+TEST(MiniXLSX_Open, OpensFromMemoryBuffer) {
+    const auto path = makeFixture("minixlsx_from_memory_fixture.xlsx");
+    std::ifstream in(path, std::ios::binary);
+    ASSERT_TRUE(in.is_open());
+    std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    XLDocument doc;
+    ASSERT_TRUE(doc.open(std::as_bytes(std::span<const char>(bytes))));
+    EXPECT_TRUE(doc.getTempDir().empty());
+    bytes.clear(); // 缓冲区在打开时已复制
+
+    auto& sheet = doc.getWorkbook().getSheet(0);
+    const XLCell* a1 = sheet.getCell("A1");
+    ASSERT_NE(a1, nullptr);
+    EXPECT_EQ(a1->getValue(), "hello");
+    EXPECT_EQ(doc.getWorkbook().getSheetName(1), "Second");
+
+    // 无文件路径时 save() 失败，saveAs() 可用
+    sheet.setCellValue("A1", "from-memory");
+    EXPECT_FALSE(doc.save());
+    auto out = std::filesystem::temp_directory_path() / "minixlsx_from_memory.xlsx";
+    ASSERT_TRUE(doc.saveAs(out.string()));
+    doc.close();
+
+    OpenXLSXWrapper wrapper;
+    ASSERT_TRUE(wrapper.open(out.string()));
+    EXPECT_EQ(wrapper.getCellValue(0, "A1").value_or(""), "from-memory");
+    wrapper.close();
+    std::filesystem::remove(out);
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_Archive, StoredEntryZeroCopyView) {
+    const auto path = makeFixture("minixlsx_stored_entries.xlsx");
+    {
+        // 工作表以存储方式（不压缩）保存，其余部件仍压缩
+        XLArchive source;
+        ASSERT_TRUE(source.open(path));
+        SaveOptions options;
+        options.contentTypeLevels["application/vnd.openxmlformats-officedocument.spreadsheetml.worksheet+xml"] =
+            CompressionLevel::Store;
+        ASSERT_TRUE(source.save(path, options));
+        source.close();
+    }
+    XLArchive archive;
+    ASSERT_TRUE(archive.open(path));
+
+    // 压缩保存的 XML 无法零拷贝，需走 getEntry()
+    EXPECT_FALSE(archive.getEntryView("xl/workbook.xml").has_value());
+    EXPECT_FALSE(archive.getEntryView("xl/no-such-entry.xml").has_value());
+    ASSERT_TRUE(archive.getEntryView("xl/worksheets/sheet1.xml").has_value());
+
+    size_t views = 0;
+    for (const auto& name : archive.entryNames()) {
+        auto view = archive.getEntryView(name);
+        if (!view) continue;
+        // 零拷贝视图必须与解压结果一致
+        auto data = archive.getEntry(name);
+        ASSERT_TRUE(data.has_value());
+        EXPECT_EQ(std::string(*view), *data) << name;
+        ++views;
+    }
+    EXPECT_EQ(views, 2u);
+    archive.close();
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_Open, LazyTempDirExtraction) {
+    const auto path = makeFixture("minixlsx_lazy_temp_dir.xlsx");
+    XLDocument doc;
+    ASSERT_TRUE(doc.open(path));
+
+    // 读取单元格不需要临时目录
+    auto& sheet = doc.getWorkbook().getSheet(0);
+    EXPECT_NE(sheet.getCell("A1"), nullptr);
+
+    // 只解压请求的条目
+    auto workbookXml = doc.extractEntry("xl/workbook.xml");
+    ASSERT_FALSE(workbookXml.empty());
+    EXPECT_TRUE(std::filesystem::exists(workbookXml));
+    EXPECT_FALSE(std::filesystem::exists(workbookXml.parent_path() / "styles.xml"));
+    EXPECT_TRUE(doc.extractEntry("xl/no-such-entry.xml").empty());
+
+    // getTempDir() 导出全部条目
+    auto temp = doc.getTempDir();
+    ASSERT_FALSE(temp.empty());
+    EXPECT_TRUE(std::filesystem::exists(temp / "xl" / "styles.xml"));
+
+    doc.close();
+    EXPECT_FALSE(std::filesystem::exists(temp));
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_StreamWriter, WritesRowsReadableByWrapper) {
+    auto out = std::filesystem::temp_directory_path() / "minixlsx_stream_writer.xlsx";
+    {
+        XLStreamWriter writer;
+        ASSERT_TRUE(writer.open(out.string()));
+        ASSERT_TRUE(writer.addSheet("Data"));
+        ASSERT_TRUE(writer.appendRow({CellValue(std::string("name")), CellValue(std::string("value")), CellValue(std::string("flag"))}));
+        for (int64_t i = 0; i < 2000; ++i) {
+            // 重复字符串走共享字符串去重
+            ASSERT_TRUE(writer.appendRow({CellValue(std::string("item <") + std::to_string(i % 10) + ">"), CellValue(i), CellValue(i % 2 == 0)}));
+        }
+        ASSERT_TRUE(writer.writeRow(5000, {CellValue(), CellValue(2.5)}));
+        EXPECT_FALSE(writer.writeRow(10, {CellValue(int64_t(1))})); // 只能向后写
+        ASSERT_TRUE(writer.addSheet("Second"));
+        ASSERT_TRUE(writer.appendRow({CellValue(std::string("s2"))}));
+        EXPECT_FALSE(writer.addSheet("Data"));
+        EXPECT_FALSE(writer.addSheet("DATA")); // 名称比较不区分大小写
+        ASSERT_TRUE(writer.close());
+        EXPECT_FALSE(writer.isOpen());
+    }
+
+    OpenXLSXWrapper wrapper;
+    ASSERT_TRUE(wrapper.open(out.string()));
+    ASSERT_EQ(wrapper.sheetCount(), 2u);
+    EXPECT_EQ(wrapper.sheetName(0), "Data");
+    EXPECT_EQ(wrapper.sheetName(1), "Second");
+    EXPECT_EQ(wrapper.getCellValue(0, "A1").value_or(""), "name");
+    EXPECT_EQ(wrapper.getCellValue(0, "A4").value_or(""), "item <2>");
+    EXPECT_EQ(wrapper.getCellValue(0, "B2001").value_or(""), "1999");
+    EXPECT_DOUBLE_EQ(std::stod(wrapper.getCellValue(0, "B5000").value_or("0")), 2.5);
+    EXPECT_EQ(wrapper.getCellValue(1, "A1").value_or(""), "s2");
+    wrapper.close();
+    std::filesystem::remove(out);
+}
+
+TEST(MiniXLSX_RowReader, StreamsRowsWithSharedStrings) {
+    const auto path = makeFixture("minixlsx_row_reader_fixture.xlsx");
+    XLRowReader reader;
+    ASSERT_TRUE(reader.open(path, std::string("Data")));
+
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(reader.rowNumber(), 1u);
+    auto cells = reader.cells();
+    ASSERT_GE(cells.size(), 4u);
+    EXPECT_EQ(cells[0].column, 1u);
+    EXPECT_EQ(cells[0].kind, CellKind::String);
+    EXPECT_EQ(cells[0].value, "hello");
+    EXPECT_EQ(cells[1].kind, CellKind::Number);
+    EXPECT_EQ(cells[1].value, "42");
+    EXPECT_EQ(cells[3].kind, CellKind::Boolean);
+
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(reader.rowNumber(), 2u);
+    ASSERT_GE(reader.cells().size(), 2u);
+    EXPECT_EQ(reader.cells()[0].value, "world");
+    EXPECT_EQ(reader.cells()[1].value, "hello"); // 共享字符串复用
+
+    while (reader.next()) {}
+    EXPECT_FALSE(reader.hasError());
+    reader.close();
+    EXPECT_FALSE(reader.isOpen());
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_RowReader, ReadsStreamWriterOutput) {
+    auto out = std::filesystem::temp_directory_path() / "minixlsx_row_reader.xlsx";
+    {
+        XLStreamWriter writer;
+        ASSERT_TRUE(writer.open(out.string()));
+        ASSERT_TRUE(writer.addSheet("Big"));
+        for (int64_t i = 1; i <= 50000; ++i) {
+            ASSERT_TRUE(writer.appendRow({CellValue(std::string("a&b <") + std::to_string(i % 7) + ">"), CellValue(), CellValue(i)}));
+        }
+        ASSERT_TRUE(writer.close());
+    }
+
+    XLRowReader reader;
+    ASSERT_TRUE(reader.open(out.string(), 0u));
+    uint32_t rows = 0;
+    while (reader.next()) {
+        ++rows;
+        auto cells = reader.cells();
+        ASSERT_EQ(cells.size(), 2u);
+        EXPECT_EQ(cells[0].value, "a&b <" + std::to_string(rows % 7) + ">");
+        EXPECT_EQ(cells[1].column, 3u);
+        EXPECT_EQ(cells[1].value, std::to_string(rows));
+    }
+    EXPECT_FALSE(reader.hasError());
+    EXPECT_EQ(rows, 50000u);
+    reader.close();
+    std::filesystem::remove(out);
+}
+
+TEST(MiniXLSX_RowReader, RejectsMalformedCellValues) {
+    const auto path = makeFixture("minixlsx_row_reader_malformed.xlsx");
+    auto archive = std::make_shared<XLArchive>();
+    ASSERT_TRUE(archive->open(path));
+    const std::string head = "<worksheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\"><sheetData>";
+    const std::string tail = "</sheetData></worksheet>";
+
+    // 空的 <v/> 不解析为第 0 个共享字符串，而是跳过该单元格
+    archive->setEntry("xl/sharedStrings.xml",
+        "<sst xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\"><si><t>first</t></si></sst>");
+    archive->setEntry("xl/worksheets/sheet1.xml", head +
+        "<row r=\"1\"><c r=\"A1\" t=\"s\"><v/></c><c r=\"B1\" t=\"s\"><v>0</v></c></row>" + tail);
+    XLRowReader reader;
+    ASSERT_TRUE(reader.open(archive, 0u));
+    ASSERT_TRUE(reader.next());
+    ASSERT_EQ(reader.cells().size(), 1u);
+    EXPECT_EQ(reader.cells()[0].column, 2u);
+    EXPECT_EQ(reader.cells()[0].value, "first");
+    EXPECT_FALSE(reader.next());
+    EXPECT_FALSE(reader.hasError());
+
+    // 超出 Unicode 范围或落在代理区的字符引用视为数据损坏
+    for (const std::string ref : {"&#x110000;", "&#xD800;", "&#55296;", "&#x100000041;"}) {
+        archive->setEntry("xl/worksheets/sheet1.xml", head +
+            "<row r=\"1\"><c r=\"A1\" t=\"inlineStr\"><is><t>a" + ref + "</t></is></c></row>" + tail);
+        ASSERT_TRUE(reader.open(archive, 0u));
+        EXPECT_FALSE(reader.next()) << ref;
+        EXPECT_TRUE(reader.hasError()) << ref;
+    }
+    reader.close();
+    archive->close();
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_Archive, LargeEntrySavedInParallelBlocks) {
+    const auto path = makeFixture("minixlsx_parallel_fixture.xlsx");
+    XLArchive archive;
+    ASSERT_TRUE(archive.open(path));
+
+    // 超过单个压缩块大小的条目会被拆分为多个块并行压缩
+    std::string big;
+    for (int i = 0; big.size() < 3 * 1024 * 1024 + 123; ++i) {
+        big += "<row r=\"" + std::to_string(i) + "\"><c><v>" + std::to_string(i * 7919 % 100003) + "</v></c></row>";
+    }
+    archive.setEntry("xl/big.xml", big);
+    archive.setEntry("xl/small.xml", "<small/>");
+
+    auto out = std::filesystem::temp_directory_path() / "minixlsx_parallel_deflate.xlsx";
+    ASSERT_TRUE(archive.save(out.string()));
+    archive.close();
+    EXPECT_LT(std::filesystem::file_size(out), big.size() / 2);
+
+    XLArchive reopened;
+    ASSERT_TRUE(reopened.open(out.string()));
+    EXPECT_EQ(reopened.getEntry("xl/big.xml").value_or(""), big);
+    EXPECT_EQ(reopened.getEntry("xl/small.xml").value_or(""), "<small/>");
+    EXPECT_TRUE(reopened.getEntry("xl/workbook.xml").has_value());
+    reopened.close();
+    std::filesystem::remove(out);
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_Archive, SaveCopiesUntouchedEntries) {
+    const auto path = makeFixture("minixlsx_incremental_fixture.xlsx");
+    XLArchive source;
+    ASSERT_TRUE(source.open(path));
+
+    XLDocument doc;
+    ASSERT_TRUE(doc.open(path));
+    doc.getWorkbook().getSheet(0).setCellValue("A1", "incremental");
+    auto out = std::filesystem::temp_directory_path() / "minixlsx_incremental_save.xlsx";
+    ASSERT_TRUE(doc.saveAs(out.string()));
+    doc.close();
+
+    // 未访问的部件（其他工作表、图片等）原样复制，不经过解析与重新序列化
+    XLArchive saved;
+    ASSERT_TRUE(saved.open(out.string()));
+    for (const auto& name : source.entryNames()) {
+        if (name == "xl/worksheets/sheet1.xml" || name == "xl/sharedStrings.xml" || name.rfind("docProps/", 0) == 0 ||
+            name == "xl/workbook.xml" || name == "[Content_Types].xml" || name.find("_rels/") != std::string::npos ||
+            name == "xl/calcChain.xml" || name == "xl/styles.xml") continue;
+        ASSERT_TRUE(saved.hasEntry(name)) << name;
+        EXPECT_EQ(saved.getEntry(name), source.getEntry(name)) << name;
+    }
+    saved.close();
+    source.close();
+
+    OpenXLSXWrapper wrapper;
+    ASSERT_TRUE(wrapper.open(out.string()));
+    EXPECT_EQ(wrapper.getCellValue(0, "A1").value_or(""), "incremental");
+    EXPECT_EQ(wrapper.getCellValue(1, "A1").value_or(""), "s2");
+    wrapper.close();
+    std::filesystem::remove(out);
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_Archive, SaveCopiesParsedButUnchangedParts) {
+    auto path = std::filesystem::temp_directory_path() / "minixlsx_unchanged_parts.xlsx";
+    {
+        XLStreamWriter writer;
+        ASSERT_TRUE(writer.open(path.string()));
+        ASSERT_TRUE(writer.addSheet("Data"));
+        ASSERT_TRUE(writer.appendRow({CellValue(std::string("name")), CellValue(int64_t(1))}));
+        ASSERT_TRUE(writer.addSheet("Second"));
+        ASSERT_TRUE(writer.appendRow({CellValue(std::string("s2")), CellValue(2.5)}));
+        ASSERT_TRUE(writer.close());
+    }
+    XLArchive source;
+    ASSERT_TRUE(source.open(path.string()));
+    const auto sheet2 = source.getEntry("xl/worksheets/sheet2.xml");
+    ASSERT_TRUE(sheet2);
+    source.close();
+
+    // 只读的工作表虽被解析，保存时仍原样复制，不重新序列化
+    {
+        OpenXLSX::XLDocument doc;
+        doc.open(path.string());
+        EXPECT_EQ(doc.workbook().worksheet("Second").cell("A1").value().get<std::string>(), "s2");
+        doc.workbook().worksheet("Data").cell("C1").value() = 7;
+        doc.save();
+        doc.close();
+    }
+    XLArchive saved;
+    ASSERT_TRUE(saved.open(path.string()));
+    EXPECT_EQ(saved.getEntry("xl/worksheets/sheet2.xml"), sheet2);
+    EXPECT_NE(saved.getEntry("xl/worksheets/sheet1.xml")->find("<v>7</v>"), std::string::npos);
+    saved.close();
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_Archive, SaveOptionsControlCompression) {
+    auto tmp = std::filesystem::temp_directory_path();
+    const auto path = makeFixture("minixlsx_save_options_fixture.xlsx");
+    auto saveWith = [&](const SaveOptions& options, const std::string& name) -> std::uintmax_t {
+        XLDocument doc;
+        if (!doc.open(path)) return 0;
+        auto& sheet = doc.getWorkbook().getSheet(0);
+        for (int row = 10; row < 400; ++row) {
+            sheet.setCellValue("A" + std::to_string(row), "repeated text " + std::to_string(row % 7));
+        }
+        auto out = tmp / name;
+        if (!doc.saveAs(out.string(), options)) return 0;
+        doc.close();
+        return std::filesystem::file_size(out);
+    };
+
+    SaveOptions stored;
+    stored.level = CompressionLevel::Store;
+    SaveOptions best;
+    best.level = CompressionLevel::Max;
+    // 工作表按内容类型单独指定为不压缩，其余部件使用最高压缩
+    SaveOptions sheetsStored = best;
+    sheetsStored.contentTypeLevels["application/vnd.openxmlformats-officedocument.spreadsheetml.worksheet+xml"] =
+        CompressionLevel::Store;
+
+    auto storedSize = saveWith(stored, "minixlsx_store.xlsx");
+    auto bestSize = saveWith(best, "minixlsx_max.xlsx");
+    auto mixedSize = saveWith(sheetsStored, "minixlsx_mixed.xlsx");
+    ASSERT_NE(storedSize, 0u);
+    ASSERT_NE(bestSize, 0u);
+    ASSERT_NE(mixedSize, 0u);
+    EXPECT_GT(storedSize, bestSize);
+    EXPECT_GT(mixedSize, bestSize);
+    EXPECT_LT(mixedSize, storedSize);
+
+    for (const auto* name : {"minixlsx_store.xlsx", "minixlsx_max.xlsx", "minixlsx_mixed.xlsx"}) {
+        OpenXLSXWrapper wrapper;
+        ASSERT_TRUE(wrapper.open((tmp / name).string()));
+        EXPECT_EQ(wrapper.getCellValue(0, "A12").value_or(""), "repeated text 5");
+        EXPECT_EQ(wrapper.getCellValue(1, "A1").value_or(""), "s2");
+        wrapper.close();
+        std::filesystem::remove(tmp / name);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_Archive, SaveOptionsRecompressUntouchedEntries) {
+    namespace fs = std::filesystem;
+    const auto path = makeFixture("minixlsx_recompress_fixture.xlsx");
+    const auto stored = fs::temp_directory_path() / "minixlsx_recompress_stored.xlsx";
+    const auto copied = fs::temp_directory_path() / "minixlsx_recompress_copied.xlsx";
+    const auto best = fs::temp_directory_path() / "minixlsx_recompress_max.xlsx";
+    const std::string sheetType = "application/vnd.openxmlformats-officedocument.spreadsheetml.worksheet+xml";
+
+    // 未修改的条目也按规则重新压缩：只有工作表改为不压缩
+    XLArchive archive;
+    ASSERT_TRUE(archive.open(path));
+    SaveOptions sheetsStored;
+    sheetsStored.contentTypeLevels[sheetType] = CompressionLevel::Store;
+    ASSERT_TRUE(archive.save(stored.string(), sheetsStored));
+    EXPECT_TRUE(archive.getEntryView("xl/worksheets/sheet2.xml").has_value());
+    EXPECT_FALSE(archive.getEntryView("xl/workbook.xml").has_value());
+
+    // 没有规则时原样复制，仍保持不压缩
+    ASSERT_TRUE(archive.save(copied.string()));
+    EXPECT_TRUE(archive.getEntryView("xl/worksheets/sheet1.xml").has_value());
+
+    // 全局级别作用于所有条目
+    SaveOptions max;
+    max.level = CompressionLevel::Max;
+    ASSERT_TRUE(archive.save(best.string(), max));
+    EXPECT_FALSE(archive.getEntryView("xl/worksheets/sheet1.xml").has_value());
+    archive.close();
+    EXPECT_LT(fs::file_size(best), fs::file_size(copied));
+
+    OpenXLSXWrapper wrapper;
+    ASSERT_TRUE(wrapper.open(best.string()));
+    EXPECT_EQ(wrapper.getCellValue(0, "A1").value_or(""), "hello");
+    EXPECT_EQ(wrapper.getCellValue(1, "A1").value_or(""), "s2");
+    wrapper.close();
+    for (const auto& file : {fs::path(path), stored, copied, best}) fs::remove(file);
+}
+
+TEST(MiniXLSX_Document, SaveToMemoryStreamAndCallback) {
+    const auto path = makeFixture("minixlsx_save_to_memory_fixture.xlsx");
+    XLDocument doc;
+    ASSERT_TRUE(doc.open(path));
+    doc.getWorkbook().getSheet(0).setCellValue("A1", "in memory");
+
+    std::vector<std::byte> buffer;
+    ASSERT_TRUE(doc.saveAs(buffer));
+    ASSERT_FALSE(buffer.empty());
+
+    std::ostringstream stream;
+    ASSERT_TRUE(doc.saveAs(stream));
+    EXPECT_EQ(stream.str().size(), buffer.size());
+
+    // 回调返回 false 时中止保存
+    size_t written = 0;
+    EXPECT_FALSE(doc.saveAs([&](const char*, size_t size) {
+        written += size;
+        return written < 64;
+    }));
+    doc.close();
+
+    cc::neolux::utils::MiniXLSX::MiniXLSX book;
+    ASSERT_TRUE(book.open(std::span<const std::byte>(buffer)));
+    EXPECT_EQ(book.getCellValue(0, "A1").value_or(""), "in memory");
+    EXPECT_EQ(book.getCellValue(0, "B1").value_or(""), "42");
+    EXPECT_EQ(book.getCellValue(0, "A2").value_or(""), "world");
+    EXPECT_EQ(book.getCellValue(1, "A1").value_or(""), "s2");
+
+    std::vector<std::byte> again;
+    ASSERT_TRUE(book.save(again));
+    book.close();
+
+    OpenXLSXWrapper reopened;
+    ASSERT_TRUE(reopened.open(std::span<const std::byte>(again)));
+    ASSERT_EQ(reopened.sheetCount(), 2u);
+    EXPECT_EQ(reopened.sheetName(0), "Data");
+    EXPECT_EQ(reopened.sheetName(1), "Second");
+    EXPECT_EQ(reopened.getCellValue(0, "A1").value_or(""), "in memory");
+    reopened.close();
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_CellStore, PackedKeysIterateRowMajor) {
+    EXPECT_EQ(sizeof(XLCellStore::Slot), 24u);
+
+    uint32_t row = 0, column = 0;
+    ASSERT_TRUE(XLCellStore::parseReference("$AB$12", row, column));
+    EXPECT_EQ(row, 12u);
+    EXPECT_EQ(column, 28u);
+    EXPECT_EQ(XLCellStore::makeReference(row, column), "AB12");
+    EXPECT_FALSE(XLCellStore::parseReference("12", row, column));
+    EXPECT_FALSE(XLCellStore::parseReference("A0", row, column));
+
+    // 乱序写入，遍历时仍按行优先顺序输出
+    XLCellStore store;
+    std::vector<std::pair<uint32_t, uint32_t>> coords;
+    for (uint32_t r = 1; r <= 40; ++r)
+        for (uint32_t c = 1; c <= 30; ++c) coords.emplace_back(r, c);
+    std::reverse(coords.begin(), coords.end());
+    for (size_t i = 0; i < coords.size(); i += 2) std::swap(coords[i], coords[coords.size() - 1 - i]);
+    for (auto [r, c] : coords) {
+        store.set(r, c, std::to_string(r * 100 + c), (c % 2) ? "n" : "str");
+    }
+    ASSERT_EQ(store.size(), coords.size());
+
+    uint64_t previous = 0;
+    size_t count = 0;
+    for (const auto& cell : store) {
+        EXPECT_GT(cell.key, previous);
+        previous = cell.key;
+        EXPECT_EQ(store.rawValue(cell), std::to_string(cell.row() * 100 + cell.column()));
+        ++count;
+    }
+    EXPECT_EQ(count, coords.size());
+
+    // 覆盖写入与类型标签
+    store.set(3, 4, "overwritten", "str");
+    store.set(3, 5, "1", "b");
+    store.set(3, 6, "2", "s");
+    EXPECT_EQ(store.text(*store.find(3, 4)), "overwritten");
+    EXPECT_EQ(store.find(3, 5)->kind, XLCellStore::Kind::Boolean);
+    EXPECT_EQ(store.value(*store.find(3, 6), {"a", "b", "c"}), "c");
+    EXPECT_EQ(store.rawValue(*store.find(7, 7)), "707");
+    EXPECT_EQ(store.find(41, 1), nullptr);
+}
+
+TEST(MiniXLSX_Wrapper, NumericCoordinateAccessors) {
+    const auto path = makeFixture("minixlsx_numeric_coords.xlsx");
+    OpenXLSXWrapper wrapper;
+    ASSERT_TRUE(wrapper.open(path));
+
+    // 行列号与地址字符串访问同一单元格
+    EXPECT_EQ(wrapper.getCellValue(0, 1, 2), wrapper.getCellValue(0, "B1"));
+    EXPECT_EQ(wrapper.getCellValue(0, 2, 1).value_or(""), "world");
+
+    for (uint32_t row = 20; row < 30; ++row) {
+        for (uint16_t col = 1; col <= 28; ++col) {
+            ASSERT_TRUE(wrapper.setCellValue(0, row, col, std::to_string(row * 100 + col)));
+        }
+    }
+    EXPECT_EQ(wrapper.getCellValue(0, "AB25").value_or(""), "2528");
+    EXPECT_TRUE(wrapper.setCellStyle(0, 20, 1, CellStyle{"#FF0000", "", CellBorderStyle::Thin, ""}));
+    EXPECT_FALSE(wrapper.getCellValue(0, 1, 0).has_value());
+    wrapper.close();
+
+    XLDocument doc;
+    ASSERT_TRUE(doc.open(path));
+    auto& sheet = doc.getWorkbook().getSheet(0);
+    sheet.setCellValue(3, 3, "numeric");
+    EXPECT_EQ(sheet.getCellValue("C3"), "numeric");
+    ASSERT_NE(sheet.getCell(3, 3), nullptr);
+    EXPECT_EQ(sheet.getCell(3, 3)->getValue(), "numeric");
+    EXPECT_EQ(sheet.getCell(3, 3), sheet.getCell("C3"));
+    doc.close();
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_Wrapper, CachedWorksheetHandles) {
+    const auto path = makeFixture("minixlsx_cached_handles.xlsx");
+    OpenXLSXWrapper wrapper;
+    ASSERT_TRUE(wrapper.open(path));
+
+    // 交替访问两个工作表，缓存的句柄不能串表
+    for (uint32_t row = 10; row < 20; ++row) {
+        ASSERT_TRUE(wrapper.setCellValue(0, row, 1, "data" + std::to_string(row)));
+        ASSERT_TRUE(wrapper.setCellValue(1, row, 1, "second" + std::to_string(row)));
+    }
+    EXPECT_EQ(wrapper.getCellValue(0, "A15").value_or(""), "data15");
+    EXPECT_EQ(wrapper.getCellValue(1, "A15").value_or(""), "second15");
+    EXPECT_EQ(wrapper.getCellValue(1, "A1").value_or(""), "s2");
+    EXPECT_FALSE(wrapper.getCellValue(5, "A1").has_value());
+    EXPECT_FALSE(wrapper.setCellValue(5, "A1", "x"));
+
+    // 重新打开后缓存清空，读到的是文件中的内容
+    ASSERT_TRUE(wrapper.open(path));
+    EXPECT_EQ(wrapper.getCellValue(0, "A15").value_or(""), "");
+    EXPECT_EQ(wrapper.getCellValue(0, "A1").value_or(""), "hello");
+    wrapper.close();
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_Wrapper, GetRangeReadsTypedBlock) {
+    const auto path = makeFixture("minixlsx_get_range.xlsx");
+    OpenXLSXWrapper wrapper;
+    ASSERT_TRUE(wrapper.open(path));
+
+    auto range = wrapper.getRange(0, "A1:D3");
+    ASSERT_TRUE(range.has_value());
+    EXPECT_EQ(range->rows, 3u);
+    EXPECT_EQ(range->columns, 4u);
+    ASSERT_EQ(range->cells.size(), 12u);
+    EXPECT_EQ(range->at(1, 1).kind, CellKind::String);
+    EXPECT_EQ(range->textOf(range->at(1, 1)), "hello");
+    EXPECT_EQ(range->at(1, 2).kind, CellKind::Number);
+    EXPECT_DOUBLE_EQ(range->at(1, 2).number, 42);
+    EXPECT_DOUBLE_EQ(range->at(1, 3).number, 3.5);
+    EXPECT_EQ(range->textOf(range->at(2, 1)), "world");
+    EXPECT_EQ(range->textOf(range->at(2, 2)), "hello");
+    EXPECT_EQ(range->at(3, 1).kind, CellKind::Empty);
+
+    // 写入一块数据后按列优先读取其中的子区域
+    for (uint32_t row = 100; row < 200; ++row) {
+        for (uint16_t col = 1; col <= 10; ++col) {
+            ASSERT_TRUE(wrapper.setCellValue(0, row, col, "v" + std::to_string(row * 100 + col)));
+        }
+    }
+    auto block = wrapper.getRange(0, "J150:C120", RangeOrder::ColumnMajor);
+    ASSERT_TRUE(block.has_value());
+    EXPECT_EQ(block->firstRow, 120u);
+    EXPECT_EQ(block->firstColumn, 3u);
+    ASSERT_EQ(block->cells.size(), 31u * 8u);
+    EXPECT_EQ(block->textOf(block->cells[1]), "v12103");
+    EXPECT_EQ(block->textOf(block->cells[31]), "v12004");
+    EXPECT_EQ(block->textOf(block->at(150, 10)), "v15010");
+
+    EXPECT_FALSE(wrapper.getRange(0, "A1:?").has_value());
+    EXPECT_FALSE(wrapper.getRange(9, "A1:B2").has_value());
+    wrapper.close();
+
+    XLDocument doc;
+    ASSERT_TRUE(doc.open(path));
+    auto fromSheet = doc.getWorkbook().getSheet(0).getRange("B1");
+    ASSERT_TRUE(fromSheet.has_value());
+    ASSERT_EQ(fromSheet->cells.size(), 1u);
+    EXPECT_DOUBLE_EQ(fromSheet->cells[0].number, 42);
+    doc.close();
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_Wrapper, SetRangeWritesGridInOnePass) {
+    const auto path = makeFixture("minixlsx_set_range.xlsx");
+    OpenXLSXWrapper wrapper;
+    ASSERT_TRUE(wrapper.open(path));
+
+    // 覆盖已有单元格（B1、A2）并在其间插入新行新列
+    const uint32_t rows = 50;
+    const uint16_t cols = 6;
+    std::vector<CellValue> values;
+    for (uint32_t r = 0; r < rows; ++r) {
+        values.emplace_back(std::string(r % 2 ? "odd" : "even"));
+        values.emplace_back(static_cast<int64_t>(r));
+        values.emplace_back(r + 0.5);
+        values.emplace_back(r % 3 == 0);
+        values.emplace_back(std::monostate{});
+        values.emplace_back(std::string("row") + std::to_string(r));
+    }
+    ASSERT_TRUE(wrapper.setRange(0, "B1", rows, cols, values));
+    EXPECT_FALSE(wrapper.setRange(0, "B1", rows, cols, std::span<const CellValue>(values).first(5)));
+
+    EXPECT_EQ(wrapper.getCellValue(0, "A1").value_or(""), "hello");
+    EXPECT_EQ(wrapper.getCellValue(0, "B1").value_or(""), "even");
+    EXPECT_EQ(wrapper.getCellValue(0, "C2").value_or(""), "1");
+    EXPECT_EQ(wrapper.getCellValue(0, "G50").value_or(""), "row49");
+
+    auto range = wrapper.getRange(0, "B1:G50");
+    ASSERT_TRUE(range.has_value());
+    EXPECT_EQ(range->textOf(range->at(10, 2)), "odd");
+    EXPECT_EQ(range->at(10, 3).kind, CellKind::Number);
+    EXPECT_DOUBLE_EQ(range->at(10, 3).number, 9);
+    EXPECT_DOUBLE_EQ(range->at(10, 4).number, 9.5);
+    EXPECT_EQ(range->at(10, 5).kind, CellKind::Boolean);
+    EXPECT_DOUBLE_EQ(range->at(10, 5).number, 1);
+    EXPECT_EQ(range->at(10, 6).kind, CellKind::Empty);
+
+    // 保存后重新打开，确认行列顺序与维度正确
+    std::vector<std::byte> buffer;
+    ASSERT_TRUE(wrapper.saveAs(buffer));
+    OpenXLSXWrapper reopened;
+    ASSERT_TRUE(reopened.open(std::span<const std::byte>(buffer)));
+    EXPECT_EQ(reopened.getCellValue(0, "A2").value_or(""), "world");
+    EXPECT_EQ(reopened.getCellValue(0, "G50").value_or(""), "row49");
+    reopened.close();
+    wrapper.close();
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_Wrapper, TypedReadsReturnVariant) {
+    const auto path = makeFixture("minixlsx_typed_reads.xlsx");
+    OpenXLSXWrapper wrapper;
+    ASSERT_TRUE(wrapper.open(path));
+
+    auto a1 = wrapper.getValue(0, "A1");
+    ASSERT_TRUE(a1.has_value());
+    ASSERT_TRUE(std::holds_alternative<std::string_view>(*a1));
+    EXPECT_EQ(std::get<std::string_view>(*a1), "hello");
+    EXPECT_EQ(wrapper.get<int64_t>(0, "B1"), 42);
+    EXPECT_TRUE(std::holds_alternative<int64_t>(*wrapper.getValue(0, 1, 2)));
+    EXPECT_EQ(wrapper.get<double>(0, "C1"), 3.5);
+    EXPECT_FALSE(wrapper.get<int64_t>(0, "C1").has_value());
+    EXPECT_EQ(wrapper.get<std::string>(0, "B2"), "hello");
+    EXPECT_FALSE(wrapper.get<double>(0, "A1").has_value());
+
+    // 读取不存在的单元格不会创建它
+    auto missing = wrapper.getValue(0, "Z99");
+    ASSERT_TRUE(missing.has_value());
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(*missing));
+    EXPECT_FALSE(wrapper.getValue(0, "1A").has_value());
+
+    std::vector<CellValue> values{int64_t{-7}, 2.25, true, std::string("text")};
+    ASSERT_TRUE(wrapper.setRange(0, "A20", 1, 4, values));
+    EXPECT_EQ(wrapper.get<int>(0, "A20"), -7);
+    EXPECT_FALSE(wrapper.get<unsigned>(0, "A20").has_value());
+    EXPECT_EQ(wrapper.get<double>(0, "B20"), 2.25);
+    EXPECT_EQ(wrapper.get<bool>(0, "C20"), true);
+    EXPECT_EQ(wrapper.get<std::string_view>(0, 20, 4), "text");
+    wrapper.close();
+
+    XLDocument doc;
+    ASSERT_TRUE(doc.open(path));
+    auto& sheet = doc.getWorkbook().getSheet(0);
+    EXPECT_EQ(sheet.get<int64_t>("B1"), 42);
+    ASSERT_NE(sheet.getCell("B1"), nullptr);
+    EXPECT_EQ(sheet.getCell("B1")->getType(), "n");
+    EXPECT_EQ(sheet.getCell("C1")->getValue(), "3.5");
+    doc.close();
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_Wrapper, CellCursorScansPresentCells) {
+    const auto path = makeFixture("minixlsx_cell_cursor.xlsx");
+    OpenXLSXWrapper wrapper;
+    ASSERT_TRUE(wrapper.open(path));
+
+    ASSERT_TRUE(wrapper.setCellValue(0, 500, 3, "far"));
+    ASSERT_TRUE(wrapper.setCellValue(0, 40, 2, "mid"));
+
+    std::vector<std::pair<uint32_t, uint16_t>> seen;
+    auto cursor = wrapper.cellCursor(0);
+    while (cursor.next()) seen.emplace_back(cursor.cell().row, cursor.cell().column);
+    EXPECT_FALSE(cursor.next());
+    ASSERT_GE(seen.size(), 8u);
+    EXPECT_TRUE(std::is_sorted(seen.begin(), seen.end()));
+    EXPECT_EQ(seen.front(), std::make_pair(1u, uint16_t{1}));
+    EXPECT_EQ(seen.back(), std::make_pair(500u, uint16_t{3}));
+    EXPECT_NE(std::find(seen.begin(), seen.end(), std::make_pair(40u, uint16_t{2})), seen.end());
+
+    // 遍历不创建单元格：再次遍历结果相同
+    size_t again = 0;
+    for (auto c = wrapper.cellCursor(0); c.next();) ++again;
+    EXPECT_EQ(again, seen.size());
+    EXPECT_FALSE(wrapper.cellCursor(9).next());
+    wrapper.close();
+
+    XLDocument doc;
+    ASSERT_TRUE(doc.open(path));
+    auto& sheet = doc.getWorkbook().getSheet(0);
+    std::vector<std::string> texts;
+    for (const auto& cell : sheet.scanCells()) {
+        if (auto text = cellValueAs<std::string>(cell.value)) texts.push_back(*text);
+    }
+    ASSERT_GE(texts.size(), 3u);
+    EXPECT_EQ(texts[0], "hello");
+    EXPECT_NE(std::find(texts.begin(), texts.end(), "world"), texts.end());
+    auto scan = sheet.scanCells();
+    auto it = scan.begin();
+    ASSERT_NE(it, scan.end());
+    ++it;
+    EXPECT_EQ(it->column, 2);
+    EXPECT_EQ(cellValueAs<int64_t>(it->value), 42);
+    doc.close();
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_Wrapper, CellTextViewsDoNotCopy) {
+    const auto path = makeFixture("minixlsx_text_views.xlsx");
+    OpenXLSXWrapper wrapper;
+    ASSERT_TRUE(wrapper.open(path));
+
+    // 视图直接指向文档数据，重复读取得到同一地址
+    auto a1 = wrapper.getCellText(0, "A1");
+    auto again = wrapper.getCellText(0, 1, 1);
+    ASSERT_TRUE(a1.has_value());
+    ASSERT_TRUE(again.has_value());
+    EXPECT_EQ(*a1, "hello");
+    EXPECT_EQ(a1->data(), again->data());
+    EXPECT_EQ(wrapper.getCellText(0, "B2").value_or(""), "hello");
+    EXPECT_EQ(wrapper.getCellText(0, "B1").value_or(""), "42");
+    EXPECT_EQ(wrapper.getCellText(0, "Z99").value_or("x"), "");
+    EXPECT_FALSE(wrapper.getCellText(0, "").has_value());
+    wrapper.close();
+
+    XLDocument doc;
+    ASSERT_TRUE(doc.open(path));
+    auto& sheet = doc.getWorkbook().getSheet(0);
+    EXPECT_EQ(sheet.getCellText("A2"), "world");
+    EXPECT_EQ(sheet.getCellText(1, 3), "3.5");
+    const XLCell* cell = sheet.getCell("A1");
+    ASSERT_NE(cell, nullptr);
+    EXPECT_EQ(cell->getValueView(), "hello");
+    EXPECT_EQ(cell->getValueView().data(), cell->getValueView().data());
+    doc.close();
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_Cell, DefaultValueViewForSubclasses) {
+    // 只实现 getValue/getType 的已有子类无需修改即可使用 getValueView
+    struct LegacyCell : XLCell {
+        LegacyCell() : XLCell("C3") {}
+        std::string getValue() const override { return "legacy"; }
+        std::string getType() const override { return "str"; }
+    };
+    LegacyCell cell;
+    const XLCell& base = cell;
+    EXPECT_EQ(base.getValueView(), "legacy");
+    EXPECT_EQ(base.getReference(), "C3");
+}
+
+TEST(MiniXLSX_Wrapper, SharedStringsAreInternedByHash) {
+    const auto path = makeFixture("minixlsx_shared_strings.xlsx");
+    OpenXLSXWrapper wrapper;
+    ASSERT_TRUE(wrapper.open(path));
+
+    for (uint32_t i = 0; i < 5000; ++i) {
+        ASSERT_TRUE(wrapper.setCellValue(0, 100 + i, 1, "distinct " + std::to_string(i)));
+    }
+    // 已存在的字符串复用同一共享字符串
+    ASSERT_TRUE(wrapper.setCellValue(0, 100, 2, "distinct 4321"));
+    EXPECT_EQ(wrapper.getCellText(0, 100, 2)->data(), wrapper.getCellText(0, 4421, 1)->data());
+    EXPECT_EQ(wrapper.getCellText(0, "A5099").value_or(""), "distinct 4999");
+
+    std::vector<std::byte> buffer;
+    ASSERT_TRUE(wrapper.saveAs(buffer));
+    wrapper.close();
+    // 重新打开时由加载的共享字符串表重建索引
+    ASSERT_TRUE(wrapper.open(std::span<const std::byte>(buffer)));
+    ASSERT_TRUE(wrapper.setCellValue(0, 1, 8, "distinct 17"));
+    EXPECT_EQ(wrapper.getCellText(0, 1, 8)->data(), wrapper.getCellText(0, 117, 1)->data());
+    wrapper.close();
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_Wrapper, SheetNameTablesAreCached) {
+    const std::string path = "sheet_names_test.xlsx";
+    {
+        OpenXLSX::XLDocument doc;
+        doc.create(path, true);
+        for (int i = 2; i <= 400; ++i) doc.workbook().addWorksheet("Sheet" + std::to_string(i));
+        doc.save();
+        doc.close();
+    }
+
+    OpenXLSXWrapper wrapper;
+    ASSERT_TRUE(wrapper.open(path));
+    ASSERT_EQ(wrapper.sheetCount(), 400u);
+    // 同一名称返回同一缓存对象
+    const std::string& name = wrapper.sheetName(250);
+    EXPECT_EQ(name, "Sheet251");
+    EXPECT_EQ(&name, &wrapper.sheetName(250));
+    EXPECT_TRUE(wrapper.sheetName(400).empty());
+    for (unsigned int i = 0; i < 400; ++i) {
+        EXPECT_EQ(wrapper.sheetIndex(wrapper.sheetName(i)).value_or(9999), i);
+    }
+    EXPECT_FALSE(wrapper.sheetIndex("Sheet401").has_value());
+    wrapper.close();
+    EXPECT_TRUE(wrapper.sheetName(0).empty());
+
+    // 封装模式下工作簿返回封装缓存中的名称
+    XLDocument doc;
+    ASSERT_TRUE(doc.open(path));
+    auto& wb = doc.getWorkbook();
+    ASSERT_EQ(wb.getSheetCount(), 400u);
+    EXPECT_EQ(wb.getSheetName(399), "Sheet400");
+    EXPECT_EQ(&wb.getSheetName(7), &wb.getSheetName(7));
+    doc.close();
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_OpenXLSX, MergeLookupUsesSpatialIndex) {
+    const auto path = makeFixture("minixlsx_merge_index.xlsx");
+    OpenXLSX::XLDocument doc;
+    doc.open(path);
+
+    auto sheet = doc.workbook().worksheet("Data");
+    auto& merges = sheet.merges();
+    ASSERT_EQ(merges.count(), 1u);
+    EXPECT_EQ(merges.findMergeByCell("F2"), 0);
+    EXPECT_EQ(merges.findMergeByCell("G2"), OpenXLSX::XLMergeNotFound);
+
+    // 一个高合并区域与同一行上的多个窄合并区域
+    EXPECT_EQ(merges.appendMerge("A10:A500"), 1);
+    for (int i = 0; i < 50; ++i) {
+        std::string first = OpenXLSX::XLCellReference::columnAsString(static_cast<uint16_t>(2 + 2 * i));
+        std::string last = OpenXLSX::XLCellReference::columnAsString(static_cast<uint16_t>(3 + 2 * i));
+        merges.appendMerge(first + "20:" + last + "21");
+    }
+    EXPECT_EQ(merges.findMergeByCell("A400"), 1);
+    EXPECT_EQ(merges.findMergeByCell("B21"), 2);
+    EXPECT_EQ(merges.findMergeByCell("CW20"), 51);
+    EXPECT_EQ(merges.findMergeByCell("CX20"), OpenXLSX::XLMergeNotFound);
+    EXPECT_EQ(merges.findMergeByCell("B22"), OpenXLSX::XLMergeNotFound);
+    EXPECT_THROW(merges.appendMerge("A499:B501"), OpenXLSX::XLInputError);
+
+    // 整列高度的合并区域不影响其他单元格的查找
+    EXPECT_EQ(merges.appendMerge("ZZ1:ZZ1048576"), 52);
+    EXPECT_EQ(merges.findMergeByCell("ZZ777777"), 52);
+    EXPECT_EQ(merges.findMergeByCell("ZY777777"), OpenXLSX::XLMergeNotFound);
+    EXPECT_THROW(merges.appendMerge("ZY900000:ZZ900001"), OpenXLSX::XLInputError);
+    EXPECT_THROW(merges.appendMerge("A2:A10"), OpenXLSX::XLInputError);
+    EXPECT_THROW(merges.appendMerge("A100:C100"), OpenXLSX::XLInputError);
+    EXPECT_EQ(merges.appendMerge("A501:A502"), 53);
+
+    // 删除后索引随之移动
+    merges.deleteMerge(1);
+    EXPECT_EQ(merges.findMergeByCell("A400"), OpenXLSX::XLMergeNotFound);
+    EXPECT_EQ(merges.findMergeByCell("B21"), 1);
+    EXPECT_EQ(merges.findMergeByCell("E1"), 0);
+    EXPECT_EQ(merges.findMergeByCell("ZZ1"), 51);
+    EXPECT_EQ(merges.findMergeByCell("A502"), 52);
+    EXPECT_EQ(merges.appendMerge("A10:A500"), 53);
+    doc.close();
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_OpenXLSX, MergeCellsKeepUnparsableReferences) {
+    const std::string path = "merge_unparsable_test.xlsx";
+    {
+        OpenXLSX::XLDocument doc;
+        doc.create(path, true);
+        auto sheetData = doc.workbook().worksheet(1).sheetData();
+        auto mergeCells = sheetData.parent().insert_child_after("mergeCells", sheetData);
+        mergeCells.append_child("mergeCell").append_attribute("ref") = "A1:B2";
+        mergeCells.append_child("mergeCell").append_attribute("ref") = "bogus";
+        mergeCells.append_child("mergeCell").append_attribute("ref") = "D1:D3";
+        doc.save();
+        doc.close();
+    }
+
+    OpenXLSX::XLDocument doc;
+    doc.open(path);
+    auto sheet = doc.workbook().worksheet(1);
+    auto& merges = sheet.merges();
+    // 无法解析的引用保留在文档中，只是不能按单元格查到
+    ASSERT_EQ(merges.count(), 3u);
+    EXPECT_STREQ(merges.merge(1), "bogus");
+    EXPECT_EQ(merges.findMergeByCell("B2"), 0);
+    EXPECT_EQ(merges.findMergeByCell("D3"), 2);
+    merges.deleteMerge(1);
+    EXPECT_EQ(merges.findMergeByCell("D3"), 1);
+    doc.close();
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_OpenXLSX, XmlDataRegistryIndexesPartsByPath) {
+    OpenXLSX::XLXmlDataRegistry registry;
+    for (int i = 1; i <= 300; ++i) {
+        registry.emplace(nullptr, "xl/worksheets/sheet" + std::to_string(i) + ".xml", "rId" + std::to_string(i),
+                         OpenXLSX::XLContentType::Worksheet);
+    }
+    OpenXLSX::XLXmlData* part = registry.find("xl/worksheets/sheet150.xml");
+    ASSERT_NE(part, nullptr);
+    EXPECT_EQ(part->getXmlID(), "rId150");
+    EXPECT_EQ(registry.find("xl/worksheets/sheet301.xml"), nullptr);
+
+    // 未解析 -> 修改后为 Dirty，地址在其他部件增删时保持不变
+    EXPECT_EQ(part->state(), OpenXLSX::XLXmlDataState::Unparsed);
+    part->setRawData("<worksheet><sheetData/></worksheet>");
+    EXPECT_EQ(part->state(), OpenXLSX::XLXmlDataState::Dirty);
+    // 写回后为 Parsed；只读访问（即使经由非 const 接口）不改变状态，修改节点后为 Dirty
+    part->markClean();
+    EXPECT_EQ(part->state(), OpenXLSX::XLXmlDataState::Parsed);
+    EXPECT_FALSE(part->getXmlDocument()->document_element().child("sheetData").empty());
+    EXPECT_EQ(part->state(), OpenXLSX::XLXmlDataState::Parsed);
+    part->getXmlDocument()->document_element().child("sheetData").append_child("row").append_attribute("r") = 1;
+    EXPECT_EQ(part->state(), OpenXLSX::XLXmlDataState::Dirty);
+    // 经由 markDirty 标记的修改无需比对指纹
+    part->markClean();
+    part->markDirty();
+    EXPECT_EQ(part->state(), OpenXLSX::XLXmlDataState::Dirty);
+    EXPECT_TRUE(registry.erase("xl/worksheets/sheet1.xml"));
+    EXPECT_FALSE(registry.erase("xl/worksheets/sheet1.xml"));
+    registry.emplace(nullptr, "xl/styles.xml");
+    EXPECT_EQ(registry.find("xl/worksheets/sheet150.xml"), part);
+    EXPECT_EQ(registry.size(), 300u);
+
+    // 同一路径的后续部件在先注册的部件删除后接管索引
+    OpenXLSX::XLXmlData& duplicate = registry.emplace(nullptr, "xl/styles.xml", "second");
+    EXPECT_NE(registry.find("xl/styles.xml"), &duplicate);
+    EXPECT_TRUE(registry.erase("xl/styles.xml"));
+    EXPECT_EQ(registry.find("xl/styles.xml"), &duplicate);
+    registry.clear();
+    EXPECT_FALSE(registry.contains("xl/styles.xml"));
+}
+
+TEST(MiniXLSX_OpenXLSX, NodeIndexKeepsRandomAccessOrdered) {
+    const auto path = makeFixture("minixlsx_node_index.xlsx");
+    OpenXLSX::XLDocument doc;
+    doc.open(path);
+
+    auto sheet = doc.workbook().worksheet("Data");
+    // 乱序写入：经由索引插入的行与单元格保持有序
+    for (uint32_t i = 0; i < 2000; ++i) {
+        const uint32_t row = 10 + (i * 7919u) % 2000u;
+        sheet.cell(row, static_cast<uint16_t>(1 + row % 5)).value() = static_cast<int64_t>(row);
+    }
+    EXPECT_EQ(sheet.cell("A1").value().get<std::string>(), "hello");
+    EXPECT_EQ(sheet.findCell(1009, 5).value().get<int64_t>(), 1009);
+    EXPECT_TRUE(sheet.findCell(2500, 1).empty());
+    EXPECT_TRUE(sheet.findCell(1009, 9).empty());
+
+    // 绕过索引（经由另一个工作表句柄的区域迭代器）插入的行也能找到
+    auto other = doc.workbook().worksheet("Data");
+    for (auto& cell : other.range("B3000:B3100")) cell.value() = "iterated";
+    EXPECT_EQ(sheet.findCell(3050, 2).value().get<std::string>(), "iterated");
+    EXPECT_EQ(sheet.findCell(3100, 2).value().get<std::string>(), "iterated");    // long walk: index is rebuilt
+    sheet.cell(3050, 4).value() = "indexed";
+    EXPECT_EQ(other.findCell(3050, 4).value().get<std::string>(), "indexed");
+
+    uint32_t previous = 0;
+    for (auto node = sheet.sheetData().first_child_of_type(pugi::node_element); not node.empty();
+         node = node.next_sibling_of_type(pugi::node_element)) {
+        const auto row = static_cast<uint32_t>(node.attribute("r").as_ullong());
+        EXPECT_LT(previous, row);
+        previous = row;
+    }
+    EXPECT_EQ(previous, 3100u);
+    doc.close();
+    std::filesystem::remove(path);
+}
+
+TEST(MiniXLSX_OpenXLSX, NodeIndexSurvivesNodeRemoval) {
+    const std::string path = "node_index_delete_test.xlsx";
+    {
+        OpenXLSX::XLDocument doc;
+        doc.create(path, true);
+        auto sheet = doc.workbook().worksheet(1);
+        auto other = doc.workbook().worksheet(1);
+        for (uint32_t row = 1; row <= 3; ++row) sheet.cell(row, 1).value() = static_cast<int64_t>(row);
+        sheet.cell(3, 2).value() = "old";
+        EXPECT_FALSE(other.findCell(2, 1).empty());
+
+        // 删除行后再写入同一行：索引不得返回已删除的节点，另一个句柄也是如此
+        ASSERT_TRUE(sheet.deleteRow(2));
+        EXPECT_TRUE(other.findCell(2, 1).empty());
+        sheet.cell(2, 1).value() = 42;
+        other.cell(2, 2).value() = 43;
+
+        // 整行赋值会删除并重建单元格节点
+        sheet.row(3).values() = std::vector<int>{7, 8};
+        sheet.cell(3, 2).value() = 9;
+        doc.save();
+        doc.close();
+    }
+
+    OpenXLSX::XLDocument doc;
+    doc.open(path);
+    auto sheet = doc.workbook().worksheet(1);
+    EXPECT_EQ(sheet.cell(2, 1).value().get<int64_t>(), 42);
+    EXPECT_EQ(sheet.cell(2, 2).value().get<int64_t>(), 43);
+    EXPECT_EQ(sheet.cell(3, 1).value().get<int64_t>(), 7);
+    EXPECT_EQ(sheet.cell(3, 2).value().get<int64_t>(), 9);
+    doc.close();
+    std::filesystem::remove(path);
+}
@@ -2,6 +2,7 @@
 #include "cc/neolux/utils/MiniXLSX/MiniXLSX.hpp"
 #include "cc/neolux/utils/MiniXLSX/Types.hpp"
 #include <OpenXLSX.hpp>
+#include <tuple>
 
 using namespace cc::neolux::utils::MiniXLSX;
 
@@ -47,3 +48,146 @@ TEST(MiniXLSX_StyleWrite, ApplyBasicFillAndBorder)
         doc.close();
     }
 }
+
+TEST(MiniXLSX_StyleWrite, IdenticalStylesAreInterned)
+{
+    const std::string out = "test_style_intern.xlsx"; // written in build dir
+    {
+        OpenXLSX::XLDocument doc;
+        doc.create(out, true);
+        doc.save();
+        doc.close();
+    }
+
+    MiniXLSX api;
+    ASSERT_TRUE(api.open(out));
+    CellStyle style;
+    style.backgroundColor = "#00FF00";
+    style.border = CellBorderStyle::Medium;
+    ASSERT_TRUE(api.setCellStyle(0, 1, 1, style));
+    ASSERT_TRUE(api.save());
+
+    auto countStyles = [&]() {
+        OpenXLSX::XLDocument doc;
+        doc.open(out);
+        auto& styles = doc.styles();
+        auto counts = std::make_tuple(styles.fills().count(), styles.borders().count(), styles.cellFormats().count());
+        doc.close();
+        return counts;
+    };
+    const auto initial = countStyles();
+
+    // 相同样式（颜色写法不同）应用到大量单元格，以及对已设置样式的单元格重复应用，都不再新增样式节点
+    style.backgroundColor = "FF00FF00";
+    for (uint32_t row = 1; row <= 1000; ++row) {
+        ASSERT_TRUE(api.setCellStyle(0, row, 2, style));
+    }
+    ASSERT_TRUE(api.setCellStyle(0, "A1", style));
+    ASSERT_TRUE(api.save());
+    EXPECT_EQ(countStyles(), initial);
+
+    // 不同样式才新增，且填充复用
+    style.border = CellBorderStyle::Thick;
+    ASSERT_TRUE(api.setCellStyle(0, "C1", style));
+    ASSERT_TRUE(api.save());
+    api.close();
+    const auto changed = countStyles();
+    EXPECT_EQ(std::get<0>(changed), std::get<0>(initial));
+    EXPECT_EQ(std::get<1>(changed), std::get<1>(initial) + 1);
+    EXPECT_EQ(std::get<2>(changed), std::get<2>(initial) + 1);
+}
+
+TEST(MiniXLSX_StyleWrite, RangeStyleAppliesPerBaseFormat)
+{
+    const std::string out = "test_style_range.xlsx"; // written in build dir
+    {
+        OpenXLSX::XLDocument doc;
+        doc.create(out, true);
+        doc.workbook().worksheet(1).cell("B2").value() = "kept";
+        doc.save();
+        doc.close();
+    }
+
+    MiniXLSX api;
+    ASSERT_TRUE(api.open(out));
+    CellStyle header;
+    header.backgroundColor = "#DDDDDD";
+    header.border = CellBorderStyle::Thin;
+    ASSERT_TRUE(api.setCellStyle(0, "A1", header));
+    // 斑马纹：对包含已有样式单元格的区域再应用填充
+    CellStyle stripe;
+    stripe.backgroundColor = "#F0F0F0";
+    ASSERT_TRUE(api.setRangeStyle(0, "H500:A1", stripe));
+    ASSERT_TRUE(api.save());
+    api.close();
+
+    OpenXLSX::XLDocument doc;
+    doc.open(out);
+    auto ws = doc.workbook().worksheet(1);
+    auto& formats = doc.styles().cellFormats();
+    const auto plain = ws.cell("H500").cellFormat();
+    const auto headed = ws.cell("A1").cellFormat();
+    EXPECT_NE(plain, headed);
+    EXPECT_EQ(ws.cell("C3").cellFormat(), plain);
+    EXPECT_EQ(ws.cell("B2").value().get<std::string>(), "kept");
+    EXPECT_TRUE(formats.cellFormatByIndex(plain).applyFill());
+    EXPECT_FALSE(formats.cellFormatByIndex(plain).applyBorder());
+    // 基础格式中的边框保留，填充被覆盖
+    EXPECT_TRUE(formats.cellFormatByIndex(headed).applyBorder());
+    EXPECT_EQ(formats.cellFormatByIndex(headed).fillIndex(), formats.cellFormatByIndex(plain).fillIndex());
+    doc.close();
+}
+
+TEST(MiniXLSX_StyleWrite, StylesAreReusedAcrossSessions)
+{
+    const std::string out = "test_style_sessions.xlsx"; // written in build dir
+    {
+        OpenXLSX::XLDocument doc;
+        doc.create(out, true);
+        doc.save();
+        doc.close();
+    }
+
+    CellStyle style;
+    style.backgroundColor = "#336699";
+    style.border = CellBorderStyle::Thin;
+    style.borderColor = "#FF0000";
+    {
+        MiniXLSX api;
+        ASSERT_TRUE(api.open(out));
+        ASSERT_TRUE(api.setCellStyle(0, "A1", style));
+        ASSERT_TRUE(api.save());
+        api.close();
+    }
+
+    auto countStyles = [&]() {
+        OpenXLSX::XLDocument doc;
+        doc.open(out);
+        auto& styles = doc.styles();
+        auto counts = std::make_tuple(styles.fills().count(), styles.borders().count(), styles.cellFormats().count());
+        doc.close();
+        return counts;
+    };
+    const auto initial = countStyles();
+
+    // 重新打开后，相同样式（颜色大小写不同）复用上一会话写入的填充、边框与单元格格式
+    style.backgroundColor = "ff336699";
+    style.borderColor = "#ff0000";
+    {
+        MiniXLSX api;
+        ASSERT_TRUE(api.open(out));
+        ASSERT_TRUE(api.setCellStyle(0, "A1", style));
+        ASSERT_TRUE(api.setCellStyle(0, "C7", style));
+        ASSERT_TRUE(api.setRangeStyle(0, "D1:D50", style));
+        ASSERT_TRUE(api.save());
+        api.close();
+    }
+    EXPECT_EQ(countStyles(), initial);
+
+    OpenXLSX::XLDocument doc;
+    doc.open(out);
+    auto ws = doc.workbook().worksheet(1);
+    EXPECT_EQ(ws.cell("C7").cellFormat(), ws.cell("A1").cellFormat());
+    EXPECT_EQ(ws.cell("D50").cellFormat(), ws.cell("A1").cellFormat());
+    doc.close();
+}